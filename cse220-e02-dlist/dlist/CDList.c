@@ -0,0 +1,339 @@
+/***************************************************************************************************************
+ * FILE: CDList.c
+ *
+ * DESCRIPTION
+ * Implementation of the concurrent doubly-linked list. Every node, the two sentinels included, has its own lock,
+ * and the functions that walk the list hold at most a few neighboring locks at a time, always taken from the
+ * head toward the tail. A walk locks the next node before it unlocks the one it is on (hand-over-hand locking,
+ * or lock coupling), so no other thread can unlink the node it is about to step to, and since every thread
+ * takes the locks in the same order no two threads can deadlock.
+ *
+ * Inserting a node locks the node before it and the node after it; removing one locks the node, the node
+ * before it, and the node after it. Those are all the nodes whose links change, so threads changing parts of
+ * the list that are at least two nodes apart go ahead at the same time. A thread cannot pass another one that
+ * is walking ahead of it, which means each change takes effect as if the changes had been made one at a time
+ * in the order the threads locked the head sentinel.
+ *
+ * AUTHOR INFORMATION
+ * agent [AGT]
+ *
+ * Email: agent@local
+ *
+ * MODIFICATION HISTORY:
+ * -------------------------------------------------------------------------------------------------------------
+ * 17 Oct 2026 [AGT] Initial revision.
+ **************************************************************************************************************/
+#define _POSIX_C_SOURCE 200112L  /* For pthread_mutex_init(), pthread_mutex_lock(), etc. when compiling with -ansi */
+
+#include <assert.h>   /* For assert() */
+#include <pthread.h>  /* For pthread_mutex_destroy(), pthread_mutex_init(), pthread_mutex_lock(), etc. */
+#include <stdlib.h>   /* For free(), malloc() */
+#include "CDList.h"
+#include "Out.h"      /* For Out, OutCommit(), OutItoa(), OutReserve(), OutStr() */
+
+/*==============================================================================================================
+ * Static function declarations.
+ *============================================================================================================*/
+static void CDListAddSize
+    (
+    CDList *pList,
+    int     pDelta
+    );
+
+static CDListNode *CDListLockBefore
+    (
+    CDList *pList,
+    int     pIndex
+    );
+
+/*==============================================================================================================
+ * Function definitions.
+ *============================================================================================================*/
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: CDListAddSize
+ * DESCR: Adds pDelta to the size of pList.
+ *------------------------------------------------------------------------------------------------------------*/
+static void CDListAddSize
+    (
+    CDList *pList,
+    int     pDelta
+    )
+{
+    pthread_mutex_lock(&pList->mSizeLock);
+    pList->mSize += pDelta;
+    pthread_mutex_unlock(&pList->mSizeLock);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: CDListAlloc
+ * DESCR: Allocates a new, empty CDList: the two sentinels linked to each other and a size of 0. Returns NULL if
+ *        memory cannot be allocated.
+ *------------------------------------------------------------------------------------------------------------*/
+CDList *CDListAlloc
+    (
+    )
+{
+    CDList *new_list = (CDList *)malloc(sizeof(CDList));
+    if (new_list) {
+        new_list->mHead.mPrev = NULL;
+        new_list->mHead.mNext = &new_list->mTail;
+        new_list->mTail.mPrev = &new_list->mHead;
+        new_list->mTail.mNext = NULL;
+        new_list->mHead.mData = new_list->mTail.mData = 0;
+        new_list->mSize = 0;
+        pthread_mutex_init(&new_list->mHead.mLock, NULL);
+        pthread_mutex_init(&new_list->mTail.mLock, NULL);
+        pthread_mutex_init(&new_list->mSizeLock, NULL);
+    }
+    return new_list;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: CDListAppend
+ * DESCR: Appends a new node containing pData to the end of pList. Locks the last node and the tail sentinel.
+ *        Returns pList, or NULL if the node cannot be allocated. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+CDList *CDListAppend
+    (
+    CDList *pList,
+    int     pData
+    )
+{
+    CDListNode *new_node, *last;
+    assert(pList);
+    if (!(new_node = (CDListNode *)malloc(sizeof(CDListNode)))) return NULL;
+    new_node->mData = pData;
+    pthread_mutex_init(&new_node->mLock, NULL);
+    last = CDListLockBefore(pList, -1);
+    pthread_mutex_lock(&pList->mTail.mLock);
+    new_node->mPrev = last;
+    new_node->mNext = &pList->mTail;
+    last->mNext = new_node;
+    pList->mTail.mPrev = new_node;
+    pthread_mutex_unlock(&pList->mTail.mLock);
+    pthread_mutex_unlock(&last->mLock);
+    CDListAddSize(pList, 1);
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: CDListCheck
+ * DESCR: Walks pList from the head sentinel to the tail sentinel and checks that the head sentinel has no
+ *        previous node, that the tail sentinel has no next node, and that the previous node of each node is the
+ *        node that links to it. The walk locks hand-over-hand like every other function, so it may run while
+ *        other threads change the list, and the nodes it counts are the list as it was at one moment. Returns
+ *        the number of elements, or -1 if a link is wrong. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+int CDListCheck
+    (
+    CDList *pList
+    )
+{
+    CDListNode *node, *next;
+    int count = 0;
+    bool ok;
+    assert(pList);
+    node = &pList->mHead;
+    pthread_mutex_lock(&node->mLock);
+    ok = node->mPrev == NULL;
+    while (ok && (next = node->mNext)) {
+        pthread_mutex_lock(&next->mLock);
+        ok = next->mPrev == node;
+        pthread_mutex_unlock(&node->mLock);
+        node = next;
+        if (node != &pList->mTail) ++count;
+    }
+    ok = ok && node == &pList->mTail;
+    pthread_mutex_unlock(&node->mLock);
+    return ok ? count : -1;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: CDListDebugPrint
+ * DESCR: Prints the contents of the list pList to pOut in the same format as DListDebugPrint(). Prints "List is
+ *        NULL" if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+void CDListDebugPrint
+    (
+    Out    *pOut,
+    CDList *pList
+    )
+{
+    CDListNode *node, *next;
+    char *pos;
+    if (!pList) {
+        OutStr(pOut, "List is NULL.\n");
+        return;
+    }
+    OutStr(pOut, "[ ");
+    node = &pList->mHead;
+    pthread_mutex_lock(&node->mLock);
+    while ((next = node->mNext) != &pList->mTail) {
+        pthread_mutex_lock(&next->mLock);
+        pthread_mutex_unlock(&node->mLock);
+        node = next;
+        pos = OutItoa(OutReserve(pOut, OUT_INT_CHARS + 1), node->mData);
+        *pos++ = ' ';
+        OutCommit(pOut, pos);
+    }
+    pthread_mutex_unlock(&node->mLock);
+    OutStr(pOut, "]");
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: CDListFree
+ * DESCR: Frees every node of pList and pList itself. No other thread may be using pList. Returns NULL. Does
+ *        nothing if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+CDList *CDListFree
+    (
+    CDList *pList
+    )
+{
+    CDListNode *node, *next;
+    if (!pList) return NULL;
+    for (node = pList->mHead.mNext; node != &pList->mTail; node = next) {
+        next = node->mNext;
+        pthread_mutex_destroy(&node->mLock);
+        free(node);
+    }
+    pthread_mutex_destroy(&pList->mHead.mLock);
+    pthread_mutex_destroy(&pList->mTail.mLock);
+    pthread_mutex_destroy(&pList->mSizeLock);
+    free(pList);
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: CDListGetSize
+ * DESCR: Returns the number of elements in pList. While other threads are changing the list the count may be
+ *        behind the links by the changes still finishing. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+int CDListGetSize
+    (
+    CDList *pList
+    )
+{
+    int size;
+    assert(pList);
+    pthread_mutex_lock(&pList->mSizeLock);
+    size = pList->mSize;
+    pthread_mutex_unlock(&pList->mSizeLock);
+    return size;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: CDListInsertIndex
+ * DESCR: Inserts a new node containing pData into pList before the node at index pIndex, as DListInsertIndex()
+ *        does. Locks the nodes before and at pIndex. Fails and returns NULL if pIndex < 0, if there is no node
+ *        at pIndex when the walk gets there, or if the node cannot be allocated. Assertion error if pList is
+ *        NULL.
+ * PCODE:
+ * Allocate the new node before taking any lock
+ * Walk to the node before index pIndex, locking hand-over-hand  -- Hint: Call CDListLockBefore()
+ * Lock the node after it. If that is the tail sentinel Then there is no node at pIndex: unlock, free, fail
+ * Link the new node between the two locked nodes, unlock them, and add 1 to the size
+ *------------------------------------------------------------------------------------------------------------*/
+CDList *CDListInsertIndex
+    (
+    CDList *pList,
+    int     pIndex,
+    int     pData
+    )
+{
+    CDListNode *new_node, *prev, *next;
+    assert(pList);
+    if (pIndex < 0 || !(new_node = (CDListNode *)malloc(sizeof(CDListNode)))) return NULL;
+    new_node->mData = pData;
+    pthread_mutex_init(&new_node->mLock, NULL);
+    if ((prev = CDListLockBefore(pList, pIndex))) {
+        next = prev->mNext;
+        pthread_mutex_lock(&next->mLock);
+        if (next != &pList->mTail) {
+            new_node->mPrev = prev;
+            new_node->mNext = next;
+            prev->mNext = new_node;
+            next->mPrev = new_node;
+        }
+        pthread_mutex_unlock(&next->mLock);
+        pthread_mutex_unlock(&prev->mLock);
+        if (next != &pList->mTail) {
+            CDListAddSize(pList, 1);
+            return pList;
+        }
+    }
+    pthread_mutex_destroy(&new_node->mLock);
+    free(new_node);
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: CDListLockBefore
+ * DESCR: Walks pList from the head sentinel, locking hand-over-hand, to the node before index pIndex, which is
+ *        the head sentinel when pIndex is 0, or to the last node (the head sentinel if the list is empty) when
+ *        pIndex < 0. Returns that node locked, and no other node locked. Returns NULL, with no node locked, if
+ *        the list ends before the node before pIndex.
+ *------------------------------------------------------------------------------------------------------------*/
+static CDListNode *CDListLockBefore
+    (
+    CDList *pList,
+    int     pIndex
+    )
+{
+    CDListNode *node = &pList->mHead, *next;
+    pthread_mutex_lock(&node->mLock);
+    for (; pIndex != 0; --pIndex) {
+        if ((next = node->mNext) == &pList->mTail) {
+            if (pIndex < 0) break;
+            pthread_mutex_unlock(&node->mLock);
+            return NULL;
+        }
+        pthread_mutex_lock(&next->mLock);
+        pthread_mutex_unlock(&node->mLock);
+        node = next;
+    }
+    return node;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: CDListRemoveIndex
+ * DESCR: Removes the node at index pIndex from pList and frees it. Locks the node and the nodes before and after
+ *        it. No other thread can be waiting for the lock of the removed node, because a thread only waits for
+ *        the lock of the node after one it holds, and this thread holds the node before it. Returns pList, or
+ *        NULL if pIndex < 0 or there is no node at pIndex when the walk gets there. Assertion error if pList is
+ *        NULL.
+ * PCODE:
+ * Walk to the node before index pIndex, locking hand-over-hand  -- Hint: Call CDListLockBefore()
+ * Lock the node after it. If that is the tail sentinel Then there is no node at pIndex: unlock and fail
+ * Lock the node after the one being removed, unlink the removed node, and unlock the three nodes
+ * Free the removed node and subtract 1 from the size
+ *------------------------------------------------------------------------------------------------------------*/
+CDList *CDListRemoveIndex
+    (
+    CDList *pList,
+    int     pIndex
+    )
+{
+    CDListNode *prev, *node, *next;
+    assert(pList);
+    if (pIndex < 0 || !(prev = CDListLockBefore(pList, pIndex))) return NULL;
+    node = prev->mNext;
+    pthread_mutex_lock(&node->mLock);
+    if (node == &pList->mTail) {
+        pthread_mutex_unlock(&node->mLock);
+        pthread_mutex_unlock(&prev->mLock);
+        return NULL;
+    }
+    next = node->mNext;
+    pthread_mutex_lock(&next->mLock);
+    prev->mNext = next;
+    next->mPrev = prev;
+    pthread_mutex_unlock(&next->mLock);
+    pthread_mutex_unlock(&prev->mLock);
+    pthread_mutex_unlock(&node->mLock);
+    pthread_mutex_destroy(&node->mLock);
+    free(node);
+    CDListAddSize(pList, -1);
+    return pList;
+}
@@ -0,0 +1,97 @@
+/***************************************************************************************************************
+ * FILE: CDList.h
+ *
+ * DESCRIPTION
+ * Declaration of the concurrent doubly-linked list, a DList that several threads may change at the same time.
+ * See the comments in CDList.c for more information.
+ *
+ * AUTHOR INFORMATION
+ * agent [AGT]
+ *
+ * Email: agent@local
+ *
+ * MODIFICATION HISTORY:
+ * -------------------------------------------------------------------------------------------------------------
+ * 17 Oct 2026 [AGT] Initial revision.
+ **************************************************************************************************************/
+#ifndef __CDLIST_H__
+#define __CDLIST_H__
+
+#include <pthread.h>  /* For pthread_mutex_t */
+#include "Out.h"      /* For Out */
+#include "Types.h"    /* For bool */
+
+/*==============================================================================================================
+ * Typedefs.
+ *============================================================================================================*/
+/*--------------------------------------------------------------------------------------------------------------
+ * Each node has its own lock, which guards its mNext and mPrev links. mData is never changed once the node is
+ * in a list.
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct CDListNode_ {
+    struct CDListNode_ *mNext;  /* Next node, NULL in the tail sentinel.     */
+    struct CDListNode_ *mPrev;  /* Previous node, NULL in the head sentinel. */
+    int                 mData;  /* The element.                              */
+    pthread_mutex_t     mLock;  /* Guards mNext and mPrev.                   */
+} CDListNode;
+
+/*--------------------------------------------------------------------------------------------------------------
+ * mHead and mTail are sentinel nodes that hold no element, so every node of the list has a node before it and
+ * a node after it, and an empty list is mHead and mTail linked to each other. mSize is kept apart from the
+ * links under mSizeLock.
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct {
+    CDListNode      mHead;      /* Sentinel before the first node. */
+    CDListNode      mTail;      /* Sentinel after the last node.   */
+    int             mSize;      /* Number of elements.             */
+    pthread_mutex_t mSizeLock;  /* Guards mSize.                   */
+} CDList;
+
+/*==============================================================================================================
+ * Global function declarations. See function comments in CDList.c
+ *============================================================================================================*/
+extern CDList *CDListAlloc
+    (
+    );
+
+extern CDList *CDListAppend
+    (
+    CDList *pList,
+    int     pData
+    );
+
+extern int CDListCheck
+    (
+    CDList *pList
+    );
+
+extern void CDListDebugPrint
+    (
+    Out    *pOut,
+    CDList *pList
+    );
+
+extern CDList *CDListFree
+    (
+    CDList *pList
+    );
+
+extern int CDListGetSize
+    (
+    CDList *pList
+    );
+
+extern CDList *CDListInsertIndex
+    (
+    CDList *pList,
+    int     pIndex,
+    int     pData
+    );
+
+extern CDList *CDListRemoveIndex
+    (
+    CDList *pList,
+    int     pIndex
+    );
+
+#endif
@@ -19,17 +19,56 @@
  * MODIFICATION HISTORY:
  * -------------------------------------------------------------------------------------------------------------
  * 10 Mar 2012 [KRB] Initial revision.
+ * 17 Oct 2026 [AGT] Finished DListCopy(), DListGetIndex(), DListInsertIndex(), and DListRemoveNode(), and fixed
+ *                   DListFindIndex() and DListInsertBefore(), so DList.c compiles.
+ * 17 Oct 2026 [AGT] Each list carves its nodes out of its own arena. DListFree() releases the arena.
+ * 17 Oct 2026 [AGT] DListDebugPrint() and DListDebugPrintRev() convert the elements straight into the output
+ *                   buffer.
+ * 17 Oct 2026 [AGT] Added the optional value index (see DListIndexValues()).
+ * 17 Oct 2026 [AGT] DListFindIndex() starts from the nearest of the head, the tail, and the finger.
+ * 17 Oct 2026 [AGT] DListCopy() shares the nodes of the source list until one of the lists is changed.
+ * 17 Oct 2026 [AGT] Added DListAppendN().
+ * 17 Oct 2026 [AGT] Added DListConcat() and DListSplice().
+ * 17 Oct 2026 [AGT] Added DListSort() and DListSortRadix().
+ * 17 Oct 2026 [AGT] Added DListSortParallel().
+ * 17 Oct 2026 [AGT] The comments on DListSplice() and DListConcat() give what they cost, including what merging
+ *                   the arenas costs DListFree().
  **************************************************************************************************************/
 #include <assert.h>     /* For assert() */
-#include <stdio.h>      /* For FILE, fprintf(), NULL */
+#include <stdio.h>      /* For NULL */
 #include <stdlib.h>     /* For free(), malloc() */
 #include "DList.h"      /* For DList struct and function declarations */
+#include "DListHash.h"  /* For DListHashAdd(), DListHashAlloc(), DListHashFind(), DListHashFree(), etc. */
 #include "DListNode.h"  /* For DListNode struct and function declarations */
+#include "Out.h"        /* For Out, OutCommit(), OutItoa(), OutReserve(), OutStr() */
+#include "Pool.h"       /* For PoolAlloc(), PoolFree(), PoolIsShared(), PoolMerge() */
+#include "Sort.h"       /* For SortParallelInt() */
 
 /*==============================================================================================================
  * Static function declarations.
  *============================================================================================================*/
-static DList *DListNodeRemove
+static DList *DListInsertNode
+    (
+    DList     *pList,
+    DListNode *pIndexNode,
+    int        pIndex,
+    int        pData
+    );
+
+static DList *DListRemoveNode
+    (
+    DList     *pList,
+    DListNode *pNode,
+    int        pIndex
+    );
+
+static bool DListUnshare
+    (
+    DList      *pList,
+    DListNode **pNode
+    );
+
+static void DListValueAdd
     (
     DList     *pList,
     DListNode *pNode
@@ -49,6 +88,10 @@ static DList *DListNodeRemove
  *     Set head pointer of new_list to null
  *     Set tail pointer of new_list to null
  *     Set size of new_list to 0
+ *     Set arena of new_list to a new pool of DListNode sized blocks
+ *     If the arena could not be allocated Then Deallocate new_list and Return null
+ *     Set the value index of new_list to null      -- The index is only built by DListIndexValues()
+ *     Set the finger and the share count of new_list to null
  * End If
  * Return new_list
  *------------------------------------------------------------------------------------------------------------*/
@@ -61,6 +104,14 @@ DList *DListAlloc
         DListSetHead(new_list, NULL);
         DListSetTail(new_list, NULL);
         DListSetSize(new_list, 0);
+        new_list->mArena = PoolAlloc(sizeof(DListNode));
+        if (!new_list->mArena) {
+            free(new_list);
+            return NULL;
+        }
+        new_list->mValues = NULL;
+        new_list->mFinger = NULL;
+        new_list->mShares = NULL;
     }
     return new_list;
 }
@@ -68,10 +119,12 @@ DList *DListAlloc
 /*--------------------------------------------------------------------------------------------------------------
  * FUNCT: DListAppend
  * DESCR: Appends a new node containing data member set to pData to the list pList. Returns a pointer to pList
- *        or NULL on failure, i.e., if pList is NULL.
+ *        or NULL on failure, i.e., if a node cannot be allocated. Assertion error if pList is NULL.
  * PCODE:
  * Assert pList is not null
- * Define new_node as DListNode * <- DListNodeAlloc(pData, DListGetTail(pList), null)
+ * Give pList nodes of its own if it shares them  -- Hint: Call DListUnshare()
+ * Define new_node as DListNode * <- DListNodeAllocFrom(arena of pList, pData, DListGetTail(pList), null)
+ * If new_node is null Then Return null
  * If pList is empty Then
  *     Set head pointer of pList to point to new_node
  * Else
@@ -80,6 +133,7 @@ DList *DListAlloc
  * End If
  * Set tail pointer of pList to point to new_node
  * Increment size of pList
+ * Add new_node to the value index of pList         -- Hint: Call DListValueAdd()
  * Return pList
  *------------------------------------------------------------------------------------------------------------*/
 DList *DListAppend
@@ -88,8 +142,11 @@ DList *DListAppend
     int    pData
     )
 {
+    DListNode *new_node;
     assert(pList);
-    DListNode *new_node = DListNodeAlloc(pData, DListGetTail(pList), NULL);
+    if (!DListUnshare(pList, NULL)) return NULL;
+    new_node = DListNodeAllocFrom(pList->mArena, pData, DListGetTail(pList), NULL);
+    if (!new_node) return NULL;
     if (DListIsEmpty(pList)) {
         DListSetHead(pList, new_node);
     } else {
@@ -97,91 +154,177 @@ DList *DListAppend
     }
     DListSetTail(pList, new_node);
     DListSetSize(pList, DListGetSize(pList) + 1);
+    DListValueAdd(pList, new_node);
     return pList;
 }
 
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListAppendN
+ * DESCR: Appends the pCount elements of pData to the list pList. The nodes are linked one after another and
+ *        the tail and size of pList are updated once at the end. Returns a pointer to pList or NULL on failure,
+ *        i.e., if memory cannot be allocated, in which case the elements appended before the failure stay in
+ *        the list. Assertion error if pList is NULL.
+ * PCODE:
+ * Assert pList is not null
+ * Make pList the only owner of its nodes
+ * tail <- tail node of pList
+ * For each element of pData Do
+ *     Allocate a new node containing the element, with prev set to tail
+ *     Link it after tail (or make it the head if pList is empty)
+ *     tail <- the new node
+ * End For
+ * Set the tail and size of pList
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListAppendN
+    (
+    DList     *pList,
+    const int *pData,
+    size_t     pCount
+    )
+{
+    DListNode *tail, *new_node;
+    size_t i;
+    assert(pList);
+    if (!DListUnshare(pList, NULL)) return NULL;
+    tail = DListGetTail(pList);
+    for (i = 0; i < pCount; ++i) {
+        new_node = DListNodeAllocFrom(pList->mArena, pData[i], tail, NULL);
+        if (!new_node) break;
+        if (tail) {
+            DListNodeSetNext(tail, new_node);
+        } else {
+            DListSetHead(pList, new_node);
+        }
+        tail = new_node;
+        DListValueAdd(pList, new_node);
+    }
+    DListSetTail(pList, tail);
+    DListSetSize(pList, DListGetSize(pList) + (int)i);
+    return i == pCount ? pList : NULL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListConcat
+ * DESCR: Moves every element of pSrc to the end of pDst, leaving pSrc empty. The nodes are relinked rather than
+ *        copied, see DListSplice(). The nodes it needs are at the ends of the lists, so it takes O(1) time
+ *        unless either list has a value index or shares its nodes with a copy. Returns pDst, or NULL if pDst and
+ *        pSrc are the same list or memory cannot be allocated. Assertion error if pDst or pSrc is NULL.
+ * PCODE:
+ * Assert pDst and pSrc are not null
+ * Return DListSplice(pDst, size of pDst, pSrc, 0, size of pSrc)
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListConcat
+    (
+    DList *pDst,
+    DList *pSrc
+    )
+{
+    assert(pDst && pSrc);
+    return DListSplice(pDst, DListGetSize(pDst), pSrc, 0, DListGetSize(pSrc));
+}
+
 /*--------------------------------------------------------------------------------------------------------------
  * FUNCT: DListCopy
- * DESCR: Makes an identical copy of list pSrcList and returns a pointer to the new list.
+ * DESCR: Makes an identical copy of list pSrcList and returns a pointer to the new list. If pSrcList keeps a
+ *        value index, so does the copy. Returns NULL if memory cannot be allocated. Assertion error if pSrcList
+ *        is NULL. The copy is copy-on-write: it shares the arena and the nodes of pSrcList, so making it takes
+ *        O(1) time and memory (plus building its value index, if any). The lists that share nodes count them-
+ *        selves in *mShares, and the first time any of them is changed it gets nodes of its own, see
+ *        DListUnshare(). A list that is only read never does.
  * PCODE:
  * Assert pSrcList is not null
- * Define copy_list as DList * <- DListAlloc()
- * Define traverse as DListNode * <- head pointer of pSrcList
- * While traverse is not null Do
- *     Get data value from traverse node             -- hint: call DListNodeGetData()
- *     Append data value to copy_list                -- hint: call DListAppend()
- *     Make traverse point to next node of pSrcList  -- Hint: Call DListNodeGetnext()
- * End While
+ * If pSrcList does not share its nodes Then Allocate its share count and set it to 1
+ * Define copy_list as DList * <- malloc(sizeof(DList))
+ * If copy_list is null Then Return null
+ * Copy every data member of pSrcList to copy_list     -- Head, tail, size, arena, and share count
+ * Set the value index and the finger of copy_list to null
+ * Increment the share count
+ * If pSrcList has a value index Then Build one for copy_list  -- Hint: Call DListIndexValues()
  * Return copy_list
  *------------------------------------------------------------------------------------------------------------*/
-DList *DListCopy(DList * pSrcList)
+DList *DListCopy
+    (
+    DList *pSrcList
+    )
 {
+    DList *copy_list;
     assert(pSrcList);
-    DList *copy_list = DListAlloc();
-    DListNode *traverse = DListGetHead(pSrcList);
-    while (traverse != NULL) {
-        DListGetData(traverse);
-        DListAppend(copy_list, traverse->mData);
-        traverse = DListNodeGetNext(pSrcList);
+    if (!pSrcList->mShares) {
+        if (!(pSrcList->mShares = (int *)malloc(sizeof(int)))) return NULL;
+        *pSrcList->mShares = 1;
     }
+    if (!(copy_list = (DList *)malloc(sizeof(DList)))) return NULL;
+    *copy_list = *pSrcList;
+    copy_list->mValues = NULL;
+    copy_list->mFinger = NULL;
+    ++*pSrcList->mShares;
+    if (pSrcList->mValues) DListIndexValues(copy_list);
     return copy_list;
 }
 
 /*--------------------------------------------------------------------------------------------------------------
  * FUNCT: DListDebugPrint
- * DESCR: Prints the contents of the list pList to the stream pStream. Prints "List is NULL" if L is NULL. This
- *        is primarily a testing and debugging function.
+ * DESCR: Prints the contents of the list pList to pOut. Prints "List is NULL" if L is NULL. This is primarily a
+ *        testing and debugging function. Each element is converted directly into the output buffer rather than
+ *        formatted with fprintf(), so printing a long list costs little more than copying it.
  *------------------------------------------------------------------------------------------------------------*/
 void DListDebugPrint
     (
-    FILE  *pStream,
+    Out   *pOut,
     DList *pList
 )
 {
     DListNode *traverse;
+    char *pos;
     if (!pList) {
-        fprintf(pStream, "List is NULL.\n");
+        OutStr(pOut, "List is NULL.\n");
         return;
     }
-    fprintf(pStream, "[ ");
-    traverse = DListGetHead(pList);
-    while (traverse) {
-        DListNodeDebugPrint(pStream, traverse);
-        fprintf(pStream, " ");
-        traverse = DListNodeGetNext(traverse);
+    OutStr(pOut, "[ ");
+    for (traverse = DListGetHead(pList); traverse; traverse = DListNodeGetNext(traverse)) {
+        pos = OutItoa(OutReserve(pOut, OUT_INT_CHARS + 1), DListNodeGetData(traverse));
+        *pos++ = ' ';
+        OutCommit(pOut, pos);
     }
-    fprintf(pStream, "]");
+    OutStr(pOut, "]");
 }
 
 /*--------------------------------------------------------------------------------------------------------------
  * FUNCT: DListDebugPrintRev
- * DESCR: Prints the contents of the list pList in reverse order to the stream pStream. Prints "List is NULL"
- *        if L is NULL. This is primarily a debugging function.
+ * DESCR: Prints the contents of the list pList in reverse order to pOut. Prints "List is NULL" if L is NULL.
+ *        This is primarily a debugging function.
  * PCODE:
  * This is a pretty easy function to write. Just study DListDebugPrint().
  *------------------------------------------------------------------------------------------------------------*/
-void DListDebugPrintRev(FILE *pStream ,DList *pList)
+void DListDebugPrintRev
+    (
+    Out   *pOut,
+    DList *pList
+    )
 {
     DListNode *traverse;
+    char *pos;
     if (!pList) {
-        fprintf(pStream, "List is NULL.\n");
+        OutStr(pOut, "List is NULL.\n");
         return;
     }
-    traverse = DListGetTail(pList);
-    while (traverse) {
-        DListNodeDebugPrint(pStream, traverse);
-        fprintf(pStream, " ");
-        traverse = DListNodeGetPrev(traverse);
+    OutStr(pOut, "[ ");
+    for (traverse = DListGetTail(pList); traverse; traverse = DListNodeGetPrev(traverse)) {
+        pos = OutItoa(OutReserve(pOut, OUT_INT_CHARS + 1), DListNodeGetData(traverse));
+        *pos++ = ' ';
+        OutCommit(pOut, pos);
     }
-    fprintf(pStream, "]");
+    OutStr(pOut, "]");
 }
 
 /*--------------------------------------------------------------------------------------------------------------
  * FUNCT: DListFindData
  * DESCR: Returns a pointer to the first node containing a data member matching pData. Returns NULL if pData is
- *        not in pList. Assertion error if pList is NULL.
+ *        not in pList. Assertion error if pList is NULL. O(1) expected if pList keeps a value index, otherwise
+ *        O(n).
  * PCODE:
  * Assert pList is not null
+ * If pList has a value index Then Return the first node of pData in the index  -- Hint: Call DListHashFind()
  * Define traverse as DListNode * <- head pointer of pList
  * While traverse is not null AND data member of traverse node != pData Do  -- Hint: Call DListNodeGetData()
  *     Make traverse point to next node of pList                            -- Hint: Call DListGetNext()
@@ -195,6 +338,7 @@ DListNode *DListFindData
     )
 {
     assert(pList);
+    if (pList->mValues) return DListHashFind(pList->mValues, pData);
     DListNode *traverse = DListGetHead(pList);
     while (traverse && DListNodeGetData(traverse) != pData) {
          traverse = DListNodeGetNext(traverse);
@@ -205,43 +349,69 @@ DListNode *DListFindData
 /*--------------------------------------------------------------------------------------------------------------
  * FUNCT: DListFindIndex
  * DESCR: Returns a pointer the node in pList at index pIndex. Fails if pIndex < 0 or pIndex >= pList->mSize
- *        and returns NULL. Assertion error if pList is NULL.
+ *        and returns NULL. Assertion error if pList is NULL. The walk starts from whichever of the head, the
+ *        tail, and the finger is nearest pIndex, and the node found becomes the finger, so finding an index
+ *        near the previous one takes O(1) steps.
  * PCODE:
  * Assert pList is not null
  * If pIndex < 0 OR pIndex >= size of pList Then Return null  -- Hint: Call DListGetSize()
- * Define traverse as DListNode * <- head pointer of pList    -- Hint: Call DListGetHead()
- * While traverse is not null AND --pIndex >= 0 Do
- *     Make traverse point to next node of pList              -- Hint: Call DListNodeGetNext()
- * End While
+ * If pIndex is in the first half of pList Then
+ *     Define traverse as DListNode * <- head pointer of pList, and index as int <- 0
+ * Else
+ *     Define traverse as DListNode * <- tail pointer of pList, and index as int <- size of pList - 1
+ * End If
+ * If pList has a finger AND it is nearer pIndex than index Then traverse <- finger, index <- finger index
+ * Walk traverse forward or backward until index equals pIndex  -- Hint: Call DListNodeGetNext()/GetPrev()
+ * Make traverse the finger of pList, at index pIndex
  * Return traverse
  *------------------------------------------------------------------------------------------------------------*/
-DListNode *DListFindIndex(DList *pList, int pIndex)
+DListNode *DListFindIndex
+    (
+    DList *pList,
+    int    pIndex
+    )
 {
+    DListNode *traverse;
+    int index;
     assert(pList);
-    if(pIndex<0 || pIndex >=DListGetSize(pList))
-    {
-        return NULL;
+    if (pIndex < 0 || pIndex >= DListGetSize(pList)) return NULL;
+    if (pIndex <= DListGetSize(pList) - 1 - pIndex) {
+        traverse = DListGetHead(pList);
+        index = 0;
+    } else {
+        traverse = DListGetTail(pList);
+        index = DListGetSize(pList) - 1;
     }
-    DListNode *traverse = DListGetHead(pList);
-    while(traverse != NULL && --pIndex >= 0)
-    {
-        traverse = DListNodeGetNext(pList);
+    if (pList->mFinger && abs(pList->mFingerIndex - pIndex) < abs(index - pIndex)) {
+        traverse = pList->mFinger;
+        index = pList->mFingerIndex;
     }
+    for (; index < pIndex; ++index) traverse = DListNodeGetNext(traverse);
+    for (; index > pIndex; --index) traverse = DListNodeGetPrev(traverse);
+    pList->mFinger = traverse;
+    pList->mFingerIndex = pIndex;
     return traverse;
 }
 
 /*--------------------------------------------------------------------------------------------------------------
  * FUNCT: DListFree
  * DESCR: Deallocates the linked list pList. This function should be called as soon as the list is no longer
-  *        needed. Returns NULL. Does nothing and returns NULL if pList is NULL.
+ *        needed. Returns NULL. Does nothing and returns NULL if pList is NULL. Every node of pList lives in the
+ *        list's arena, so the nodes are released by freeing the arena's slabs rather than by walking the list;
+ *        the cost is proportional to the number of slabs, not the number of nodes. If other lists share the
+ *        nodes of pList, they are left to the last of those lists to be freed. If the arena has been merged
+ *        with that of a list which is still in use (see DListSplice()), the nodes are given back to the arena
+ *        one at a time instead, which takes O(n) time, and the slabs stay allocated until the last list using
+ *        the arena is freed.
  * PCODE:
  * If pList is null Then Return null
- * Define traverse as DListNode * <- head pointer of pList
- * While traverse is not null Do
- *     Define next_node as DListNode * <- pointer to next node following traverse
- *     Deallocate traverse
- *     traverse <- next_node
- * End While
+ * If pList shares its nodes Then Decrement the share count
+ * If no other list shares the nodes of pList Then
+ *     Deallocate the share count, if there is one
+ *     If the arena of pList is shared Then Deallocate each node of pList  -- Hint: Call DListNodeFreeTo()
+ *     Deallocate the arena of pList                   -- Hint: Call PoolFree()
+ * End If
+ * Deallocate the value index of pList, if it has one  -- Hint: Call DListHashFree()
  * Deallocate pList
  * Return null
  *------------------------------------------------------------------------------------------------------------*/
@@ -250,13 +420,19 @@ DList *DListFree
     DList *pList
     )
 {
+    DListNode *traverse, *next;
     if (!pList) return NULL;
-    DListNode *traverse = DListGetHead(pList);
-    while (traverse) {
-        DListNode *next_node = DListNodeGetNext(traverse);
-        free(traverse);
-        traverse = next_node;
+    if (!pList->mShares || --*pList->mShares == 0) {
+        free(pList->mShares);
+        if (PoolIsShared(pList->mArena)) {
+            for (traverse = DListGetHead(pList); traverse; traverse = next) {
+                next = DListNodeGetNext(traverse);
+                DListNodeFreeTo(pList->mArena, traverse);
+            }
+        }
+        pList->mArena = PoolFree(pList->mArena);
     }
+    pList->mValues = DListHashFree(pList->mValues);
     free(pList);
     return NULL;
 }
@@ -277,9 +453,11 @@ DListNode *DListGetHead
 /*--------------------------------------------------------------------------------------------------------------
  * FUNCT: DListGetIndex
  * DESCR: Searches pList for a node containing data member set to pData. Returns the index if the node if it is
- *        found, or -1 if pData is not in pList. Assertion error if pList is NULL.
+ *        found, or -1 if pData is not in pList. Assertion error if pList is NULL. If pList keeps a value index,
+ *        a missing pData is detected in O(1) expected time.
  * PCODE:
  * Assert pList is not null.
+ * If pList has a value index and pData is not in it Then Return -1
  * Define index as int <- 0
  * Define traverse as DListNode * <- head pointer of pList            -- Hint: Call DListGetHead()
  * While traverse is not null Do
@@ -289,19 +467,21 @@ DListNode *DListGetHead
  * End If
  * Return -1
  *------------------------------------------------------------------------------------------------------------*/
-int DListGetIndex (DList *pList, int pData)
+int DListGetIndex
+    (
+    DList *pList,
+    int    pData
+    )
 {
-    assert(pList);
     int index = 0;
-    DListNode *traverse = DListGetHead(pList);
-    while(traverse != NULL)
-    {
-        if(DlistNodeGetData(traverse) == pData)
-        {
-            return index;
-            index++;
-            traverse = DListNodeGetNext(pList);
-        }
+    DListNode *traverse;
+    assert(pList);
+    if (pList->mValues && !DListHashFind(pList->mValues, pData)) return -1;
+    traverse = DListGetHead(pList);
+    while (traverse) {
+        if (DListNodeGetData(traverse) == pData) return index;
+        index++;
+        traverse = DListNodeGetNext(traverse);
     }
     return -1;
 }
@@ -332,6 +512,41 @@ DListNode *DListGetTail
     return pList->mTail;
 }
 
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListIndexValues
+ * DESCR: Makes pList keep a value index, a hash table from each value in the list to the first node holding
+ *        it, from now until the list is freed. DListFindData(), DListRemoveData(), and DListInsertBefore() then
+ *        find their node in O(1) expected time rather than by scanning the list, at the cost of roughly one
+ *        table slot per distinct value. Returns pList, or NULL if pList is NULL or the index cannot be built.
+ *        Does nothing if pList already keeps a value index.
+ * PCODE:
+ * If pList is null Then Return null
+ * If pList already has a value index Then Return pList
+ * Allocate the value index                                -- Hint: Call DListHashAlloc()
+ * Add every node of pList to the index, head to tail      -- Hint: Call DListHashAdd()
+ * If any of that fails Then Deallocate the index and Return null
+ * Return pList
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListIndexValues
+    (
+    DList *pList
+    )
+{
+    DListHash *values;
+    DListNode *traverse;
+    if (!pList) return NULL;
+    if (pList->mValues) return pList;
+    if (!(values = DListHashAlloc())) return NULL;
+    for (traverse = DListGetHead(pList); traverse; traverse = DListNodeGetNext(traverse)) {
+        if (!DListHashAdd(values, DListNodeGetData(traverse), traverse)) {
+            DListHashFree(values);
+            return NULL;
+        }
+    }
+    pList->mValues = values;
+    return pList;
+}
+
 /*--------------------------------------------------------------------------------------------------------------
  * FUNCT: DListInsertBefore
  * DESCR: Inserts a new node containing data member set to mData into list pList before the first occurrence of
@@ -339,22 +554,22 @@ DListNode *DListGetTail
  *        ing data member pBefore is not found and returns NULL. Assertion error if pList is NULL.
  * PCODE:
  * Assert pList is not null.
- * Define index as int <- DListFindData(pList, pBefore)
- * If index < 0 Then Return null
- * Else Return DListInsertIndex(pList, index, pData)
+ * Define before_node as DListNode * <- DListFindData(pList, pBefore)
+ * If before_node is null Then Return null
+ * Else Return DListInsertNode(pList, before_node, -1, pData)  -- The index of before_node is not known
  *------------------------------------------------------------------------------------------------------------*/
-DList *DListInsertBefore (DList *pList, int pBefore, int pData)
+DList *DListInsertBefore
+    (
+    DList *pList,
+    int    pBefore,
+    int    pData
+    )
 {
-	assert(pList);
-	int index = DListFindData(pList, pBefore);
-	if(index < 0)
-	{
-		return NULL;
-	}
-	else
-	{
-		return DListInsertIndex(pList, index, pData);
-	}
+    DListNode *before_node;
+    assert(pList);
+    before_node = DListFindData(pList, pBefore);
+    if (!before_node || !DListUnshare(pList, &before_node)) return NULL;
+    return DListInsertNode(pList, before_node, -1, pData);
 }
 
 /*--------------------------------------------------------------------------------------------------------------
@@ -365,48 +580,75 @@ DList *DListInsertBefore (DList *pList, int pBefore, int pData)
  *        call the DListAppend() function. Assertion error if pList is NULL.
  * PCODE:
  * Assert pList is not null.
- * Define index_node, new_node as DListNode *
  * If pList is empty OR pIndex < 0 OR pIndex >= size of pList Then Return null.
- * index_node <- DListFindIndex(pList, pIndex)
+ * Define index_node as DListNode * <- DListFindIndex(pList, pIndex)
  * If index_node is null Then Return null.
- * new_node <- DListNodeAlloc(pData, DListNodeGetPrev(index_node), index_node)
- * If the prev pointer of index_node is not null Then
- *     prev_index <- Get the prev pointer of index_node
+ * Return DListInsertNode(pList, index_node, pIndex, pData)
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListInsertIndex
+    (
+    DList *pList,
+    int    pIndex,
+    int    pData
+    )
+{
+    DListNode *index_node;
+    assert(pList);
+    if (DListIsEmpty(pList) || pIndex < 0 || pIndex >= DListGetSize(pList)) return NULL;
+    index_node = DListFindIndex(pList, pIndex);
+    if (!index_node || !DListUnshare(pList, &index_node)) return NULL;
+    return DListInsertNode(pList, index_node, pIndex, pData);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListInsertNode
+ * DESCR: Inserts a new node containing pData into the list pList before the node pIndexNode, whose index is
+ *        pIndex, or -1 if the caller does not know it. Returns pList, or NULL if a node cannot be allocated.
+ * PCODE:
+ * new_node <- DListNodeAllocFrom(arena of pList, pData, DListNodeGetPrev(pIndexNode), pIndexNode)
+ * If new_node is null Then Return null.
+ * If the prev pointer of pIndexNode is not null Then
+ *     prev_index <- Get the prev pointer of pIndexNode
  *     Set the next pointer of prev_index to point to new_node
  * Else
  *     Set the head pointer of pList to point to new_node
  * End If
- * Set the prev pointer of index_node to point to new_node
+ * Set the prev pointer of pIndexNode to point to new_node
  * Increment the size of pList
+ * If pIndex is known Then Make new_node the finger of pList, at index pIndex
+ * Else If the finger of pList is pIndexNode Then Increment the finger index
+ * Else Set the finger of pList to null  -- The finger may be after new_node, so its index is not known
+ * Add new_node to the value index of pList         -- Hint: Call DListValueAdd()
  * Return pList
  *------------------------------------------------------------------------------------------------------------*/
-DList *DListInsertIndex (DList *pList, int pIndex, int pData)
+static DList *DListInsertNode
+    (
+    DList     *pList,
+    DListNode *pIndexNode,
+    int        pIndex,
+    int        pData
+    )
 {
-	assert(pList);
-	DListNode *index_node;
-	DListNode *new_node;
-	if(DListIsEmpty(pList) || pIndex < 0 || pIndex >= DListGetSize(pList))
-	{
-		return NULL;
-	}
-	index_node = DListFindIndex(pList, pIndex);
-	if(index_node == NULL)
-	{
-		return NULL;
-	}
-	new_node = DListNodeAlloc(pData, DListNodeGetPrev(index_node), index_node);
-	if(DListNodeGetPrev(index_node) != NULL)
-	{
-		prev_index = DListNodeGetPrev(index_node);
-		DListNodeSetNext()//having trouble with this if statement
-	}
-	else
-	{
-		DListSetHead(pList, new_node);
-	}
-	DListNodeSetPrev(index_node, new_node);
-	DListSetSize(pList, DListGetSize(pList) + 1);
-	return pList;
+    DListNode *prev_index = DListNodeGetPrev(pIndexNode);
+    DListNode *new_node = DListNodeAllocFrom(pList->mArena, pData, prev_index, pIndexNode);
+    if (!new_node) return NULL;
+    if (prev_index) {
+        DListNodeSetNext(prev_index, new_node);
+    } else {
+        DListSetHead(pList, new_node);
+    }
+    DListNodeSetPrev(pIndexNode, new_node);
+    DListSetSize(pList, DListGetSize(pList) + 1);
+    DListValueAdd(pList, new_node);
+    if (pIndex >= 0) {
+        pList->mFinger = new_node;
+        pList->mFingerIndex = pIndex;
+    } else if (pList->mFinger == pIndexNode) {
+        ++pList->mFingerIndex;
+    } else {
+        pList->mFinger = NULL;
+    }
+    return pList;
 }
 
 /*--------------------------------------------------------------------------------------------------------------
@@ -429,8 +671,8 @@ bool DListIsEmpty
  *        returns NULL. Assertion error if pList is NULL.
  * PCODE:
  * Assert pList is not null.
- * Define index as int <- DListGetIndex(pList, pData)
- * Return DListRemoveIndex(pList, pIndex)
+ * Define data_node as DListNode * <- DListFindData(pList, pData)
+ * Return DListRemoveNode(pList, data_node, -1)  -- The index of data_node is not known
  *------------------------------------------------------------------------------------------------------------*/
 DList *DListRemoveData
     (
@@ -438,9 +680,11 @@ DList *DListRemoveData
     int    pData
     )
 {
+    DListNode *data_node;
     assert(pList);
-    int index = DListGetIndex(pList, pData);
-    return DListRemoveIndex(pList, index);
+    data_node = DListFindData(pList, pData);
+    if (!data_node || !DListUnshare(pList, &data_node)) return NULL;
+    return DListRemoveNode(pList, data_node, -1);
 }
 
 /*--------------------------------------------------------------------------------------------------------------
@@ -450,71 +694,84 @@ DList *DListRemoveData
  * PCODE:
  * Assert pList is not null.
  * Define index_node as DListNode * <- DlistFindIndex(pList, pIndex)
- * Return DListNodeRemove(pList, index_node);
+ * Return DListRemoveNode(pList, index_node, pIndex);
  *------------------------------------------------------------------------------------------------------------*/
-DList *DListRemoveIndex (DList *pList, int pIndex)
+DList *DListRemoveIndex
+    (
+    DList *pList,
+    int    pIndex
+    )
 {
+    DListNode *index_node;
     assert(pList);
-    DListNode *index_node = DListFindIndex(pList, pIndex);
-    return DListNodeRemove(pList, index_node);
+    index_node = DListFindIndex(pList, pIndex);
+    if (!index_node || !DListUnshare(pList, &index_node)) return NULL;
+    return DListRemoveNode(pList, index_node, pIndex);
 }
 
 /*--------------------------------------------------------------------------------------------------------------
- * FUNCT: DListNodeRemove
- * DESCR: Removes the node pNode from the list pList. Returns the list pList on success. Fails if pNode is NULL
- *        and returns NULL. Assertion error if pList is NULL.
+ * FUNCT: DListRemoveNode
+ * DESCR: Removes the node pNode, whose index is pIndex, or -1 if the caller does not know it, from the list
+ *        pList. Returns the list pList on success. Fails if pNode is NULL and returns NULL. Assertion error if
+ *        pList is NULL.
  * PCODE:
  * Assert pList is not null.
  * If pNode is null Then Return null.
+ * Remove pNode from the value index of pList, if it has one  -- Hint: Call DListHashRemove()
  * If pNode is the head node of pList Then
  *     Set the head pointer of pList to point to the next node following pNode
- *     If the head pointer of pList is not null Then
- *         Set the prev pointer of the head node to NULL
- *     End If
- * Else if pNode is the tail node of pList Then
- *     If the tail pointer of pList is not null Then
- *         tail_prev <- Get the prev pointer of the tail node of pList
- *         Set the next pointer of tail_prev to NULL
- *     End If
  * Else
- *     node_prev <- prev pointer of pNode
- *     If node_prev is not null Then
- *         Set the next pointer of node_prev to the next pointer of pNode
- *         If the next pointer of pNode is not null Then
- *             node_next <- Get the next pointer of pNode
- *             b <- Get the prev pointer of node_next
- *             Set the prev pointer of b to node_prev
- *         End If
- *     End If
+ *     Set the next pointer of the prev node of pNode to the next node following pNode
  * End If
- * Call DListNodeFree(pNode) to deallocate pNode
+ * If pNode is the tail node of pList Then
+ *     Set the tail pointer of pList to point to the prev node of pNode
+ * Else
+ *     Set the prev pointer of the next node of pNode to the prev node of pNode
+ * End If
+ * If pIndex is not known AND pNode is the finger of pList Then pIndex <- finger index
+ * If pIndex is known Then
+ *     Make the node after pNode the finger, at index pIndex, or if there is none the node before pNode, at
+ *     index pIndex - 1
+ * Else
+ *     Set the finger of pList to null
+ * End If
+ * Call DListNodeFreeTo(arena of pList, pNode) to deallocate pNode
  * Decrement the size of pList
  * Return pList
  *------------------------------------------------------------------------------------------------------------*/
-static DList *DListRemoveNode (DList *pList, DListNode *pNode)
+static DList *DListRemoveNode
+    (
+    DList     *pList,
+    DListNode *pNode,
+    int        pIndex
+    )
 {
+    DListNode *node_prev, *node_next;
     assert(pList);
-    if(pNode != NULL)
-    {
-        return NULL;
+    if (!pNode) return NULL;
+    if (pList->mValues) DListHashRemove(pList->mValues, DListNodeGetData(pNode), pNode);
+    node_prev = DListNodeGetPrev(pNode);
+    node_next = DListNodeGetNext(pNode);
+    if (node_prev) {
+        DListNodeSetNext(node_prev, node_next);
+    } else {
+        DListSetHead(pList, node_next);
     }
-    
-    if(pNode == DListGetHead(pList))
-    {
-        DListSetHead(pList, DListNodeGetNext(pNode));
-        if(DListNodeGetHead(pList) != NULL)
-        {
-            DListGetHead(pList)->mPrev = NULL;
-        }
+    if (node_next) {
+        DListNodeSetPrev(node_next, node_prev);
+    } else {
+        DListSetTail(pList, node_prev);
     }
-    else if (pNode == DListNodeGetTail(pList))
-    {
-        if(DListNodeGetTail(pList) != NULL)
-        {
-            DListNodeGetPrev
-        }
+    if (pIndex < 0 && pList->mFinger == pNode) pIndex = pList->mFingerIndex;
+    if (pIndex >= 0) {
+        pList->mFinger = node_next ? node_next : node_prev;
+        pList->mFingerIndex = node_next ? pIndex : pIndex - 1;
+    } else {
+        pList->mFinger = NULL;
     }
-    //Not Finished
+    DListNodeFreeTo(pList->mArena, pNode);
+    DListSetSize(pList, DListGetSize(pList) - 1);
+    return pList;
 }
 
 /*--------------------------------------------------------------------------------------------------------------
@@ -561,3 +818,301 @@ DList *DListSetTail
     pList->mTail = pTail;
     return pList;
 }
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListSort
+ * DESCR: Sorts the elements of pList into ascending order with a bottom-up merge sort of the nodes. The nodes
+ *        are relinked in place, so nothing is allocated unless pList shares its nodes (see DListCopy()). Equal
+ *        elements keep their order. O(n log n). Returns pList, or NULL if the shared nodes cannot be copied.
+ *        Assertion error if pList is NULL.
+ * PCODE:
+ * Make pList the only owner of its nodes  -- Hint: Call DListUnshare()
+ * For run length 1, 2, 4, ... until a pass merges no more than one pair of runs:
+ *     Walk the list merging each run of that many nodes with the run after it, relinking the nodes in order
+ *     (both the next and prev links) onto the end of the new list
+ * Set the head and the tail of pList to the first and last node of the new list
+ * pList no longer has a finger
+ * Rebuild the value index of pList if it has one
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListSort
+    (
+    DList *pList
+    )
+{
+    DListNode *list, *p, *q, *node, *tail;
+    int run, merges, p_size, q_size;
+    assert(pList);
+    if (DListGetSize(pList) < 2) return pList;
+    if (!DListUnshare(pList, NULL)) return NULL;
+    list = DListGetHead(pList);
+    for (run = 1; ; run *= 2) {
+        p = list;
+        list = tail = NULL;
+        for (merges = 0; p; ++merges) {
+            q = p;
+            for (p_size = 0; p_size < run && q; ++p_size) q = DListNodeGetNext(q);
+            q_size = run;
+            while (p_size > 0 || (q_size > 0 && q)) {
+                if (p_size > 0 && (q_size == 0 || !q || DListNodeGetData(p) <= DListNodeGetData(q))) {
+                    node = p;
+                    p = DListNodeGetNext(p);
+                    --p_size;
+                } else {
+                    node = q;
+                    q = DListNodeGetNext(q);
+                    --q_size;
+                }
+                if (tail) {
+                    DListNodeSetNext(tail, node);
+                } else {
+                    list = node;
+                }
+                DListNodeSetPrev(node, tail);
+                tail = node;
+            }
+            p = q;
+        }
+        DListNodeSetNext(tail, NULL);
+        if (merges <= 1) break;
+    }
+    DListSetHead(pList, list);
+    DListSetTail(pList, tail);
+    pList->mFinger = NULL;
+    if (pList->mValues) {
+        pList->mValues = DListHashFree(pList->mValues);
+        DListIndexValues(pList);
+    }
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListSortParallel
+ * DESCR: Sorts the elements of pList into ascending order: the elements are copied into an array, where
+ *        SortParallelInt() radix sorts one run of them on each of up to pThreads threads (one per processor if
+ *        pThreads is less than 1) and then merges the runs, and they are stored back into the nodes in order. The
+ *        nodes stay where they are. The result is the same for any number of threads. Takes two temporary arrays of
+ *        n ints. Returns pList, or NULL if memory cannot be allocated, in which case pList is unchanged. Assertion
+ *        error if pList is NULL.
+ * PCODE:
+ * Make pList the only owner of its nodes  -- Hint: Call DListUnshare()
+ * Copy the elements of pList, from head to tail, into a new array
+ * Sort the array  -- Hint: Call SortParallelInt()
+ * Store the elements of the array, in order, into the nodes of pList from head to tail
+ * Rebuild the value index of pList if it has one
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListSortParallel
+    (
+    DList *pList,
+    int    pThreads
+    )
+{
+    DListNode *traverse;
+    int *values, i;
+    assert(pList);
+    if (DListGetSize(pList) < 2) return pList;
+    if (!DListUnshare(pList, NULL)) return NULL;
+    if (!(values = (int *)malloc(DListGetSize(pList) * sizeof(int)))) return NULL;
+    for (i = 0, traverse = DListGetHead(pList); traverse; traverse = DListNodeGetNext(traverse)) {
+        values[i++] = DListNodeGetData(traverse);
+    }
+    if (!SortParallelInt(values, (size_t)DListGetSize(pList), pThreads)) {
+        free(values);
+        return NULL;
+    }
+    for (i = 0, traverse = DListGetHead(pList); traverse; traverse = DListNodeGetNext(traverse)) {
+        DListNodeSetData(traverse, values[i++]);
+    }
+    free(values);
+    if (pList->mValues) {
+        pList->mValues = DListHashFree(pList->mValues);
+        DListIndexValues(pList);
+    }
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListSortRadix
+ * DESCR: Sorts the elements of pList into ascending order with DListSortParallel() on one thread, so the whole list
+ *        is a single run, radix sorted by SortRadixInt() in O(n) time, and there is nothing to merge. Faster than
+ *        DListSort() for large lists. Returns pList, or NULL if memory cannot be allocated, in which case pList is
+ *        unchanged. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListSortRadix
+    (
+    DList *pList
+    )
+{
+    return DListSortParallel(pList, 1);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListSplice
+ * DESCR: Moves the elements at indices pFrom through pTo - 1 of pSrc into pDst, before the element at index
+ *        pPos, or at the end if pPos is the size of pDst. The nodes are relinked rather than copied, which takes
+ *        O(1) time however many elements move. The splice as a whole is O(n) at worst, though: finding the nodes
+ *        at the three indices walks from the nearest of the head, the tail, and the finger, a list with a value
+ *        index has it rebuilt, and a list that shares its nodes with a copy is copied first. Returns pDst, or
+ *        NULL if pDst and pSrc are the same list, an index is out of range, or memory cannot be allocated.
+ *        Assertion error if pDst or pSrc is NULL.
+ *
+ *        The moved nodes still live in the arena of pSrc, so the arenas of the two lists are merged (see
+ *        PoolMerge()). That is a trade-off: the merge lasts until both lists are freed, and while the other list
+ *        is in use DListFree() of either one gives its nodes back one at a time, in O(n) time, instead of
+ *        releasing slabs. No slab of the merged arena goes back to the system until every list that was spliced
+ *        into it has been freed.
+ * PCODE:
+ * Assert pDst and pSrc are not null
+ * If pDst is pSrc or pPos, pFrom, or pTo is out of range Then Return null
+ * If pFrom = pTo Then Return pDst
+ * Make pDst and pSrc the only owners of their nodes  -- Hint: Call DListUnshare()
+ * first <- node at index pFrom of pSrc, last <- node at index pTo - 1 of pSrc
+ * before <- node at index pPos of pDst, null if pPos is the size of pDst
+ * Unlink the chain first..last from pSrc
+ * Link the chain first..last into pDst before before (or after the tail of pDst if before is null)
+ * Update the sizes of pDst and pSrc
+ * Make first the finger of pDst, and the node that took the place of first the finger of pSrc
+ * Merge the arena of pSrc into the arena of pDst  -- Hint: Call PoolMerge()
+ * Rebuild the value index of each list that has one
+ * Return pDst
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListSplice
+    (
+    DList *pDst,
+    int    pPos,
+    DList *pSrc,
+    int    pFrom,
+    int    pTo
+    )
+{
+    DListNode *first, *last, *before, *src_prev, *src_next, *dst_prev;
+    assert(pDst && pSrc);
+    if (pDst == pSrc || pPos < 0 || pPos > DListGetSize(pDst)) return NULL;
+    if (pFrom < 0 || pFrom > pTo || pTo > DListGetSize(pSrc)) return NULL;
+    if (pFrom == pTo) return pDst;
+    if (!DListUnshare(pDst, NULL) || !DListUnshare(pSrc, NULL)) return NULL;
+    first = DListFindIndex(pSrc, pFrom);
+    last = DListFindIndex(pSrc, pTo - 1);
+    before = DListFindIndex(pDst, pPos);
+    src_prev = DListNodeGetPrev(first);
+    src_next = DListNodeGetNext(last);
+    if (src_prev) {
+        DListNodeSetNext(src_prev, src_next);
+    } else {
+        DListSetHead(pSrc, src_next);
+    }
+    if (src_next) {
+        DListNodeSetPrev(src_next, src_prev);
+    } else {
+        DListSetTail(pSrc, src_prev);
+    }
+    dst_prev = before ? DListNodeGetPrev(before) : DListGetTail(pDst);
+    DListNodeSetPrev(first, dst_prev);
+    DListNodeSetNext(last, before);
+    if (dst_prev) {
+        DListNodeSetNext(dst_prev, first);
+    } else {
+        DListSetHead(pDst, first);
+    }
+    if (before) {
+        DListNodeSetPrev(before, last);
+    } else {
+        DListSetTail(pDst, last);
+    }
+    DListSetSize(pSrc, DListGetSize(pSrc) - (pTo - pFrom));
+    DListSetSize(pDst, DListGetSize(pDst) + (pTo - pFrom));
+    pDst->mFinger = first;
+    pDst->mFingerIndex = pPos;
+    pSrc->mFinger = src_next ? src_next : src_prev;
+    pSrc->mFingerIndex = src_next ? pFrom : pFrom - 1;
+    PoolMerge(pDst->mArena, pSrc->mArena);
+    if (pDst->mValues) {
+        pDst->mValues = DListHashFree(pDst->mValues);
+        DListIndexValues(pDst);
+    }
+    if (pSrc->mValues) {
+        pSrc->mValues = DListHashFree(pSrc->mValues);
+        DListIndexValues(pSrc);
+    }
+    return pDst;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListUnshare
+ * DESCR: Called before pList is changed. If pList shares its nodes with other lists (see DListCopy()), gives it
+ *        a new arena holding a copy of its nodes, so the change does not show in the other lists. If pNode is
+ *        not NULL, *pNode is a node of pList and is made to point to the copy of that node. If pList was the
+ *        last list sharing its nodes, it simply takes them over. Returns false, leaving pList unchanged, if
+ *        memory cannot be allocated.
+ * PCODE:
+ * If pList does not share its nodes Then Return true
+ * If other lists share the nodes of pList Then
+ *     Allocate a new arena
+ *     Append a copy of each node of pList, head to tail, to a new chain of nodes carved from the new arena
+ *     If any of that fails Then Deallocate the new arena and Return false
+ *     Point *pNode and the finger at their copies
+ *     Decrement the share count
+ *     Make the new arena and chain the arena, head, and tail of pList
+ *     If pList has a value index Then Rebuild it over the new nodes  -- Hint: Call DListIndexValues()
+ * Else
+ *     Deallocate the share count
+ * End If
+ * Set the share count of pList to null
+ * Return true
+ *------------------------------------------------------------------------------------------------------------*/
+static bool DListUnshare
+    (
+    DList      *pList,
+    DListNode **pNode
+    )
+{
+    Pool *arena;
+    DListNode *traverse, *new_node, *head = NULL, *tail = NULL, *finger = NULL;
+    if (!pList->mShares) return true;
+    if (*pList->mShares > 1) {
+        if (!(arena = PoolAlloc(sizeof(DListNode)))) return false;
+        for (traverse = DListGetHead(pList); traverse; traverse = DListNodeGetNext(traverse)) {
+            new_node = DListNodeAllocFrom(arena, DListNodeGetData(traverse), tail, NULL);
+            if (!new_node) {
+                PoolFree(arena);
+                return false;
+            }
+            if (tail) {
+                DListNodeSetNext(tail, new_node);
+            } else {
+                head = new_node;
+            }
+            tail = new_node;
+            if (pNode && *pNode == traverse) *pNode = new_node;
+            if (pList->mFinger == traverse) finger = new_node;
+        }
+        --*pList->mShares;
+        pList->mArena = arena;
+        DListSetHead(pList, head);
+        DListSetTail(pList, tail);
+        pList->mFinger = finger;
+        if (pList->mValues) {
+            pList->mValues = DListHashFree(pList->mValues);
+            DListIndexValues(pList);
+        }
+    } else {
+        free(pList->mShares);
+    }
+    pList->mShares = NULL;
+    return true;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListValueAdd
+ * DESCR: Adds pNode, which has just been linked into pList, to the value index of pList if it keeps one. If the
+ *        index cannot grow, it is dropped and the list goes back to finding values by scanning.
+ *------------------------------------------------------------------------------------------------------------*/
+static void DListValueAdd
+    (
+    DList     *pList,
+    DListNode *pNode
+    )
+{
+    if (pList->mValues && !DListHashAdd(pList->mValues, DListNodeGetData(pNode), pNode)) {
+        pList->mValues = DListHashFree(pList->mValues);
+    }
+}
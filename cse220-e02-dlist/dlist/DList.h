@@ -19,21 +19,90 @@
  * MODIFICATION HISTORY:
  * -------------------------------------------------------------------------------------------------------------
  * 10 Mar 2012 [KRB] Initial revision.
+ * 17 Oct 2026 [AGT] Corrected the return types of DListFindData(), DListFindIndex(), and DListGetIndex().
+ * 17 Oct 2026 [AGT] Each list carves its nodes out of its own arena.
+ * 17 Oct 2026 [AGT] DListDebugPrint() and DListDebugPrintRev() write to an Out rather than a FILE.
+ * 17 Oct 2026 [AGT] Added the skip list lanes used when building with LAYOUT=indexed (see DListIndexed.c).
+ * 17 Oct 2026 [AGT] Added the optional value index, see DListIndexValues().
+ * 17 Oct 2026 [AGT] Documented the unrolled layout (see DListUnrolled.c).
+ * 17 Oct 2026 [AGT] Added the node array used when building with LAYOUT=compact (see DListCompact.c).
+ * 17 Oct 2026 [AGT] Added the finger, see DListFindIndex().
+ * 17 Oct 2026 [AGT] Added the share count of copy-on-write copies, see DListCopy().
+ * 17 Oct 2026 [AGT] Added DListAppendN().
+ * 17 Oct 2026 [AGT] Added DListConcat() and DListSplice().
+ * 17 Oct 2026 [AGT] Added DListSort() and DListSortRadix().
+ * 17 Oct 2026 [AGT] Added DListSortParallel().
+ * 17 Oct 2026 [AGT] Added mLaneRandom, the lane random number generator of each list.
  **************************************************************************************************************/
 #ifndef __DLIST_H__
 #define __DLIST_H__
 
-#include <stdio.h>      /* For FILE */
+#include "DListHash.h"  /* For DListHash */
 #include "DListNode.h"  /* For DListNode structure */
+#include "Out.h"        /* For Out */
+#include "Pool.h"       /* For Pool */
 #include "Types.h"      /* For bool */
 
+#ifdef DLIST_INDEXED
 /*==============================================================================================================
- * Defines a type for the DList data structure.
+ * Preprocessor macro definitions.
+ *============================================================================================================*/
+#define DLIST_MAX_LEVEL 16           /* Number of lane levels. With 1 in 4 lane nodes promoted this covers 4^16. */
+#define DLIST_LANE_SEED 2463534242UL  /* Seed of each list's lane generator, so a script builds the same lanes.  */
+
+/*==============================================================================================================
+ * An indexed list keeps levels of "express lanes" above its nodes, i.e., an indexable skip list. A lane node
+ * on level 0 stands for roughly one list node in four, a lane node on level 1 for one in sixteen, and so on.
+ * Each lane node records how many list nodes it skips, so finding the node at an index takes O(log n) steps.
+ *============================================================================================================*/
+typedef struct DListLane_ {
+    struct DListLane_ *mNext;   /* Next lane node on the same level.                                     */
+    struct DListLane_ *mDown;   /* Lane node for the same list node one level down. NULL on level 0.     */
+    DListNode         *mNode;   /* The list node this lane node stands for.                              */
+    int                mWidth;  /* Index of mNode minus the index of the previous lane node on the level. */
+} DListLane;
+#endif
+
+/*==============================================================================================================
+ * Defines a type for the DList data structure. Every node of a list is carved out of the list's arena, so
+ * DListFree() can release the whole list a slab at a time instead of a node at a time. mValues is NULL unless
+ * DListIndexValues() has been called on the list. When building with LAYOUT=unrolled each node holds a run of
+ * elements (see DListNode.h) and mSize counts elements rather than nodes. When building with LAYOUT=compact
+ * the nodes live in one array per list instead of an arena, and link to each other by 32-bit offsets.
+ *
+ * The linked and compact layouts remember the node most recently found by index, or inserted or removed by
+ * index, along with its index: the finger. DListFindIndex() starts from whichever of the head, the tail, and
+ * the finger is nearest, so a run of positional operations close to each other costs little per operation.
+ * In those layouts DListCopy() is copy-on-write: the copy shares the nodes of the source until one of the
+ * lists sharing them is changed, and mShares counts the lists sharing them.
  *============================================================================================================*/
 typedef struct {
-    DListNode *mHead;  /* Pointer to first node in the list. */
-    DListNode *mTail;  /* Pointer to last node in the list.  */
-    int        mSize;  /* Number of nodes in list.           */
+    DListNode *mHead;    /* Pointer to first node in the list. */
+    DListNode *mTail;    /* Pointer to last node in the list.  */
+    int        mSize;    /* Number of nodes in list.           */
+#ifndef DLIST_COMPACT
+    Pool      *mArena;   /* Pool that the nodes are carved from. */
+#endif
+    DListHash *mValues;  /* Value index, or NULL if the list does not keep one. */
+#if !defined(DLIST_INDEXED) && !defined(DLIST_UNROLLED)
+    DListNode *mFinger;       /* Node most recently reached by index, or NULL if there is none. */
+    int        mFingerIndex;  /* Index of mFinger.                                              */
+    int       *mShares;       /* Number of lists sharing the nodes, or NULL if no other list has. */
+#endif
+#ifdef DLIST_COMPACT
+    DListNode *mNodes;     /* Array the nodes live in. Moves when it grows.                */
+    int        mCapacity;  /* Number of nodes mNodes has room for.                        */
+    int        mUsed;      /* mNodes[0..mUsed-1] have been handed out at some time.       */
+    DListNode *mFree;      /* Removed nodes, linked through mNext, waiting to be reused.  */
+#endif
+#ifdef DLIST_INDEXED
+    Pool         *mLaneArena;                       /* Pool that the lane nodes are carved from.          */
+    int           mLevels;                          /* Number of lane levels that hold any lane nodes.    */
+    DListLane     mLaneHead[DLIST_MAX_LEVEL];       /* Sentinel at index -1 at the start of each level.   */
+    DListLane    *mLaneTail[DLIST_MAX_LEVEL];       /* Last lane node of each level, so appends are O(1). */
+    int           mLaneTailIndex[DLIST_MAX_LEVEL];  /* Index of the node mLaneTail[level] stands for.     */
+    unsigned long mLaneRandom;                      /* State of the xorshift generator of lane heights.   */
+#endif
 } DList;
 
 /*==============================================================================================================
@@ -49,6 +118,19 @@ extern DList *DListAppend
     int    pData
     );
 
+extern DList *DListAppendN
+    (
+    DList     *pList,
+    const int *pData,
+    size_t     pCount
+    );
+
+extern DList *DListConcat
+    (
+    DList *pDst,
+    DList *pSrc
+    );
+
 /* Function declaration for DListCopy() */
 extern DList *DListCopy
     (
@@ -57,26 +139,26 @@ extern DList *DListCopy
 
 extern void DListDebugPrint
     (
-    FILE *stream,
+    Out   *pOut,
     DList *pList
     );
 
 /* Function declaration for DListDebugPrintRev() */
 extern void DListDebugPrintRev
     (
-    FILE *stream,
+    Out   *pOut,
     DList *pList
     );
 
 /* Function declaration for DListFindData() */
-extern DNode *DListFindData
+extern DListNode *DListFindData
     (
     DList *pList,
     int    pData
     );
 
 /* Function declaration for DListFindIndx() */
-extern DNode *DListFindIndex
+extern DListNode *DListFindIndex
     (
     DList *pList,
     int    pIndex
@@ -93,7 +175,7 @@ extern DListNode *DListGetHead
     );
 
 /* Function declaration for DListGetIndex() */
-extern DListNode *DListGetIndex
+extern int DListGetIndex
     (
     DList *pList,
     int    pData
@@ -109,6 +191,11 @@ extern DListNode *DListGetTail
     DList *pList
     );
 
+extern DList *DListIndexValues
+    (
+    DList *pList
+    );
+
 /* Function declaration for DListInsertBefore() */
 extern DList *DListInsertBefore
     (
@@ -144,6 +231,31 @@ extern DList *DListRemoveIndex
     int    pIndex
     );
 
+extern DList *DListSort
+    (
+    DList *pList
+    );
+
+extern DList *DListSortParallel
+    (
+    DList *pList,
+    int    pThreads
+    );
+
+extern DList *DListSortRadix
+    (
+    DList *pList
+    );
+
+extern DList *DListSplice
+    (
+    DList *pDst,
+    int    pPos,
+    DList *pSrc,
+    int    pFrom,
+    int    pTo
+    );
+
 extern DList *DListSetHead
     (
     DList     *pList,
@@ -0,0 +1,950 @@
+/***************************************************************************************************************
+ * FILE: DListCompact.c
+ *
+ * DESCRIPTION
+ * An implementation of the DList.h functions for lists of many small nodes. It is built in place of DList.c by
+ * running "make LAYOUT=compact", which also defines DLIST_COMPACT so DListNode.h declares the compact node.
+ *
+ * Rather than carving its nodes out of an arena, each list keeps them in one array, mNodes, and the nodes link
+ * to each other by their distance in the array, which fits in an int. A node is then 12 bytes on a 64-bit
+ * machine rather than 24, and there is no per-slab or per-block overhead. When the array is full it is moved
+ * to one half again as large, and since the links are relative only the pointers held outside the array (the
+ * head, the tail, the free list, and the value index) need adjusting. Removed nodes are kept on a free list,
+ * linked through mNext, and reused before the array grows. Freeing a list frees the array.
+ *
+ * Copying a list shares its array, as in DList.c, until one of the lists sharing it is changed. That list then
+ * copies the array as a whole, links and all, and moves its pointers into the copy just as DListGrow() does.
+ *
+ * Because the array moves as the list grows, a DListNode * returned by DListFindData(), DListFindIndex(),
+ * DListGetHead(), or DListGetTail() is only good until the list is next changed.
+ *
+ * The finger (see DList.h) works as in DList.c; it is a node of the array, so DListGrow() moves it along with
+ * the head and the tail.
+ *
+ * AUTHOR INFORMATION
+ * agent [AGT]
+ *
+ * Email: agent@local
+ *
+ * MODIFICATION HISTORY:
+ * -------------------------------------------------------------------------------------------------------------
+ * 17 Oct 2026 [AGT] Initial revision.
+ * 17 Oct 2026 [AGT] DListFindIndex() starts from the nearest of the head, the tail, and the finger.
+ * 17 Oct 2026 [AGT] DListCopy() shares the node array of the source list until one of the lists is changed.
+ * 17 Oct 2026 [AGT] Added DListAppendN().
+ * 17 Oct 2026 [AGT] Added DListConcat() and DListSplice().
+ * 17 Oct 2026 [AGT] Added DListSort() and DListSortRadix().
+ * 17 Oct 2026 [AGT] Added DListSortParallel().
+ **************************************************************************************************************/
+#include <assert.h>     /* For assert() */
+#include <limits.h>     /* For INT_MAX */
+#include <stdio.h>      /* For NULL */
+#include <stdlib.h>     /* For free(), malloc() */
+#include <string.h>     /* For memcpy() */
+#include "DList.h"      /* For DList struct and function declarations */
+#include "DListHash.h"  /* For DListHashAdd(), DListHashAlloc(), DListHashFind(), DListHashFree(), etc. */
+#include "DListNode.h"  /* For DListNode struct and function declarations */
+#include "Out.h"        /* For Out, OutCommit(), OutItoa(), OutReserve(), OutStr() */
+#include "Sort.h"       /* For SortParallelInt() */
+
+#ifndef DLIST_COMPACT
+#error DListCompact.c must be compiled with -DDLIST_COMPACT (make LAYOUT=compact)
+#endif
+
+/*==============================================================================================================
+ * Preprocessor macro definitions.
+ *============================================================================================================*/
+#define DLIST_MIN_CAPACITY 16  /* Number of nodes the node array has room for when it is first allocated. */
+
+/*==============================================================================================================
+ * Static function declarations.
+ *============================================================================================================*/
+static bool DListGrow
+    (
+    DList *pList
+    );
+
+static void DListRebase
+    (
+    DList     *pList,
+    DListNode *pOldNodes,
+    DListNode *pNewNodes
+    );
+
+static DList *DListInsertNode
+    (
+    DList     *pList,
+    DListNode *pIndexNode,
+    int        pIndex,
+    int        pData
+    );
+
+static DListNode *DListNewNode
+    (
+    DList *pList,
+    int    pData
+    );
+
+static DList *DListRemoveNode
+    (
+    DList     *pList,
+    DListNode *pNode,
+    int        pIndex
+    );
+
+static bool DListUnshare
+    (
+    DList      *pList,
+    DListNode **pNode
+    );
+
+static void DListValueAdd
+    (
+    DList     *pList,
+    DListNode *pNode
+    );
+
+/*==============================================================================================================
+ * Function definitions.
+ *============================================================================================================*/
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListAlloc
+ * DESCR: Allocate a new linked list, with no finger. Returns a pointer to the allocated list or NULL on failure.
+ *        The node array is not allocated until the first node is added.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListAlloc
+    (
+    )
+{
+    DList *new_list = (DList *)malloc(sizeof(DList));
+    if (new_list) {
+        DListSetHead(new_list, NULL);
+        DListSetTail(new_list, NULL);
+        DListSetSize(new_list, 0);
+        new_list->mValues = NULL;
+        new_list->mNodes = NULL;
+        new_list->mCapacity = 0;
+        new_list->mUsed = 0;
+        new_list->mFree = NULL;
+        new_list->mFinger = NULL;
+        new_list->mShares = NULL;
+    }
+    return new_list;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListAppend
+ * DESCR: Appends a new node containing data member set to pData to the list pList. Returns a pointer to pList
+ *        or NULL on failure, i.e., if a node cannot be allocated. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListAppend
+    (
+    DList *pList,
+    int    pData
+    )
+{
+    DListNode *new_node;
+    assert(pList);
+    if (!DListUnshare(pList, NULL) || !(new_node = DListNewNode(pList, pData))) return NULL;
+    DListNodeSetPrev(new_node, DListGetTail(pList));
+    if (DListIsEmpty(pList)) {
+        DListSetHead(pList, new_node);
+    } else {
+        DListNodeSetNext(DListGetTail(pList), new_node);
+    }
+    DListSetTail(pList, new_node);
+    DListSetSize(pList, DListGetSize(pList) + 1);
+    DListValueAdd(pList, new_node);
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListAppendN
+ * DESCR: Appends the pCount elements of pData to the list pList. If there are no freed nodes to reuse, the node
+ *        array is grown once up front to hold all of them, so the new nodes are consecutive in the array.
+ *        Returns a pointer to pList or NULL on failure, i.e., if a node cannot be allocated, in which case the
+ *        elements appended before the failure stay in the list. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListAppendN
+    (
+    DList     *pList,
+    const int *pData,
+    size_t     pCount
+    )
+{
+    DListNode *new_node;
+    size_t i;
+    assert(pList);
+    if (!DListUnshare(pList, NULL)) return NULL;
+    while (!pList->mFree && (size_t)(pList->mCapacity - pList->mUsed) < pCount && DListGrow(pList)) continue;
+    for (i = 0; i < pCount; ++i) {
+        if (!(new_node = DListNewNode(pList, pData[i]))) break;
+        DListNodeSetPrev(new_node, DListGetTail(pList));
+        if (DListIsEmpty(pList)) {
+            DListSetHead(pList, new_node);
+        } else {
+            DListNodeSetNext(DListGetTail(pList), new_node);
+        }
+        DListSetTail(pList, new_node);
+        DListSetSize(pList, DListGetSize(pList) + 1);
+        DListValueAdd(pList, new_node);
+    }
+    return i == pCount ? pList : NULL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListConcat
+ * DESCR: Moves every element of pSrc to the end of pDst, leaving pSrc empty. See DListSplice(). Returns pDst, or
+ *        NULL if pDst and pSrc are the same list or memory cannot be allocated. Assertion error if pDst or pSrc
+ *        is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListConcat
+    (
+    DList *pDst,
+    DList *pSrc
+    )
+{
+    assert(pDst && pSrc);
+    return DListSplice(pDst, DListGetSize(pDst), pSrc, 0, DListGetSize(pSrc));
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListCopy
+ * DESCR: Makes an identical copy of list pSrcList and returns a pointer to the new list. If pSrcList keeps a
+ *        value index, so does the copy. Returns NULL if memory cannot be allocated. Assertion error if pSrcList
+ *        is NULL. As in DList.c, the copy shares the node array of pSrcList until one of the lists sharing it is
+ *        changed, so making it takes O(1) time and memory (plus building its value index, if any).
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListCopy
+    (
+    DList *pSrcList
+    )
+{
+    DList *copy_list;
+    assert(pSrcList);
+    if (!pSrcList->mShares) {
+        if (!(pSrcList->mShares = (int *)malloc(sizeof(int)))) return NULL;
+        *pSrcList->mShares = 1;
+    }
+    if (!(copy_list = (DList *)malloc(sizeof(DList)))) return NULL;
+    *copy_list = *pSrcList;
+    copy_list->mValues = NULL;
+    copy_list->mFinger = NULL;
+    ++*pSrcList->mShares;
+    if (pSrcList->mValues) DListIndexValues(copy_list);
+    return copy_list;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListDebugPrint
+ * DESCR: Prints the contents of the list pList to pOut. Prints "List is NULL" if L is NULL. This is primarily a
+ *        testing and debugging function.
+ *------------------------------------------------------------------------------------------------------------*/
+void DListDebugPrint
+    (
+    Out   *pOut,
+    DList *pList
+    )
+{
+    DListNode *traverse;
+    char *pos;
+    if (!pList) {
+        OutStr(pOut, "List is NULL.\n");
+        return;
+    }
+    OutStr(pOut, "[ ");
+    for (traverse = DListGetHead(pList); traverse; traverse = DListNodeGetNext(traverse)) {
+        pos = OutItoa(OutReserve(pOut, OUT_INT_CHARS + 1), DListNodeGetData(traverse));
+        *pos++ = ' ';
+        OutCommit(pOut, pos);
+    }
+    OutStr(pOut, "]");
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListDebugPrintRev
+ * DESCR: Prints the contents of the list pList in reverse order to pOut. Prints "List is NULL" if L is NULL.
+ *        This is primarily a debugging function.
+ *------------------------------------------------------------------------------------------------------------*/
+void DListDebugPrintRev
+    (
+    Out   *pOut,
+    DList *pList
+    )
+{
+    DListNode *traverse;
+    char *pos;
+    if (!pList) {
+        OutStr(pOut, "List is NULL.\n");
+        return;
+    }
+    OutStr(pOut, "[ ");
+    for (traverse = DListGetTail(pList); traverse; traverse = DListNodeGetPrev(traverse)) {
+        pos = OutItoa(OutReserve(pOut, OUT_INT_CHARS + 1), DListNodeGetData(traverse));
+        *pos++ = ' ';
+        OutCommit(pOut, pos);
+    }
+    OutStr(pOut, "]");
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListFindData
+ * DESCR: Returns a pointer to the first node containing a data member matching pData. Returns NULL if pData is
+ *        not in pList. Assertion error if pList is NULL. O(1) expected if pList keeps a value index.
+ *------------------------------------------------------------------------------------------------------------*/
+DListNode *DListFindData
+    (
+    DList *pList,
+    int    pData
+    )
+{
+    DListNode *traverse;
+    assert(pList);
+    if (pList->mValues) return DListHashFind(pList->mValues, pData);
+    traverse = DListGetHead(pList);
+    while (traverse && DListNodeGetData(traverse) != pData) {
+        traverse = DListNodeGetNext(traverse);
+    }
+    return traverse;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListFindIndex
+ * DESCR: Returns a pointer the node in pList at index pIndex. Fails if pIndex < 0 or pIndex >= pList->mSize
+ *        and returns NULL. Assertion error if pList is NULL. As in DList.c, the walk starts from whichever of
+ *        the head, the tail, and the finger is nearest pIndex, and the node found becomes the finger.
+ *------------------------------------------------------------------------------------------------------------*/
+DListNode *DListFindIndex
+    (
+    DList *pList,
+    int    pIndex
+    )
+{
+    DListNode *traverse;
+    int index;
+    assert(pList);
+    if (pIndex < 0 || pIndex >= DListGetSize(pList)) return NULL;
+    if (pIndex <= DListGetSize(pList) - 1 - pIndex) {
+        traverse = DListGetHead(pList);
+        index = 0;
+    } else {
+        traverse = DListGetTail(pList);
+        index = DListGetSize(pList) - 1;
+    }
+    if (pList->mFinger && abs(pList->mFingerIndex - pIndex) < abs(index - pIndex)) {
+        traverse = pList->mFinger;
+        index = pList->mFingerIndex;
+    }
+    for (; index < pIndex; ++index) traverse = DListNodeGetNext(traverse);
+    for (; index > pIndex; --index) traverse = DListNodeGetPrev(traverse);
+    pList->mFinger = traverse;
+    pList->mFingerIndex = pIndex;
+    return traverse;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListFree
+ * DESCR: Deallocates the linked list pList, its node array, and its value index if it has one. Returns NULL.
+ *        Does nothing and returns NULL if pList is NULL. If other lists share the node array, it is left to the
+ *        last of those lists to be freed.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListFree
+    (
+    DList *pList
+    )
+{
+    if (!pList) return NULL;
+    if (!pList->mShares || --*pList->mShares == 0) {
+        free(pList->mShares);
+        free(pList->mNodes);
+    }
+    pList->mValues = DListHashFree(pList->mValues);
+    free(pList);
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListGetHead
+ * DESCR: Accessor function for the pList->mHead data member. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DListNode *DListGetHead
+    (
+    DList *pList
+    )
+{
+    assert(pList);
+    return pList->mHead;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListGetIndex
+ * DESCR: Searches pList for a node containing data member set to pData. Returns the index if the node if it is
+ *        found, or -1 if pData is not in pList. Assertion error if pList is NULL. If pList keeps a value index,
+ *        a missing pData is detected in O(1) expected time.
+ *------------------------------------------------------------------------------------------------------------*/
+int DListGetIndex
+    (
+    DList *pList,
+    int    pData
+    )
+{
+    int index = 0;
+    DListNode *traverse;
+    assert(pList);
+    if (pList->mValues && !DListHashFind(pList->mValues, pData)) return -1;
+    for (traverse = DListGetHead(pList); traverse; traverse = DListNodeGetNext(traverse)) {
+        if (DListNodeGetData(traverse) == pData) return index;
+        index++;
+    }
+    return -1;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListGetSize
+ * DESCR: Accessor function for the pList->mSize data member. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+int DListGetSize
+    (
+    DList *pList
+    )
+{
+    assert(pList);
+    return pList->mSize;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListGetTail
+ * DESCR: Accessor function for the pList->tail data member. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DListNode *DListGetTail
+    (
+    DList *pList
+    )
+{
+    assert(pList);
+    return pList->mTail;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListGrow
+ * DESCR: Moves the node array of pList to a new array one half again as large (or allocates the first one) and
+ *        points pList at the new array. Returns false, leaving pList unchanged, if the new array cannot be
+ *        allocated or would have more than INT_MAX nodes.
+ *------------------------------------------------------------------------------------------------------------*/
+static bool DListGrow
+    (
+    DList *pList
+    )
+{
+    DListNode *old_nodes = pList->mNodes, *new_nodes;
+    int capacity = pList->mCapacity;
+    if (capacity > INT_MAX / 3 * 2) {
+        if (capacity == INT_MAX) return false;
+        capacity = INT_MAX;
+    } else {
+        capacity = capacity < DLIST_MIN_CAPACITY ? DLIST_MIN_CAPACITY : capacity + capacity / 2;
+    }
+    if ((size_t)capacity > (size_t)-1 / sizeof(DListNode)) return false;
+    if (!(new_nodes = (DListNode *)malloc(capacity * sizeof(DListNode)))) return false;
+    if (old_nodes) {
+        memcpy(new_nodes, old_nodes, pList->mUsed * sizeof(DListNode));
+        DListRebase(pList, old_nodes, new_nodes);
+        free(old_nodes);
+    }
+    pList->mNodes = new_nodes;
+    pList->mCapacity = capacity;
+    return true;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListIndexValues
+ * DESCR: Makes pList keep a value index, as in DList.c. Returns pList, or NULL if pList is NULL or the index
+ *        cannot be built. Does nothing if pList already keeps a value index.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListIndexValues
+    (
+    DList *pList
+    )
+{
+    DListHash *values;
+    DListNode *traverse;
+    if (!pList) return NULL;
+    if (pList->mValues) return pList;
+    if (!(values = DListHashAlloc())) return NULL;
+    for (traverse = DListGetHead(pList); traverse; traverse = DListNodeGetNext(traverse)) {
+        if (!DListHashAdd(values, DListNodeGetData(traverse), traverse)) {
+            DListHashFree(values);
+            return NULL;
+        }
+    }
+    pList->mValues = values;
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListInsertBefore
+ * DESCR: Inserts a new node containing data member set to mData into list pList before the first occurrence of
+ *        the node with data member set to pBefore. On success, returns the list pList. Fails if a node contain-
+ *        ing data member pBefore is not found and returns NULL. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListInsertBefore
+    (
+    DList *pList,
+    int    pBefore,
+    int    pData
+    )
+{
+    DListNode *before_node;
+    assert(pList);
+    before_node = DListFindData(pList, pBefore);
+    if (!before_node || !DListUnshare(pList, &before_node)) return NULL;
+    return DListInsertNode(pList, before_node, -1, pData);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListInsertIndex
+ * DESCR: Inserts a new node containing pData into the list pList at index pIndex. The nodes in the list are
+ *        numbered starting at 0. Fails and returns NULL if: (1) pList is empty; or (2) pIndex < 0; or (3)
+ *        pIndex >= pList->mSize. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListInsertIndex
+    (
+    DList *pList,
+    int    pIndex,
+    int    pData
+    )
+{
+    DListNode *index_node;
+    assert(pList);
+    if (DListIsEmpty(pList) || pIndex < 0 || pIndex >= DListGetSize(pList)) return NULL;
+    index_node = DListFindIndex(pList, pIndex);
+    if (!index_node || !DListUnshare(pList, &index_node)) return NULL;
+    return DListInsertNode(pList, index_node, pIndex, pData);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListInsertNode
+ * DESCR: Inserts a new node containing pData into the list pList before the node pIndexNode, whose index is
+ *        pIndex, or -1 if the caller does not know it. Returns pList, or NULL if a node cannot be allocated.
+ *        Getting the new node may move the node array, so pIndexNode is found again by its position in the
+ *        array afterwards. The finger is kept as in DList.c.
+ *------------------------------------------------------------------------------------------------------------*/
+static DList *DListInsertNode
+    (
+    DList     *pList,
+    DListNode *pIndexNode,
+    int        pIndex,
+    int        pData
+    )
+{
+    int index = pIndexNode - pList->mNodes;
+    DListNode *prev_index, *new_node;
+    if (!(new_node = DListNewNode(pList, pData))) return NULL;
+    pIndexNode = pList->mNodes + index;
+    prev_index = DListNodeGetPrev(pIndexNode);
+    DListNodeSetPrev(new_node, prev_index);
+    DListNodeSetNext(new_node, pIndexNode);
+    if (prev_index) {
+        DListNodeSetNext(prev_index, new_node);
+    } else {
+        DListSetHead(pList, new_node);
+    }
+    DListNodeSetPrev(pIndexNode, new_node);
+    DListSetSize(pList, DListGetSize(pList) + 1);
+    DListValueAdd(pList, new_node);
+    if (pIndex >= 0) {
+        pList->mFinger = new_node;
+        pList->mFingerIndex = pIndex;
+    } else if (pList->mFinger == pIndexNode) {
+        ++pList->mFingerIndex;
+    } else {
+        pList->mFinger = NULL;
+    }
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListIsEmpty
+ * DESCR: Returns true if the pList is empty, false otherwise. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+bool DListIsEmpty
+    (
+    DList *pList
+    )
+{
+    assert(pList);
+    return pList->mSize == 0;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListNewNode
+ * DESCR: Gets an unlinked node containing pData from the node array of pList: a node from the free list if
+ *        there is one, otherwise the first never-used node, growing the array if it is full. Returns NULL if
+ *        the array cannot grow. Note that growing moves every node of pList.
+ *------------------------------------------------------------------------------------------------------------*/
+static DListNode *DListNewNode
+    (
+    DList *pList,
+    int    pData
+    )
+{
+    DListNode *new_node = pList->mFree;
+    if (new_node) {
+        pList->mFree = DListNodeGetNext(new_node);
+    } else {
+        if (pList->mUsed == pList->mCapacity && !DListGrow(pList)) return NULL;
+        new_node = pList->mNodes + pList->mUsed++;
+    }
+    DListNodeSetData(new_node, pData);
+    DListNodeSetNext(new_node, NULL);
+    DListNodeSetPrev(new_node, NULL);
+    return new_node;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListRebase
+ * DESCR: Called when the nodes of pList have been copied from the array pOldNodes to the same places in the
+ *        array pNewNodes, while pOldNodes is still allocated. Makes pNewNodes the node array of pList and points
+ *        the head, the tail, the free list, the finger, and the value index at the same places in it. The links
+ *        between the nodes are relative, so they are already right.
+ *------------------------------------------------------------------------------------------------------------*/
+static void DListRebase
+    (
+    DList     *pList,
+    DListNode *pOldNodes,
+    DListNode *pNewNodes
+    )
+{
+    if (pList->mHead) DListSetHead(pList, pNewNodes + (pList->mHead - pOldNodes));
+    if (pList->mTail) DListSetTail(pList, pNewNodes + (pList->mTail - pOldNodes));
+    if (pList->mFree) pList->mFree = pNewNodes + (pList->mFree - pOldNodes);
+    if (pList->mFinger) pList->mFinger = pNewNodes + (pList->mFinger - pOldNodes);
+    if (pList->mValues) DListHashRebase(pList->mValues, pOldNodes, pNewNodes);
+    pList->mNodes = pNewNodes;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListRemoveData
+ * DESCR: Finds and removes the first occurrence of a node containing data member set to pData in pList. On
+ *        success returns the list pList. Fails if a node containing data member set to pData is not found and
+ *        returns NULL. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListRemoveData
+    (
+    DList *pList,
+    int    pData
+    )
+{
+    DListNode *data_node;
+    assert(pList);
+    data_node = DListFindData(pList, pData);
+    if (!data_node || !DListUnshare(pList, &data_node)) return NULL;
+    return DListRemoveNode(pList, data_node, -1);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListRemoveIndex
+ * DESCR: Finds and removes the node at index pIndex in list pList. On success, returns the list pList. Fails
+ *        if pIndex < 0 or pIndex >= pList->mSize and returns NULL. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListRemoveIndex
+    (
+    DList *pList,
+    int    pIndex
+    )
+{
+    DListNode *index_node;
+    assert(pList);
+    index_node = DListFindIndex(pList, pIndex);
+    if (!index_node || !DListUnshare(pList, &index_node)) return NULL;
+    return DListRemoveNode(pList, index_node, pIndex);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListRemoveNode
+ * DESCR: Removes the node pNode, whose index is pIndex, or -1 if the caller does not know it, from the list
+ *        pList and puts it on the free list. Returns the list pList on success. Fails if pNode is NULL and
+ *        returns NULL. The finger is kept as in DList.c.
+ *------------------------------------------------------------------------------------------------------------*/
+static DList *DListRemoveNode
+    (
+    DList     *pList,
+    DListNode *pNode,
+    int        pIndex
+    )
+{
+    DListNode *node_prev, *node_next;
+    if (!pNode) return NULL;
+    if (pList->mValues) DListHashRemove(pList->mValues, DListNodeGetData(pNode), pNode);
+    node_prev = DListNodeGetPrev(pNode);
+    node_next = DListNodeGetNext(pNode);
+    if (node_prev) {
+        DListNodeSetNext(node_prev, node_next);
+    } else {
+        DListSetHead(pList, node_next);
+    }
+    if (node_next) {
+        DListNodeSetPrev(node_next, node_prev);
+    } else {
+        DListSetTail(pList, node_prev);
+    }
+    if (pIndex < 0 && pList->mFinger == pNode) pIndex = pList->mFingerIndex;
+    if (pIndex >= 0) {
+        pList->mFinger = node_next ? node_next : node_prev;
+        pList->mFingerIndex = node_next ? pIndex : pIndex - 1;
+    } else {
+        pList->mFinger = NULL;
+    }
+    DListNodeSetNext(pNode, pList->mFree);
+    pList->mFree = pNode;
+    DListSetSize(pList, DListGetSize(pList) - 1);
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListSetHead
+ * DESCR: Mutator function for the pList->mHead data member. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListSetHead
+    (
+    DList     *pList,
+    DListNode *pHead
+    )
+{
+    assert(pList);
+    pList->mHead = pHead;
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListSetSize
+ * DESCR: Mutator function for the pList->mSize data member. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListSetSize
+    (
+    DList *pList,
+    int    pSize
+    )
+{
+    assert(pList);
+    pList->mSize = pSize;
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListSetTail
+ * DESCR: Mutator function for the pList->mTail data member. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListSetTail
+    (
+    DList     *pList,
+    DListNode *pTail
+    )
+{
+    assert(pList);
+    pList->mTail = pTail;
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListSort
+ * DESCR: Sorts the elements of pList into ascending order with a bottom-up merge sort of the nodes. The nodes
+ *        are relinked where they are in the node array, so nothing is allocated unless pList shares the array
+ *        (see DListCopy()). Equal elements keep their order. O(n log n). Returns pList, or NULL if the shared
+ *        array cannot be copied. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListSort
+    (
+    DList *pList
+    )
+{
+    DListNode *list, *p, *q, *node, *tail;
+    int run, merges, p_size, q_size;
+    assert(pList);
+    if (DListGetSize(pList) < 2) return pList;
+    if (!DListUnshare(pList, NULL)) return NULL;
+    list = DListGetHead(pList);
+    for (run = 1; ; run *= 2) {
+        p = list;
+        list = tail = NULL;
+        for (merges = 0; p; ++merges) {
+            q = p;
+            for (p_size = 0; p_size < run && q; ++p_size) q = DListNodeGetNext(q);
+            q_size = run;
+            while (p_size > 0 || (q_size > 0 && q)) {
+                if (p_size > 0 && (q_size == 0 || !q || DListNodeGetData(p) <= DListNodeGetData(q))) {
+                    node = p;
+                    p = DListNodeGetNext(p);
+                    --p_size;
+                } else {
+                    node = q;
+                    q = DListNodeGetNext(q);
+                    --q_size;
+                }
+                if (tail) {
+                    DListNodeSetNext(tail, node);
+                } else {
+                    list = node;
+                }
+                DListNodeSetPrev(node, tail);
+                tail = node;
+            }
+            p = q;
+        }
+        DListNodeSetNext(tail, NULL);
+        if (merges <= 1) break;
+    }
+    DListSetHead(pList, list);
+    DListSetTail(pList, tail);
+    pList->mFinger = NULL;
+    if (pList->mValues) {
+        pList->mValues = DListHashFree(pList->mValues);
+        DListIndexValues(pList);
+    }
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListSortParallel
+ * DESCR: Sorts the elements of pList into ascending order: the elements are copied into an array, where
+ *        SortParallelInt() radix sorts one run of them on each of up to pThreads threads (one per processor if
+ *        pThreads is less than 1) and then merges the runs, and they are stored back into the nodes in order. The
+ *        nodes stay where they are. The result is the same for any number of threads. Takes two temporary arrays of
+ *        n ints. Returns pList, or NULL if memory cannot be allocated, in which case pList is unchanged. Assertion
+ *        error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListSortParallel
+    (
+    DList *pList,
+    int    pThreads
+    )
+{
+    DListNode *traverse;
+    int *values, i;
+    assert(pList);
+    if (DListGetSize(pList) < 2) return pList;
+    if (!DListUnshare(pList, NULL)) return NULL;
+    if (!(values = (int *)malloc(DListGetSize(pList) * sizeof(int)))) return NULL;
+    for (i = 0, traverse = DListGetHead(pList); traverse; traverse = DListNodeGetNext(traverse)) {
+        values[i++] = DListNodeGetData(traverse);
+    }
+    if (!SortParallelInt(values, (size_t)DListGetSize(pList), pThreads)) {
+        free(values);
+        return NULL;
+    }
+    for (i = 0, traverse = DListGetHead(pList); traverse; traverse = DListNodeGetNext(traverse)) {
+        DListNodeSetData(traverse, values[i++]);
+    }
+    free(values);
+    if (pList->mValues) {
+        pList->mValues = DListHashFree(pList->mValues);
+        DListIndexValues(pList);
+    }
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListSortRadix
+ * DESCR: Sorts the elements of pList into ascending order with DListSortParallel() on one thread, so the whole list
+ *        is a single run, radix sorted by SortRadixInt() in O(n) time, and there is nothing to merge. Faster than
+ *        DListSort() for large lists. Returns pList, or NULL if memory cannot be allocated, in which case pList is
+ *        unchanged. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListSortRadix
+    (
+    DList *pList
+    )
+{
+    return DListSortParallel(pList, 1);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListSplice
+ * DESCR: Moves the elements at indices pFrom through pTo - 1 of pSrc into pDst, before the element at index
+ *        pPos, or at the end if pPos is the size of pDst. Each list keeps its nodes in its own array, so unlike
+ *        DList.c the nodes cannot change hands; the elements are copied into new nodes of pDst instead, and the
+ *        old nodes go on the free list of pSrc. The node array of pDst is grown up front so the move cannot
+ *        fail halfway. Returns pDst, or NULL if pDst and pSrc are the same list, an index is out of range, or
+ *        memory cannot be allocated. Assertion error if pDst or pSrc is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListSplice
+    (
+    DList *pDst,
+    int    pPos,
+    DList *pSrc,
+    int    pFrom,
+    int    pTo
+    )
+{
+    DListNode *before = NULL, *node, *next;
+    int i;
+    assert(pDst && pSrc);
+    if (pDst == pSrc || pPos < 0 || pPos > DListGetSize(pDst)) return NULL;
+    if (pFrom < 0 || pFrom > pTo || pTo > DListGetSize(pSrc)) return NULL;
+    if (pFrom == pTo) return pDst;
+    if (!DListUnshare(pDst, NULL) || !DListUnshare(pSrc, NULL)) return NULL;
+    while (pDst->mCapacity - pDst->mUsed < pTo - pFrom) {
+        if (!DListGrow(pDst)) return NULL;
+    }
+    if (pPos < DListGetSize(pDst)) before = DListFindIndex(pDst, pPos);
+    node = DListFindIndex(pSrc, pFrom);
+    for (i = 0; i < pTo - pFrom; ++i) {
+        next = DListNodeGetNext(node);
+        if (before) {
+            DListInsertNode(pDst, before, pPos + i, DListNodeGetData(node));
+        } else {
+            DListAppend(pDst, DListNodeGetData(node));
+        }
+        DListRemoveNode(pSrc, node, pFrom);
+        node = next;
+    }
+    return pDst;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListUnshare
+ * DESCR: Called before pList is changed. If pList shares its node array with other lists (see DListCopy()),
+ *        gives it a copy of the array, so the change does not show in the other lists. If pNode is not NULL,
+ *        *pNode is a node of pList and is made to point to the copy of that node. If pList was the last list
+ *        sharing the array, it simply takes it over. Returns false, leaving pList unchanged, if memory cannot be
+ *        allocated.
+ *------------------------------------------------------------------------------------------------------------*/
+static bool DListUnshare
+    (
+    DList      *pList,
+    DListNode **pNode
+    )
+{
+    DListNode *old_nodes = pList->mNodes, *new_nodes;
+    if (!pList->mShares) return true;
+    if (*pList->mShares > 1) {
+        if (old_nodes) {
+            if (!(new_nodes = (DListNode *)malloc(pList->mCapacity * sizeof(DListNode)))) return false;
+            memcpy(new_nodes, old_nodes, pList->mUsed * sizeof(DListNode));
+            DListRebase(pList, old_nodes, new_nodes);
+            if (pNode) *pNode = new_nodes + (*pNode - old_nodes);
+        }
+        --*pList->mShares;
+    } else {
+        free(pList->mShares);
+    }
+    pList->mShares = NULL;
+    return true;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListValueAdd
+ * DESCR: Adds pNode, which has just been linked into pList, to the value index of pList if it keeps one. If the
+ *        index cannot grow, it is dropped and the list goes back to finding values by scanning.
+ *------------------------------------------------------------------------------------------------------------*/
+static void DListValueAdd
+    (
+    DList     *pList,
+    DListNode *pNode
+    )
+{
+    if (pList->mValues && !DListHashAdd(pList->mValues, DListNodeGetData(pNode), pNode)) {
+        pList->mValues = DListHashFree(pList->mValues);
+    }
+}
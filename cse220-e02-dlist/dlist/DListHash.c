@@ -0,0 +1,309 @@
+/***************************************************************************************************************
+ * FILE: DListHash.c
+ *
+ * DESCRIPTION
+ * The value index of a DList. It is a hash table mapping each value in the list to the number of times the
+ * value occurs and the first node holding it, so DListFindData() is O(1) expected instead of a scan of the
+ * list. The list functions call DListHashAdd() after they store a value in a node and DListHashRemove() before
+ * they take one out. A node normally holds one value, but in the unrolled layout (DListUnrolled.c) it holds
+ * several, and values move between neighboring nodes as nodes are split and merged; DListHashMove() is called
+ * for each value moved.
+ *
+ * Keeping mFirst right when a value occurs more than once needs a look at the list: when a node is added, it
+ * becomes the first only if it comes before the current first node, which DListHashPrecedes() decides by
+ * walking out from the new node in both directions; when the first node gives up its last copy of the value,
+ * the next node holding the value is found by walking forward from it. For lists of distinct values neither
+ * walk happens.
+ *
+ * The table uses open addressing with linear probing and backward-shift deletion, like the list database in
+ * ListMan.c.
+ *
+ * AUTHOR INFORMATION
+ * agent [AGT]
+ *
+ * Email: agent@local
+ *
+ * MODIFICATION HISTORY:
+ * -------------------------------------------------------------------------------------------------------------
+ * 17 Oct 2026 [AGT] Initial revision.
+ * 17 Oct 2026 [AGT] The value is passed to DListHashAdd() and DListHashRemove() rather than read from the node,
+ *                   so a node may hold several values. Added DListHashMove().
+ * 17 Oct 2026 [AGT] Added DListHashRebase() for the node array of LAYOUT=compact.
+ **************************************************************************************************************/
+#include <assert.h>     /* For assert() */
+#include <stdlib.h>     /* For calloc(), free(), malloc(), NULL */
+#include "DListHash.h"
+#include "DListNode.h"  /* For DListNodeCountData(), DListNodeGetNext(), DListNodeGetPrev() */
+
+/*==============================================================================================================
+ * Preprocessor macro definitions.
+ *============================================================================================================*/
+#define DLISTHASH_MIN_SLOTS 16  /* Number of slots in a new table. Always a power of two. */
+
+/*==============================================================================================================
+ * Static function declarations.
+ *============================================================================================================*/
+static unsigned DListHashHash
+    (
+    int pData
+    );
+
+static DListHashEntry *DListHashLookup
+    (
+    DListHash *pHash,
+    int        pData
+    );
+
+static bool DListHashPrecedes
+    (
+    DListNode *pNode,
+    DListNode *pOther
+    );
+
+static bool DListHashResize
+    (
+    DListHash *pHash,
+    int        pNumSlots
+    );
+
+/*==============================================================================================================
+ * Function definitions.
+ *============================================================================================================*/
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListHashAdd
+ * DESCR: Records that pData has just been stored in pNode, which is linked into the list. The table is doubled
+ *        when adding a value would make it more than three quarters full. Returns false if the table cannot
+ *        be grown, in which case the table is unchanged.
+ *------------------------------------------------------------------------------------------------------------*/
+bool DListHashAdd
+    (
+    DListHash *pHash,
+    int        pData,
+    DListNode *pNode
+    )
+{
+    DListHashEntry *entry;
+    if (4 * (pHash->mSize + 1) > 3 * pHash->mNumSlots && !DListHashResize(pHash, 2 * pHash->mNumSlots)) {
+        return false;
+    }
+    entry = DListHashLookup(pHash, pData);
+    if (entry->mCount == 0) {
+        entry->mData = pData;
+        entry->mFirst = pNode;
+        pHash->mSize++;
+    } else if (entry->mFirst != pNode && DListHashPrecedes(pNode, entry->mFirst)) {
+        entry->mFirst = pNode;
+    }
+    entry->mCount++;
+    return true;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListHashAlloc
+ * DESCR: Allocates an empty value index. Returns NULL if memory cannot be allocated.
+ *------------------------------------------------------------------------------------------------------------*/
+DListHash *DListHashAlloc
+    (
+    )
+{
+    DListHash *new_hash = (DListHash *)malloc(sizeof(DListHash));
+    if (!new_hash) return NULL;
+    new_hash->mSlots = NULL;
+    new_hash->mNumSlots = 0;
+    new_hash->mSize = 0;
+    if (!DListHashResize(new_hash, DLISTHASH_MIN_SLOTS)) {
+        free(new_hash);
+        return NULL;
+    }
+    return new_hash;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListHashFind
+ * DESCR: Returns the first node of the list holding pData, or NULL if no node holds pData.
+ *------------------------------------------------------------------------------------------------------------*/
+DListNode *DListHashFind
+    (
+    DListHash *pHash,
+    int        pData
+    )
+{
+    DListHashEntry *entry = DListHashLookup(pHash, pData);
+    return entry->mCount ? entry->mFirst : NULL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListHashFree
+ * DESCR: Deallocates the value index pHash. Returns NULL. Does nothing if pHash is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DListHash *DListHashFree
+    (
+    DListHash *pHash
+    )
+{
+    if (!pHash) return NULL;
+    free(pHash->mSlots);
+    free(pHash);
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListHashHash
+ * DESCR: Returns a hash of the value pData. Values are often consecutive, so they are spread over the table by
+ *        Fibonacci hashing (multiplying by 2^32 divided by the golden ratio).
+ *------------------------------------------------------------------------------------------------------------*/
+static unsigned DListHashHash
+    (
+    int pData
+    )
+{
+    unsigned long hash = ((unsigned long)(unsigned)pData * 2654435769UL) & 0xFFFFFFFFUL;
+    return (unsigned)(hash ^ (hash >> 16));
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListHashLookup
+ * DESCR: Returns a pointer to the slot holding the entry for pData, or if there is no such entry, to the empty
+ *        slot where it would be inserted.
+ *------------------------------------------------------------------------------------------------------------*/
+static DListHashEntry *DListHashLookup
+    (
+    DListHash *pHash,
+    int        pData
+    )
+{
+    unsigned mask = pHash->mNumSlots - 1;
+    unsigned slot = DListHashHash(pData) & mask;
+    while (pHash->mSlots[slot].mCount && pHash->mSlots[slot].mData != pData) slot = (slot + 1) & mask;
+    return &pHash->mSlots[slot];
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListHashMove
+ * DESCR: Records that one copy of pData has just been moved from pFrom to pTo, which must be neighbors in the
+ *        list. If pFrom was the first node holding pData, pTo becomes the first one when it comes before pFrom
+ *        or when pFrom no longer holds pData.
+ *------------------------------------------------------------------------------------------------------------*/
+void DListHashMove
+    (
+    DListHash *pHash,
+    int        pData,
+    DListNode *pFrom,
+    DListNode *pTo
+    )
+{
+    DListHashEntry *entry = DListHashLookup(pHash, pData);
+    assert(entry->mCount > 0);
+    if (entry->mFirst == pFrom && (DListNodeGetPrev(pFrom) == pTo || !DListNodeCountData(pFrom, pData))) {
+        entry->mFirst = pTo;
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListHashPrecedes
+ * DESCR: Returns true if pNode comes before pOther in their list. Walks outward from pNode in both directions
+ *        at once, so the cost is proportional to the distance to pOther or to the nearer end of the list,
+ *        whichever is smaller.
+ *------------------------------------------------------------------------------------------------------------*/
+static bool DListHashPrecedes
+    (
+    DListNode *pNode,
+    DListNode *pOther
+    )
+{
+    DListNode *back = DListNodeGetPrev(pNode);
+    DListNode *fwd = DListNodeGetNext(pNode);
+    for (;;) {
+        if (fwd == pOther || !back) return true;
+        if (back == pOther || !fwd) return false;
+        back = DListNodeGetPrev(back);
+        fwd = DListNodeGetNext(fwd);
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListHashRebase
+ * DESCR: Records that the nodes of the list, which all lived in the array starting at pOldNodes, have been
+ *        copied to the same positions in the array starting at pNewNodes. Must be called before the old array
+ *        is deallocated.
+ *------------------------------------------------------------------------------------------------------------*/
+void DListHashRebase
+    (
+    DListHash *pHash,
+    DListNode *pOldNodes,
+    DListNode *pNewNodes
+    )
+{
+    int i;
+    for (i = 0; i < pHash->mNumSlots; ++i) {
+        if (pHash->mSlots[i].mCount) pHash->mSlots[i].mFirst = pNewNodes + (pHash->mSlots[i].mFirst - pOldNodes);
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListHashRemove
+ * DESCR: Records that one copy of pData is about to be taken out of pNode, which is still linked into the list.
+ *        If it is the last copy in the list, the entry is removed and the entries that follow it in the same
+ *        probe run are shifted back (see ListManFreeList()). If pNode was the first node holding pData and is
+ *        giving up its only copy, the next node holding pData is found by walking forward from pNode.
+ *------------------------------------------------------------------------------------------------------------*/
+void DListHashRemove
+    (
+    DListHash *pHash,
+    int        pData,
+    DListNode *pNode
+    )
+{
+    unsigned mask = pHash->mNumSlots - 1;
+    DListHashEntry *entry = DListHashLookup(pHash, pData);
+    unsigned hole, next;
+    assert(entry->mCount > 0);
+    if (--entry->mCount > 0) {
+        if (entry->mFirst == pNode && DListNodeCountData(pNode, pData) == 1) {
+            do {
+                pNode = DListNodeGetNext(pNode);
+            } while (!DListNodeCountData(pNode, pData));
+            entry->mFirst = pNode;
+        }
+        return;
+    }
+    hole = entry - pHash->mSlots;
+    next = (hole + 1) & mask;
+    while (pHash->mSlots[next].mCount) {
+        /* The entry in 'next' may move into the hole only if its home slot is not in (hole, next]. */
+        unsigned home = DListHashHash(pHash->mSlots[next].mData) & mask;
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            pHash->mSlots[hole] = pHash->mSlots[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    pHash->mSlots[hole].mCount = 0;
+    pHash->mSize--;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListHashResize
+ * DESCR: Replaces the table with one of pNumSlots empty slots and reinserts every entry of the old table.
+ *        Returns false, leaving the old table in place, if the new table cannot be allocated.
+ *------------------------------------------------------------------------------------------------------------*/
+static bool DListHashResize
+    (
+    DListHash *pHash,
+    int        pNumSlots
+    )
+{
+    DListHashEntry *old_slots = pHash->mSlots;
+    int old_num_slots = pHash->mNumSlots;
+    int i;
+    DListHashEntry *new_slots = (DListHashEntry *)calloc(pNumSlots, sizeof(DListHashEntry));
+    if (!new_slots) return false;
+    pHash->mSlots = new_slots;
+    pHash->mNumSlots = pNumSlots;
+    for (i = 0; i < old_num_slots; i++) {
+        if (old_slots[i].mCount) *DListHashLookup(pHash, old_slots[i].mData) = old_slots[i];
+    }
+    free(old_slots);
+    return true;
+}
@@ -0,0 +1,88 @@
+/***************************************************************************************************************
+ * FILE: DListHash.h
+ *
+ * DESCRIPTION
+ * Declaration of the value index a DList can keep to find nodes by value in O(1) expected time. See the
+ * comments in DListHash.c for more information.
+ *
+ * AUTHOR INFORMATION
+ * agent [AGT]
+ *
+ * Email: agent@local
+ *
+ * MODIFICATION HISTORY:
+ * -------------------------------------------------------------------------------------------------------------
+ * 17 Oct 2026 [AGT] Initial revision.
+ * 17 Oct 2026 [AGT] The value is passed to DListHashAdd() and DListHashRemove() rather than read from the node,
+ *                   so a node may hold several values. Added DListHashMove().
+ * 17 Oct 2026 [AGT] Added DListHashRebase().
+ **************************************************************************************************************/
+#ifndef __DLISTHASH_H__
+#define __DLISTHASH_H__
+
+#include "DListNode.h"  /* For DListNode */
+#include "Types.h"      /* For bool */
+
+/*==============================================================================================================
+ * Typedefs.
+ *============================================================================================================*/
+typedef struct {
+    int        mData;   /* The value.                                                    */
+    int        mCount;  /* Number of times mData occurs in the list. 0 if slot is empty. */
+    DListNode *mFirst;  /* The first node holding mData in list order.                  */
+} DListHashEntry;
+
+typedef struct {
+    DListHashEntry *mSlots;     /* Open addressing table with linear probing. */
+    int             mNumSlots;  /* Size of mSlots, always a power of 2.       */
+    int             mSize;      /* Number of distinct values in the table.    */
+} DListHash;
+
+/*==============================================================================================================
+ * Global function declarations. See function comments in DListHash.c
+ *============================================================================================================*/
+extern bool DListHashAdd
+    (
+    DListHash *pHash,
+    int        pData,
+    DListNode *pNode
+    );
+
+extern DListHash *DListHashAlloc
+    (
+    );
+
+extern DListNode *DListHashFind
+    (
+    DListHash *pHash,
+    int        pData
+    );
+
+extern DListHash *DListHashFree
+    (
+    DListHash *pHash
+    );
+
+extern void DListHashMove
+    (
+    DListHash *pHash,
+    int        pData,
+    DListNode *pFrom,
+    DListNode *pTo
+    );
+
+extern void DListHashRebase
+    (
+    DListHash *pHash,
+    DListNode *pOldNodes,
+    DListNode *pNewNodes
+    );
+
+extern void DListHashRemove
+    (
+    DListHash *pHash,
+    int        pData,
+    DListNode *pNode
+    );
+
+#endif
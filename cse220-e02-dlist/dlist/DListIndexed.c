@@ -0,0 +1,986 @@
+/***************************************************************************************************************
+ * FILE: DListIndexed.c
+ *
+ * DESCRIPTION
+ * An implementation of the DList.h functions on an indexable skip list. It is built in place of DList.c by
+ * running "make LAYOUT=indexed", which also defines DLIST_INDEXED so DList.h adds the lane fields to DList.
+ *
+ * The nodes of the list are the same DListNode nodes, linked the same way, as in DList.c, so every function
+ * that walks the list through mHead/mNext or mTail/mPrev works unchanged. Above the nodes sit DLIST_MAX_LEVEL
+ * levels of lane nodes. Each list node is given a random height when it is linked in: with probability 3/4 it
+ * gets no lane nodes, with probability 3/16 one (on level 0), with probability 3/64 two (on levels 0 and 1),
+ * and so on. A lane node stores, in mWidth, how far its list node is from the list node of the previous lane
+ * node on the same level (the sentinel at the start of each level is at index -1). To find the node at index
+ * i, DListSeek() starts on the highest level and moves right while that does not pass i, then drops a level,
+ * and finally walks the few list nodes between the level 0 lane node it ended on and index i. This takes
+ * O(log n) expected time, and so do inserting and removing at an index, which only touch the lane node just
+ * before the index on each level.
+ *
+ * The last lane node of each level and its index are remembered, so DListAppend() links the new node's lane
+ * nodes (expected 1/3 of one) at the end of their levels without searching; appending is O(1) expected.
+ *
+ * Searching by value is a linear scan of the list nodes unless the list keeps a value index, which works the
+ * same way as in DList.c (see DListIndexValues()).
+ *
+ * AUTHOR INFORMATION
+ * agent [AGT]
+ *
+ * Email: agent@local
+ *
+ * MODIFICATION HISTORY:
+ * -------------------------------------------------------------------------------------------------------------
+ * 17 Oct 2026 [AGT] Initial revision.
+ * 17 Oct 2026 [AGT] Added the optional value index.
+ * 17 Oct 2026 [AGT] Added DListAppendN().
+ * 17 Oct 2026 [AGT] Added DListConcat() and DListSplice().
+ * 17 Oct 2026 [AGT] Added DListSort() and DListSortRadix().
+ * 17 Oct 2026 [AGT] Added DListSortParallel().
+ * 17 Oct 2026 [AGT] Each list has its own lane random number generator, so lists on different threads do not
+ *                   share any state.
+ * 17 Oct 2026 [AGT] The comments on DListSplice() and DListFree() give what merging the node arenas costs.
+ **************************************************************************************************************/
+#include <assert.h>     /* For assert() */
+#include <stdio.h>      /* For NULL */
+#include <stdlib.h>     /* For free(), malloc() */
+#include "DList.h"      /* For DList struct and function declarations */
+#include "DListHash.h"  /* For DListHashAdd(), DListHashAlloc(), DListHashFind(), DListHashFree(), etc. */
+#include "DListNode.h"  /* For DListNode struct and function declarations */
+#include "Out.h"        /* For Out, OutCommit(), OutItoa(), OutReserve(), OutStr() */
+#include "Pool.h"       /* For PoolAlloc(), PoolFree(), PoolGetBlock(), PoolMerge(), PoolPutBlock(), etc. */
+#include "Sort.h"       /* For SortParallelInt() */
+
+#ifndef DLIST_INDEXED
+#error DListIndexed.c must be compiled with -DDLIST_INDEXED (make LAYOUT=indexed)
+#endif
+
+/*==============================================================================================================
+ * Static function declarations.
+ *============================================================================================================*/
+static void DListLaneAppend
+    (
+    DList     *pList,
+    DListNode *pNode,
+    int        pIndex
+    );
+
+static int DListLaneHeight
+    (
+    DList *pList
+    );
+
+static void DListRelane
+    (
+    DList *pList
+    );
+
+static DListNode *DListSeek
+    (
+    DList      *pList,
+    int         pIndex,
+    DListLane **pUpdate,
+    int        *pUpdateIndex
+    );
+
+static void DListValueAdd
+    (
+    DList     *pList,
+    DListNode *pNode
+    );
+
+/*==============================================================================================================
+ * Function definitions.
+ *============================================================================================================*/
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListAlloc
+ * DESCR: Allocate a new linked list. Returns a pointer to the allocated list or NULL on failure.
+ * PCODE:
+ * Allocate the list, its node arena, and its lane arena. If any allocation fails, free the others, return null.
+ * Make each level empty: its sentinel has no next lane node, and the sentinel is also the last lane node.
+ * Link each sentinel down to the sentinel of the level below it.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListAlloc
+    (
+    )
+{
+    int level;
+    DList *new_list = (DList *)malloc(sizeof(DList));
+    if (!new_list) return NULL;
+    new_list->mArena = PoolAlloc(sizeof(DListNode));
+    new_list->mLaneArena = PoolAlloc(sizeof(DListLane));
+    if (!new_list->mArena || !new_list->mLaneArena) {
+        PoolFree(new_list->mArena);
+        PoolFree(new_list->mLaneArena);
+        free(new_list);
+        return NULL;
+    }
+    DListSetHead(new_list, NULL);
+    DListSetTail(new_list, NULL);
+    DListSetSize(new_list, 0);
+    new_list->mValues = NULL;
+    new_list->mLevels = 0;
+    new_list->mLaneRandom = DLIST_LANE_SEED;
+    for (level = 0; level < DLIST_MAX_LEVEL; ++level) {
+        new_list->mLaneHead[level].mNext = NULL;
+        new_list->mLaneHead[level].mDown = level > 0 ? &new_list->mLaneHead[level - 1] : NULL;
+        new_list->mLaneHead[level].mNode = NULL;
+        new_list->mLaneHead[level].mWidth = 0;
+        new_list->mLaneTail[level] = &new_list->mLaneHead[level];
+        new_list->mLaneTailIndex[level] = -1;
+    }
+    return new_list;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListAppend
+ * DESCR: Appends a new node containing data member set to pData to the list pList. Returns a pointer to pList
+ *        or NULL on failure, i.e., if pList is NULL or memory cannot be allocated.
+ * PCODE:
+ * Link a new node after the tail node, as in DList.c.
+ * For each level below the new node's height: link a new lane node after the last lane node of the level. Its
+ *     width is the new node's index minus the index of the old last lane node.  -- Hint: Call DListLaneAppend()
+ * If a lane node cannot be allocated, the new node simply gets a lower height.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListAppend
+    (
+    DList *pList,
+    int    pData
+    )
+{
+    DListNode *new_node;
+    int index;
+    if (!pList) return NULL;
+    new_node = DListNodeAllocFrom(pList->mArena, pData, DListGetTail(pList), NULL);
+    if (!new_node) return NULL;
+    if (DListIsEmpty(pList)) {
+        DListSetHead(pList, new_node);
+    } else {
+        DListNodeSetNext(DListGetTail(pList), new_node);
+    }
+    DListSetTail(pList, new_node);
+    index = DListGetSize(pList);
+    DListSetSize(pList, index + 1);
+    DListValueAdd(pList, new_node);
+    DListLaneAppend(pList, new_node, index);
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListAppendN
+ * DESCR: Appends the pCount elements of pData to the list pList. Each node gets its own random lane height, so
+ *        the elements are appended one at a time by DListAppend(). Returns a pointer to pList or NULL on
+ *        failure, in which case the elements appended before the failure stay in the list.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListAppendN
+    (
+    DList     *pList,
+    const int *pData,
+    size_t     pCount
+    )
+{
+    size_t i;
+    for (i = 0; i < pCount; ++i) {
+        if (!DListAppend(pList, pData[i])) return NULL;
+    }
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListConcat
+ * DESCR: Moves every element of pSrc to the end of pDst, leaving pSrc empty. See DListSplice(). Returns pDst, or
+ *        NULL if pDst and pSrc are the same list. Assertion error if pDst or pSrc is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListConcat
+    (
+    DList *pDst,
+    DList *pSrc
+    )
+{
+    assert(pDst && pSrc);
+    return DListSplice(pDst, DListGetSize(pDst), pSrc, 0, DListGetSize(pSrc));
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListCopy
+ * DESCR: Makes an identical copy of list pSrcList and returns a pointer to the new list. If pSrcList keeps a
+ *        value index, so does the copy. Returns NULL if memory cannot be allocated. Assertion error if pSrcList
+ *        is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListCopy
+    (
+    DList *pSrcList
+    )
+{
+    DList *copy_list;
+    DListNode *traverse;
+    assert(pSrcList);
+    if (!(copy_list = DListAlloc())) return NULL;
+    for (traverse = DListGetHead(pSrcList); traverse; traverse = DListNodeGetNext(traverse)) {
+        if (!DListAppend(copy_list, DListNodeGetData(traverse))) return DListFree(copy_list);
+    }
+    if (pSrcList->mValues) DListIndexValues(copy_list);
+    return copy_list;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListDebugPrint
+ * DESCR: Prints the contents of the list pList to pOut. Prints "List is NULL" if L is NULL. This is primarily a
+ *        testing and debugging function.
+ *------------------------------------------------------------------------------------------------------------*/
+void DListDebugPrint
+    (
+    Out   *pOut,
+    DList *pList
+    )
+{
+    DListNode *traverse;
+    char *pos;
+    if (!pList) {
+        OutStr(pOut, "List is NULL.\n");
+        return;
+    }
+    OutStr(pOut, "[ ");
+    for (traverse = DListGetHead(pList); traverse; traverse = DListNodeGetNext(traverse)) {
+        pos = OutItoa(OutReserve(pOut, OUT_INT_CHARS + 1), DListNodeGetData(traverse));
+        *pos++ = ' ';
+        OutCommit(pOut, pos);
+    }
+    OutStr(pOut, "]");
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListDebugPrintRev
+ * DESCR: Prints the contents of the list pList in reverse order to pOut. Prints "List is NULL" if L is NULL.
+ *        This is primarily a debugging function.
+ *------------------------------------------------------------------------------------------------------------*/
+void DListDebugPrintRev
+    (
+    Out   *pOut,
+    DList *pList
+    )
+{
+    DListNode *traverse;
+    char *pos;
+    if (!pList) {
+        OutStr(pOut, "List is NULL.\n");
+        return;
+    }
+    OutStr(pOut, "[ ");
+    for (traverse = DListGetTail(pList); traverse; traverse = DListNodeGetPrev(traverse)) {
+        pos = OutItoa(OutReserve(pOut, OUT_INT_CHARS + 1), DListNodeGetData(traverse));
+        *pos++ = ' ';
+        OutCommit(pOut, pos);
+    }
+    OutStr(pOut, "]");
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListFindData
+ * DESCR: Returns a pointer to the first node containing a data member matching pData. Returns NULL if pData is
+ *        not in pList. Assertion error if pList is NULL. O(1) expected if pList keeps a value index.
+ *------------------------------------------------------------------------------------------------------------*/
+DListNode *DListFindData
+    (
+    DList *pList,
+    int    pData
+    )
+{
+    DListNode *traverse;
+    assert(pList);
+    if (pList->mValues) return DListHashFind(pList->mValues, pData);
+    traverse = DListGetHead(pList);
+    while (traverse && DListNodeGetData(traverse) != pData) {
+        traverse = DListNodeGetNext(traverse);
+    }
+    return traverse;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListFindIndex
+ * DESCR: Returns a pointer the node in pList at index pIndex. Fails if pIndex < 0 or pIndex >= pList->mSize
+ *        and returns NULL. Assertion error if pList is NULL. O(log n) expected.
+ *------------------------------------------------------------------------------------------------------------*/
+DListNode *DListFindIndex
+    (
+    DList *pList,
+    int    pIndex
+    )
+{
+    assert(pList);
+    if (pIndex < 0 || pIndex >= DListGetSize(pList)) return NULL;
+    return DListSeek(pList, pIndex, NULL, NULL);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListFree
+ * DESCR: Deallocates the linked list pList, releasing the nodes and the lane nodes a slab at a time, and its
+ *        value index if it has one. If the node arena has been merged with that of a list which is still in
+ *        use (see DListSplice()), the nodes are given back to it one at a time instead, in O(n) time, and the
+ *        slabs stay allocated until the last list using the arena is freed. Returns NULL. Does nothing and
+ *        returns NULL if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListFree
+    (
+    DList *pList
+    )
+{
+    DListNode *traverse, *next;
+    if (!pList) return NULL;
+    if (PoolIsShared(pList->mArena)) {
+        for (traverse = DListGetHead(pList); traverse; traverse = next) {
+            next = DListNodeGetNext(traverse);
+            DListNodeFreeTo(pList->mArena, traverse);
+        }
+    }
+    pList->mArena = PoolFree(pList->mArena);
+    pList->mLaneArena = PoolFree(pList->mLaneArena);
+    pList->mValues = DListHashFree(pList->mValues);
+    free(pList);
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListGetHead
+ * DESCR: Accessor function for the pList->mHead data member. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DListNode *DListGetHead
+    (
+    DList *pList
+    )
+{
+    assert(pList);
+    return pList->mHead;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListGetIndex
+ * DESCR: Searches pList for a node containing data member set to pData. Returns the index if the node if it is
+ *        found, or -1 if pData is not in pList. Assertion error if pList is NULL. If pList keeps a value index,
+ *        a missing pData is detected in O(1) expected time.
+ *------------------------------------------------------------------------------------------------------------*/
+int DListGetIndex
+    (
+    DList *pList,
+    int    pData
+    )
+{
+    int index = 0;
+    DListNode *traverse;
+    assert(pList);
+    if (pList->mValues && !DListHashFind(pList->mValues, pData)) return -1;
+    for (traverse = DListGetHead(pList); traverse; traverse = DListNodeGetNext(traverse), ++index) {
+        if (DListNodeGetData(traverse) == pData) return index;
+    }
+    return -1;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListGetSize
+ * DESCR: Accessor function for the pList->mSize data member. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+int DListGetSize
+    (
+    DList *pList
+    )
+{
+    assert(pList);
+    return pList->mSize;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListGetTail
+ * DESCR: Accessor function for the pList->tail data member. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DListNode *DListGetTail
+    (
+    DList *pList
+    )
+{
+    assert(pList);
+    return pList->mTail;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListIndexValues
+ * DESCR: Makes pList keep a value index from now until the list is freed. See DListIndexValues() in DList.c.
+ *        Returns pList, or NULL if pList is NULL or the index cannot be built.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListIndexValues
+    (
+    DList *pList
+    )
+{
+    DListHash *values;
+    DListNode *traverse;
+    if (!pList) return NULL;
+    if (pList->mValues) return pList;
+    if (!(values = DListHashAlloc())) return NULL;
+    for (traverse = DListGetHead(pList); traverse; traverse = DListNodeGetNext(traverse)) {
+        if (!DListHashAdd(values, DListNodeGetData(traverse), traverse)) {
+            DListHashFree(values);
+            return NULL;
+        }
+    }
+    pList->mValues = values;
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListInsertBefore
+ * DESCR: Inserts a new node containing data member set to mData into list pList before the first occurrence of
+ *        the node with data member set to pBefore. On success, returns the list pList. Fails if a node contain-
+ *        ing data member pBefore is not found and returns NULL. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListInsertBefore
+    (
+    DList *pList,
+    int    pBefore,
+    int    pData
+    )
+{
+    int index;
+    assert(pList);
+    index = DListGetIndex(pList, pBefore);
+    if (index < 0) return NULL;
+    return DListInsertIndex(pList, index, pData);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListInsertIndex
+ * DESCR: Inserts a new node containing pData into the list pList at index pIndex. The nodes in the list are
+ *        numbered starting at 0. Fails and returns NULL if: (1) pList is empty; or (2) pIndex < 0; or (3)
+ *        pIndex >= pList->mSize; or (4) memory cannot be allocated. Note: if you want to insert a new node at
+ *        the end of the list then you should call the DListAppend() function. Assertion error if pList is NULL.
+ *        O(log n) expected.
+ * PCODE:
+ * Seek to index_node, the node at pIndex, remembering on each level the last lane node before pIndex.
+ * Link a new node in before index_node, as in DList.c.
+ * Every last lane node index at or after pIndex moves up by one.
+ * For each level below the new node's height: link a new lane node after the remembered lane node, and take
+ *     the new lane node's width out of the width of the lane node after it (plus one for the new node).
+ * For each level at or above the new node's height: the lane node after the remembered one, if there is one,
+ *     now skips one more node.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListInsertIndex
+    (
+    DList *pList,
+    int    pIndex,
+    int    pData
+    )
+{
+    DListLane *update[DLIST_MAX_LEVEL], *down = NULL;
+    int update_index[DLIST_MAX_LEVEL];
+    DListNode *index_node, *new_node;
+    int height, level;
+    assert(pList);
+    if (DListIsEmpty(pList) || pIndex < 0 || pIndex >= DListGetSize(pList)) return NULL;
+    index_node = DListSeek(pList, pIndex, update, update_index);
+    new_node = DListNodeAllocFrom(pList->mArena, pData, DListNodeGetPrev(index_node), index_node);
+    if (!new_node) return NULL;
+    if (DListNodeGetPrev(index_node)) {
+        DListNodeSetNext(DListNodeGetPrev(index_node), new_node);
+    } else {
+        DListSetHead(pList, new_node);
+    }
+    DListNodeSetPrev(index_node, new_node);
+    DListSetSize(pList, DListGetSize(pList) + 1);
+    DListValueAdd(pList, new_node);
+    for (level = 0; level < pList->mLevels; ++level) {
+        if (pList->mLaneTailIndex[level] >= pIndex) ++pList->mLaneTailIndex[level];
+    }
+    for (level = pList->mLevels; level < DLIST_MAX_LEVEL; ++level) {
+        update[level] = &pList->mLaneHead[level];
+        update_index[level] = -1;
+    }
+    height = DListLaneHeight(pList);
+    for (level = 0; level < height; ++level) {
+        DListLane *lane = (DListLane *)PoolGetBlock(pList->mLaneArena);
+        if (!lane) break;
+        lane->mNext = update[level]->mNext;
+        lane->mDown = down;
+        lane->mNode = new_node;
+        lane->mWidth = pIndex - update_index[level];
+        if (lane->mNext) {
+            lane->mNext->mWidth += 1 - lane->mWidth;
+        } else {
+            pList->mLaneTail[level] = lane;
+            pList->mLaneTailIndex[level] = pIndex;
+        }
+        update[level]->mNext = lane;
+        down = lane;
+    }
+    height = level;
+    for (level = height; level < pList->mLevels; ++level) {
+        if (update[level]->mNext) ++update[level]->mNext->mWidth;
+    }
+    if (height > pList->mLevels) pList->mLevels = height;
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListIsEmpty
+ * DESCR: Returns true if the pList is empty, false otherwise. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+bool DListIsEmpty
+    (
+    DList *pList
+    )
+{
+    assert(pList);
+    return pList->mSize == 0;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListLaneAppend
+ * DESCR: Gives pNode, the last node of pList at index pIndex, a random height and links its lane nodes after
+ *        the last lane node of each level below that height. If a lane node cannot be allocated, pNode simply
+ *        gets a lower height.
+ *------------------------------------------------------------------------------------------------------------*/
+static void DListLaneAppend
+    (
+    DList     *pList,
+    DListNode *pNode,
+    int        pIndex
+    )
+{
+    DListLane *lane, *down = NULL;
+    int height, level;
+    height = DListLaneHeight(pList);
+    for (level = 0; level < height; ++level) {
+        if (!(lane = (DListLane *)PoolGetBlock(pList->mLaneArena))) break;
+        lane->mNext = NULL;
+        lane->mDown = down;
+        lane->mNode = pNode;
+        lane->mWidth = pIndex - pList->mLaneTailIndex[level];
+        pList->mLaneTail[level]->mNext = lane;
+        pList->mLaneTail[level] = lane;
+        pList->mLaneTailIndex[level] = pIndex;
+        down = lane;
+    }
+    if (level > pList->mLevels) pList->mLevels = level;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListLaneHeight
+ * DESCR: Returns the number of lane nodes to give a new list node: 0 with probability 3/4, 1 with probability
+ *        3/16, ..., k with probability 3/4^(k+1), and never more than DLIST_MAX_LEVEL. Each pair of bits of
+ *        one xorshift random number, drawn from the generator of pList, decides one level.
+ *------------------------------------------------------------------------------------------------------------*/
+static int DListLaneHeight
+    (
+    DList *pList
+    )
+{
+    unsigned long bits;
+    int height = 0;
+    pList->mLaneRandom ^= (pList->mLaneRandom << 13) & 0xFFFFFFFFUL;
+    pList->mLaneRandom ^= pList->mLaneRandom >> 17;
+    pList->mLaneRandom ^= (pList->mLaneRandom << 5) & 0xFFFFFFFFUL;
+    for (bits = pList->mLaneRandom; height < DLIST_MAX_LEVEL && (bits & 3) == 0; bits >>= 2) ++height;
+    return height;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListRelane
+ * DESCR: Gives every lane node of pList back to the lane arena and builds the lanes again from the list nodes,
+ *        as if each had been appended in turn. Called when whole runs of nodes have been moved between lists,
+ *        after which the old widths mean nothing. O(n) expected.
+ *------------------------------------------------------------------------------------------------------------*/
+static void DListRelane
+    (
+    DList *pList
+    )
+{
+    DListLane *lane, *next;
+    DListNode *traverse;
+    int level, index = 0;
+    for (level = 0; level < DLIST_MAX_LEVEL; ++level) {
+        for (lane = pList->mLaneHead[level].mNext; lane; lane = next) {
+            next = lane->mNext;
+            PoolPutBlock(pList->mLaneArena, lane);
+        }
+        pList->mLaneHead[level].mNext = NULL;
+        pList->mLaneTail[level] = &pList->mLaneHead[level];
+        pList->mLaneTailIndex[level] = -1;
+    }
+    pList->mLevels = 0;
+    for (traverse = DListGetHead(pList); traverse; traverse = DListNodeGetNext(traverse)) {
+        DListLaneAppend(pList, traverse, index++);
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListRemoveData
+ * DESCR: Finds and removes the first occurrence of a node containing data member set to pData in pList. On
+ *        success returns the list pList. Fails if a node containing data member set to pData is not found and
+ *        returns NULL. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListRemoveData
+    (
+    DList *pList,
+    int    pData
+    )
+{
+    assert(pList);
+    return DListRemoveIndex(pList, DListGetIndex(pList, pData));
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListRemoveIndex
+ * DESCR: Finds and removes the node at index pIndex in list pList. On success, returns the list pList. Fails
+ *        if pIndex < 0 or pIndex >= pList->mSize and returns NULL. Assertion error if pList is NULL. O(log n)
+ *        expected.
+ * PCODE:
+ * Seek to index_node, the node at pIndex, remembering on each level the last lane node before pIndex.
+ * Remove index_node from the value index of pList, if it has one.
+ * For each level in use:
+ *     If the lane node after the remembered one stands for index_node Then
+ *         Unlink it and add its width, less the removed node, to the lane node after it
+ *         If it was the last lane node of the level, the remembered lane node is now the last one
+ *         Give it back to the lane arena
+ *     Else the lane node after the remembered one, if there is one, skips one less node
+ *     If the last lane node of the level is after pIndex, its index moves down by one
+ * Drop empty levels from the top.
+ * Unlink index_node from the list, as in DList.c, and give it back to the arena.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListRemoveIndex
+    (
+    DList *pList,
+    int    pIndex
+    )
+{
+    DListLane *update[DLIST_MAX_LEVEL];
+    int update_index[DLIST_MAX_LEVEL];
+    DListNode *index_node;
+    int level;
+    assert(pList);
+    if (pIndex < 0 || pIndex >= DListGetSize(pList)) return NULL;
+    index_node = DListSeek(pList, pIndex, update, update_index);
+    if (pList->mValues) DListHashRemove(pList->mValues, DListNodeGetData(index_node), index_node);
+    for (level = 0; level < pList->mLevels; ++level) {
+        DListLane *lane = update[level]->mNext;
+        if (lane && lane->mNode == index_node) {
+            update[level]->mNext = lane->mNext;
+            if (lane->mNext) lane->mNext->mWidth += lane->mWidth - 1;
+            if (pList->mLaneTail[level] == lane) {
+                pList->mLaneTail[level] = update[level];
+                pList->mLaneTailIndex[level] = update_index[level];
+            }
+            PoolPutBlock(pList->mLaneArena, lane);
+        } else if (lane) {
+            --lane->mWidth;
+        }
+        if (pList->mLaneTailIndex[level] > pIndex) --pList->mLaneTailIndex[level];
+    }
+    while (pList->mLevels > 0 && !pList->mLaneHead[pList->mLevels - 1].mNext) --pList->mLevels;
+    if (DListNodeGetPrev(index_node)) {
+        DListNodeSetNext(DListNodeGetPrev(index_node), DListNodeGetNext(index_node));
+    } else {
+        DListSetHead(pList, DListNodeGetNext(index_node));
+    }
+    if (DListNodeGetNext(index_node)) {
+        DListNodeSetPrev(DListNodeGetNext(index_node), DListNodeGetPrev(index_node));
+    } else {
+        DListSetTail(pList, DListNodeGetPrev(index_node));
+    }
+    DListNodeFreeTo(pList->mArena, index_node);
+    DListSetSize(pList, DListGetSize(pList) - 1);
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListSeek
+ * DESCR: Returns the node at index pIndex of pList, which must be in range. If pUpdate is not NULL, stores in
+ *        pUpdate[level] the last lane node on each level in use that stands for a node before pIndex (or the
+ *        level's sentinel), and its index in pUpdateIndex[level].
+ * PCODE:
+ * Start at index -1 on the sentinel of the highest level in use.
+ * On each level, from the highest down:
+ *     Move right while the next lane node stands for a node before pIndex, adding up the widths
+ *     Remember where the level was left, then go down to the lane node below
+ * Walk the list nodes from the node the level 0 lane node stands for (or the head) up to pIndex.
+ *------------------------------------------------------------------------------------------------------------*/
+static DListNode *DListSeek
+    (
+    DList      *pList,
+    int         pIndex,
+    DListLane **pUpdate,
+    int        *pUpdateIndex
+    )
+{
+    DListLane *lane = NULL;
+    DListNode *traverse;
+    int index = -1, level;
+    for (level = pList->mLevels - 1; level >= 0; --level) {
+        lane = lane ? lane->mDown : &pList->mLaneHead[level];
+        while (lane->mNext && index + lane->mNext->mWidth < pIndex) {
+            index += lane->mNext->mWidth;
+            lane = lane->mNext;
+        }
+        if (pUpdate) {
+            pUpdate[level] = lane;
+            pUpdateIndex[level] = index;
+        }
+    }
+    if (index < 0) {
+        traverse = DListGetHead(pList);
+        index = 0;
+    } else {
+        traverse = lane->mNode;
+    }
+    for (; index < pIndex; ++index) traverse = DListNodeGetNext(traverse);
+    return traverse;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListSetHead
+ * DESCR: Mutator function for the pList->mHead data member. Assertion error if pList is NULL. The lanes are
+ *        not updated, so this is only for use by the list functions themselves.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListSetHead
+    (
+    DList     *pList,
+    DListNode *pHead
+    )
+{
+    assert(pList);
+    pList->mHead = pHead;
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListSetSize
+ * DESCR: Mutator function for the pList->mSize data member. Assertion error if pList is NULL. The lanes are
+ *        not updated, so this is only for use by the list functions themselves.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListSetSize
+    (
+    DList *pList,
+    int    pSize
+    )
+{
+    assert(pList);
+    pList->mSize = pSize;
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListSetTail
+ * DESCR: Mutator function for the pList->mTail data member. Assertion error if pList is NULL. The lanes are
+ *        not updated, so this is only for use by the list functions themselves.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListSetTail
+    (
+    DList     *pList,
+    DListNode *pTail
+    )
+{
+    assert(pList);
+    pList->mTail = pTail;
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListSort
+ * DESCR: Sorts the elements of pList into ascending order with a bottom-up merge sort of the nodes. The nodes
+ *        are relinked in place, and the lanes are then built again from them (see DListRelane()). Equal
+ *        elements keep their order. O(n log n). Returns pList. Assertion error if pList is NULL.
+ * PCODE:
+ * For run length 1, 2, 4, ... until a pass merges no more than one pair of runs:
+ *     Walk the list merging each run of that many nodes with the run after it, relinking the nodes in order
+ *     (both the next and prev links) onto the end of the new list
+ * Set the head and the tail of pList to the first and last node of the new list
+ * Build the lanes again  -- Hint: Call DListRelane()
+ * Rebuild the value index of pList if it has one
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListSort
+    (
+    DList *pList
+    )
+{
+    DListNode *list, *p, *q, *node, *tail;
+    int run, merges, p_size, q_size;
+    assert(pList);
+    if (DListGetSize(pList) < 2) return pList;
+    list = DListGetHead(pList);
+    for (run = 1; ; run *= 2) {
+        p = list;
+        list = tail = NULL;
+        for (merges = 0; p; ++merges) {
+            q = p;
+            for (p_size = 0; p_size < run && q; ++p_size) q = DListNodeGetNext(q);
+            q_size = run;
+            while (p_size > 0 || (q_size > 0 && q)) {
+                if (p_size > 0 && (q_size == 0 || !q || DListNodeGetData(p) <= DListNodeGetData(q))) {
+                    node = p;
+                    p = DListNodeGetNext(p);
+                    --p_size;
+                } else {
+                    node = q;
+                    q = DListNodeGetNext(q);
+                    --q_size;
+                }
+                if (tail) {
+                    DListNodeSetNext(tail, node);
+                } else {
+                    list = node;
+                }
+                DListNodeSetPrev(node, tail);
+                tail = node;
+            }
+            p = q;
+        }
+        DListNodeSetNext(tail, NULL);
+        if (merges <= 1) break;
+    }
+    DListSetHead(pList, list);
+    DListSetTail(pList, tail);
+    DListRelane(pList);
+    if (pList->mValues) {
+        pList->mValues = DListHashFree(pList->mValues);
+        DListIndexValues(pList);
+    }
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListSortParallel
+ * DESCR: Sorts the elements of pList into ascending order: the elements are copied into an array, where
+ *        SortParallelInt() radix sorts one run of them on each of up to pThreads threads (one per processor if
+ *        pThreads is less than 1) and then merges the runs, and they are stored back into the nodes in order. The
+ *        nodes stay where they are, so the lanes are still right. The result is the same for any number of threads.
+ *        Takes two temporary arrays of n ints. Returns pList, or NULL if memory cannot be allocated, in which case
+ *        pList is unchanged. Assertion error if pList is NULL.
+ * PCODE:
+ * Copy the elements of pList, from head to tail, into a new array
+ * Sort the array  -- Hint: Call SortParallelInt()
+ * Store the elements of the array, in order, into the nodes of pList from head to tail
+ * Rebuild the value index of pList if it has one
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListSortParallel
+    (
+    DList *pList,
+    int    pThreads
+    )
+{
+    DListNode *traverse;
+    int *values, i;
+    assert(pList);
+    if (DListGetSize(pList) < 2) return pList;
+    if (!(values = (int *)malloc(DListGetSize(pList) * sizeof(int)))) return NULL;
+    for (i = 0, traverse = DListGetHead(pList); traverse; traverse = DListNodeGetNext(traverse)) {
+        values[i++] = DListNodeGetData(traverse);
+    }
+    if (!SortParallelInt(values, (size_t)DListGetSize(pList), pThreads)) {
+        free(values);
+        return NULL;
+    }
+    for (i = 0, traverse = DListGetHead(pList); traverse; traverse = DListNodeGetNext(traverse)) {
+        DListNodeSetData(traverse, values[i++]);
+    }
+    free(values);
+    if (pList->mValues) {
+        pList->mValues = DListHashFree(pList->mValues);
+        DListIndexValues(pList);
+    }
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListSortRadix
+ * DESCR: Sorts the elements of pList into ascending order with DListSortParallel() on one thread, so the whole list
+ *        is a single run, radix sorted by SortRadixInt() in O(n) time, and there is nothing to merge. Faster than
+ *        DListSort() for large lists. Returns pList, or NULL if memory cannot be allocated, in which case pList is
+ *        unchanged. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListSortRadix
+    (
+    DList *pList
+    )
+{
+    return DListSortParallel(pList, 1);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListSplice
+ * DESCR: Moves the elements at indices pFrom through pTo - 1 of pSrc into pDst, before the element at index
+ *        pPos, or at the end if pPos is the size of pDst. The list nodes are relinked rather than copied, and
+ *        the node arenas of the two lists are merged as in DList.c, with the same cost to DListFree(), but the
+ *        widths of every lane node after the moved run change, so the lanes of both lists are built again; the
+ *        move takes O(n) expected time.
+ *        Returns pDst, or NULL if pDst and pSrc are the same list or an index is out of range. Assertion error
+ *        if pDst or pSrc is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListSplice
+    (
+    DList *pDst,
+    int    pPos,
+    DList *pSrc,
+    int    pFrom,
+    int    pTo
+    )
+{
+    DListNode *first, *last, *before = NULL, *src_prev, *src_next, *dst_prev;
+    assert(pDst && pSrc);
+    if (pDst == pSrc || pPos < 0 || pPos > DListGetSize(pDst)) return NULL;
+    if (pFrom < 0 || pFrom > pTo || pTo > DListGetSize(pSrc)) return NULL;
+    if (pFrom == pTo) return pDst;
+    first = DListSeek(pSrc, pFrom, NULL, NULL);
+    last = DListSeek(pSrc, pTo - 1, NULL, NULL);
+    if (pPos < DListGetSize(pDst)) before = DListSeek(pDst, pPos, NULL, NULL);
+    src_prev = DListNodeGetPrev(first);
+    src_next = DListNodeGetNext(last);
+    if (src_prev) {
+        DListNodeSetNext(src_prev, src_next);
+    } else {
+        DListSetHead(pSrc, src_next);
+    }
+    if (src_next) {
+        DListNodeSetPrev(src_next, src_prev);
+    } else {
+        DListSetTail(pSrc, src_prev);
+    }
+    dst_prev = before ? DListNodeGetPrev(before) : DListGetTail(pDst);
+    DListNodeSetPrev(first, dst_prev);
+    DListNodeSetNext(last, before);
+    if (dst_prev) {
+        DListNodeSetNext(dst_prev, first);
+    } else {
+        DListSetHead(pDst, first);
+    }
+    if (before) {
+        DListNodeSetPrev(before, last);
+    } else {
+        DListSetTail(pDst, last);
+    }
+    DListSetSize(pSrc, DListGetSize(pSrc) - (pTo - pFrom));
+    DListSetSize(pDst, DListGetSize(pDst) + (pTo - pFrom));
+    PoolMerge(pDst->mArena, pSrc->mArena);
+    DListRelane(pDst);
+    DListRelane(pSrc);
+    if (pDst->mValues) {
+        pDst->mValues = DListHashFree(pDst->mValues);
+        DListIndexValues(pDst);
+    }
+    if (pSrc->mValues) {
+        pSrc->mValues = DListHashFree(pSrc->mValues);
+        DListIndexValues(pSrc);
+    }
+    return pDst;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListValueAdd
+ * DESCR: Adds pNode, which has just been linked into pList, to the value index of pList if it keeps one. If the
+ *        index cannot grow, it is dropped and the list goes back to finding values by scanning.
+ *------------------------------------------------------------------------------------------------------------*/
+static void DListValueAdd
+    (
+    DList     *pList,
+    DListNode *pNode
+    )
+{
+    if (pList->mValues && !DListHashAdd(pList->mValues, DListNodeGetData(pNode), pNode)) {
+        pList->mValues = DListHashFree(pList->mValues);
+    }
+}
@@ -19,41 +19,78 @@
  * MODIFICATION HISTORY:
  * -------------------------------------------------------------------------------------------------------------
  * 10 Mar 2012 [KRB] Initial revision.
+ * 17 Oct 2026 [AGT] Nodes are allocated from a slab pool rather than one malloc() per node.
+ * 17 Oct 2026 [AGT] Added DListNodeAllocFrom() and DListNodeFreeTo() for lists that own an arena.
+ * 17 Oct 2026 [AGT] Support the unrolled node of LAYOUT=unrolled. Added DListNodeCountData().
+ * 17 Oct 2026 [AGT] Support the relative links of the compact node of LAYOUT=compact.
+ * 17 Oct 2026 [AGT] Removed the process-wide node pool along with DListNodeAlloc() and DListNodeFree(). Every
+ *                   node comes from the arena of its list.
  **************************************************************************************************************/
 /*#define NDEBUG*/      /* Comment out to enable assertions or put -DNDEBUG in CFLAGS of the Makefile */
 #include <assert.h>     /* For assert() */
 #include <stdio.h>      /* For FILE, fprintf() */
-#include <stdlib.h>     /* For free(), malloc(), NULL */
+#include <stdlib.h>     /* For NULL */
 #include "DListNode.h"
+#include "Pool.h"       /* For Pool, PoolGetBlock(), PoolPutBlock() */
 
 /*==============================================================================================================
  * Function definitions.
  *============================================================================================================*/
 
 /*--------------------------------------------------------------------------------------------------------------
- * Allocates a new node with mData member set to pData and mNext pointer set to pNext. Returns a pointer to the
- * new node, or NULL if malloc() fails.
+ * Allocates a new node out of pArena, the arena of the list it will belong to, with mData member set to pData,
+ * mPrev pointer set to pPrev, and mNext pointer set to pNext. An unrolled node is allocated holding the one
+ * element pData. Returns a pointer to the new node, or NULL if the arena cannot be grown. The node must be
+ * freed with DListNodeFreeTo() passing the same arena. Assertion error if pArena is NULL.
  *------------------------------------------------------------------------------------------------------------*/
-DListNode *DListNodeAlloc
+DListNode *DListNodeAllocFrom
     (
+    Pool      *pArena,
     int        pData,
-    DListNode *pPrev,                /* Add pPrev pointer */
+    DListNode *pPrev,
     DListNode *pNext
     )
 {
-    DListNode *new_node = (DListNode*)malloc(sizeof(DListNode));
+    DListNode *new_node;
+    assert(pArena);
+    new_node = (DListNode *)PoolGetBlock(pArena);
     if (new_node) {
+#ifdef DLIST_UNROLLED
+        new_node->mCount = 1;
+#endif
         DListNodeSetData(new_node, pData);
-        DListNodeSetData(pPrev), DListNodeGetData(mPrev));  /* Set the mPrev data member to pPrev */
+        DListNodeSetPrev(new_node, pPrev);
         DListNodeSetNext(new_node, pNext);
     }
     return new_node;
 }
 
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListNodeCountData
+ * DESCR: Returns the number of elements of pNode equal to pData. For a plain node that is 1 or 0. Assertion
+ *        error if pNode is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+int DListNodeCountData
+    (
+    DListNode *pNode,
+    int        pData
+    )
+{
+#ifdef DLIST_UNROLLED
+    int count = 0, i;
+    assert(pNode);
+    for (i = 0; i < pNode->mCount; ++i) count += pNode->mData[i] == pData;
+    return count;
+#else
+    assert(pNode);
+    return pNode->mData == pData;
+#endif
+}
+
 /*--------------------------------------------------------------------------------------------------------------
  * FUNCT: DListNodeDebugPrint
- * DESCR: Prints the data member stored at pNode. This is primarily intended to be a debugging function.
- *        Assertion error if pNode is NULL.
+ * DESCR: Prints the data member stored at pNode, or for an unrolled node all of its elements separated by
+ *        spaces. This is primarily intended to be a debugging function. Assertion error if pNode is NULL.
  *------------------------------------------------------------------------------------------------------------*/
 void DListNodeDebugPrint
     (
@@ -61,19 +98,28 @@ void DListNodeDebugPrint
     DListNode *pNode
     )
 {
+#ifdef DLIST_UNROLLED
+    int i;
+    assert(pNode);
+    for (i = 0; i < pNode->mCount; ++i) fprintf(pStream, i ? " %d" : "%d", pNode->mData[i]);
+#else
     assert(pNode);
     fprintf(pStream, "%d", DListNodeGetData(pNode));
+#endif
 }
 
 /*--------------------------------------------------------------------------------------------------------------
- * Deallocates a node that was allocated by calling DListNodeAlloc().
+ * Deallocates a node that was allocated by calling DListNodeAllocFrom() on pArena. The node is handed back to
+ * pArena, which will reuse it for the next node that is allocated. Assertion error if pArena is NULL.
  *------------------------------------------------------------------------------------------------------------*/
-DListNode *DListNodeFree
+DListNode *DListNodeFreeTo
     (
+    Pool      *pArena,
     DListNode *pNode
     )
 {
-    free(pNode);
+    assert(pArena);
+    if (pNode) PoolPutBlock(pArena, pNode);
     return NULL;
 }
 
@@ -86,7 +132,11 @@ int DListNodeGetData
     )
 {
     assert(pNode);
+#ifdef DLIST_UNROLLED
+    return pNode->mData[0];
+#else
     return pNode->mData;
+#endif
 }
 
 /*--------------------------------------------------------------------------------------------------------------
@@ -98,7 +148,11 @@ DListNode *DListNodeGetNext
     )
 {
     assert(pNode);
+#ifdef DLIST_COMPACT
+    return pNode->mNext ? pNode + pNode->mNext : NULL;
+#else
     return pNode->mNext;
+#endif
 }
 
 /*--------------------------------------------------------------------------------------------------------------
@@ -107,7 +161,11 @@ DListNode *DListNodeGetNext
 DListNode *DListNodeGetPrev (DListNode *pNode)
 {
     assert(pNode);
+#ifdef DLIST_COMPACT
+    return pNode->mPrev ? pNode + pNode->mPrev : NULL;
+#else
     return pNode->mPrev;
+#endif
 }
 
 /*--------------------------------------------------------------------------------------------------------------
@@ -120,7 +178,11 @@ void DListNodeSetData
     )
 {
     assert(pNode);
+#ifdef DLIST_UNROLLED
+    pNode->mData[0] = pData;
+#else
     pNode->mData = pData;
+#endif
 }
 
 /*--------------------------------------------------------------------------------------------------------------
@@ -133,7 +195,11 @@ void DListNodeSetNext
     )
 {
     assert(pNode);
+#ifdef DLIST_COMPACT
+    pNode->mNext = pNext ? (int)(pNext - pNode) : 0;
+#else
     pNode->mNext = pNext;
+#endif
 }
 
 /*--------------------------------------------------------------------------------------------------------------
@@ -146,5 +212,9 @@ void DListNodeSetPrev
     )
 {
     assert(pNode);
+#ifdef DLIST_COMPACT
+    pNode->mPrev = pPrev ? (int)(pPrev - pNode) : 0;
+#else
     pNode->mPrev = pPrev;
+#endif
 }
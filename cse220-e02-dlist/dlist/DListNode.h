@@ -19,39 +19,90 @@
  * MODIFICATION HISTORY:
  * -------------------------------------------------------------------------------------------------------------
  * 10 Mar 2012 [KRB] Initial revision.
+ * 17 Oct 2026 [AGT] Added the unrolled node used when building with LAYOUT=unrolled. Added DListNodeCountData().
+ * 17 Oct 2026 [AGT] An unrolled node is 256 bytes rather than 64.
+ * 17 Oct 2026 [AGT] Added the compact node used when building with LAYOUT=compact.
+ * 17 Oct 2026 [AGT] Removed DListNodeAlloc() and DListNodeFree(). Use DListNodeAllocFrom() and DListNodeFreeTo().
  **************************************************************************************************************/
 #ifndef __DLISTNODE_H__
 #define __DLISTNODE_H__
 
 #include <stdio.h>  /* For FILE */
+#include "Pool.h"   /* For Pool */
+
+#ifdef DLIST_UNROLLED
+/*==============================================================================================================
+ * Preprocessor macro definitions.
+ *============================================================================================================*/
+#ifndef DLISTNODE_BYTES
+#define DLISTNODE_BYTES 256  /* Size of an unrolled node: four cache lines, so SearchInt() has long runs. */
+#endif
+
+/* Number of ints that fit in an unrolled node after the links and the count. 59 with 8-byte pointers. */
+#define DLISTNODE_CAPACITY ((int)((DLISTNODE_BYTES - 2 * sizeof(void *) - sizeof(int)) / sizeof(int)))
+#endif
 
 /*==============================================================================================================
  * Typedefs.
  *============================================================================================================*/
+#if defined(DLIST_COMPACT)
+/*--------------------------------------------------------------------------------------------------------------
+ * A compact node lives in its list's node array (see DListCompact.c) and links to its neighbors by their
+ * distance from it in the array, in nodes, rather than by pointers: 12 bytes per node instead of 24 on a 64-bit
+ * machine. Since the links are relative, they stay valid when the array is moved and DListNodeGetNext() and
+ * friends work without knowing where the array is. Nodes can only be linked to nodes in the same array.
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct DListNode_ {
+    int mData;  /* Each node stores a simple int.                                              */
+    int mNext;  /* Index of the next node minus the index of this node. 0 if this is the last. */
+    int mPrev;  /* Index of the prev node minus the index of this node. 0 if this is the first. */
+} DListNode;
+#elif !defined(DLIST_UNROLLED)
 typedef struct DListNode_ {
     int                mData;  /* Each node stores a simple int. */
     struct DListNode_ *mNext;  /* Pointer to the next node in the list. NULL if this is the last node. */
-    struct DListNode_ *mPrev                        /* Pointer to the prev node in the list. NULL if this is the last node. */
+    struct DListNode_ *mPrev;  /* Pointer to the prev node in the list. NULL if this is the first node. */
 } DListNode;
+#else
+/*--------------------------------------------------------------------------------------------------------------
+ * An unrolled node stores a run of mCount consecutive elements of the list in mData[0..mCount-1], so walking
+ * the list reads consecutive cache lines of up to DLISTNODE_CAPACITY elements rather than one line per element.
+ * DListNodeGetData() and DListNodeSetData() access the first element of the run. See DListUnrolled.c.
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct DListNode_ {
+    struct DListNode_ *mNext;                        /* Next node in the list. NULL if this is the last node.  */
+    struct DListNode_ *mPrev;                        /* Prev node in the list. NULL if this is the first node. */
+    int                mCount;                       /* Number of elements stored in mData, at least 1.        */
+    int                mData[DLISTNODE_CAPACITY];    /* The elements, in list order.                           */
+} DListNode;
+#endif
 
 /*==============================================================================================================
  * Global function declarations. See function comments in DListNode.c
  *============================================================================================================*/
-extern DListNode *DListNodeAlloc
+extern DListNode *DListNodeAllocFrom
     (
+    Pool      *pArena,
     int        pData,
     DListNode *pPrev,
     DListNode *pNext
     );
 
+extern int DListNodeCountData
+    (
+    DListNode *pNode,
+    int        pData
+    );
+
 extern void DListNodeDebugPrint
     (
     FILE      *pStream,
     DListNode *pNode
     );
 
-extern DListNode *DListNodeFree
+extern DListNode *DListNodeFreeTo
     (
+    Pool      *pArena,
     DListNode *pNode
     );
 
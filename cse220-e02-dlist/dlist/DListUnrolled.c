@@ -0,0 +1,1138 @@
+/***************************************************************************************************************
+ * FILE: DListUnrolled.c
+ *
+ * DESCRIPTION
+ * An implementation of the DList.h functions on an unrolled doubly-linked list. It is built in place of DList.c
+ * by running "make LAYOUT=unrolled", which also defines DLIST_UNROLLED so DListNode.h declares the unrolled
+ * node: rather than one int, each node stores a run of up to DLISTNODE_CAPACITY consecutive elements of the
+ * list in an array that spans a few consecutive cache lines. A plain DListNode spends 20 bytes of links on 4
+ * bytes of data and every element is a separate cache miss; walking an unrolled list reads the elements out
+ * of arrays, so DListDebugPrint(), DListFindData(), DListGetIndex(), and DListCopy() are mostly sequential
+ * memory reads, and finding the element at an index skips a whole node at a time.
+ *
+ * Inserting into a full node splits it in two, each half full. Removing an element merges the node with a
+ * neighbor whenever the two fit in one node, so every pair of neighboring nodes holds more than
+ * DLISTNODE_CAPACITY elements and the nodes are on average more than half full. DListAppend() fills the tail
+ * node before starting a new one, so a list built by appending is packed.
+ *
+ * The functions that return a DListNode * (DListFindData(), DListFindIndex(), DListGetHead(), and
+ * DListGetTail()) return the node holding the element, and mSize of the list counts elements, not nodes. If
+ * the list keeps a value index it maps each value to the first node holding it (see DListHash.c).
+ *
+ * Searching a node for a value is done by SearchInt(), which compares 4 or 8 elements per instruction on CPUs
+ * with SSE2 or AVX2 (see Search.c).
+ *
+ * AUTHOR INFORMATION
+ * agent [AGT]
+ *
+ * Email: agent@local
+ *
+ * MODIFICATION HISTORY:
+ * -------------------------------------------------------------------------------------------------------------
+ * 17 Oct 2026 [AGT] Initial revision.
+ * 17 Oct 2026 [AGT] DListOffsetOf() searches the node with SearchInt().
+ * 17 Oct 2026 [AGT] DListSeek() walks from the tail when the index is in the second half of the list.
+ * 17 Oct 2026 [AGT] Added DListAppendN().
+ * 17 Oct 2026 [AGT] Added DListConcat() and DListSplice().
+ * 17 Oct 2026 [AGT] Added DListSort() and DListSortRadix().
+ * 17 Oct 2026 [AGT] Added DListSortParallel().
+ * 17 Oct 2026 [AGT] The comments on DListSplice() and DListFree() give what merging the arenas costs.
+ **************************************************************************************************************/
+#include <assert.h>     /* For assert() */
+#include <stdio.h>      /* For NULL */
+#include <stdlib.h>     /* For free(), malloc() */
+#include <string.h>     /* For memcpy(), memmove() */
+#include "DList.h"      /* For DList struct and function declarations */
+#include "DListHash.h"  /* For DListHashAdd(), DListHashAlloc(), DListHashFind(), DListHashFree(), etc. */
+#include "DListNode.h"  /* For DListNode struct and function declarations */
+#include "Out.h"        /* For Out, OutCommit(), OutItoa(), OutReserve(), OutStr() */
+#include "Pool.h"       /* For PoolAlloc(), PoolFree(), PoolIsShared(), PoolMerge() */
+#include "Search.h"     /* For SearchInt() */
+#include "Sort.h"       /* For SortParallelInt() */
+
+#ifndef DLIST_UNROLLED
+#error DListUnrolled.c must be compiled with -DDLIST_UNROLLED (make LAYOUT=unrolled)
+#endif
+
+/*==============================================================================================================
+ * Static function declarations.
+ *============================================================================================================*/
+static DList *DListInsertAt
+    (
+    DList     *pList,
+    DListNode *pNode,
+    int        pOffset,
+    int        pData
+    );
+
+static void DListMergeNext
+    (
+    DList     *pList,
+    DListNode *pNode
+    );
+
+static DListNode *DListMergeRuns
+    (
+    DListNode  *pP,
+    DListNode  *pQ,
+    DListNode **pSpare,
+    DListNode **pLast
+    );
+
+static int DListOffsetOf
+    (
+    DListNode *pNode,
+    int        pData
+    );
+
+static DList *DListRemoveAt
+    (
+    DList     *pList,
+    DListNode *pNode,
+    int        pOffset
+    );
+
+static DListNode *DListRunEnd
+    (
+    DListNode *pNode
+    );
+
+static DListNode *DListSeek
+    (
+    DList *pList,
+    int    pIndex,
+    int   *pOffset
+    );
+
+static void DListSortNode
+    (
+    DListNode *pNode
+    );
+
+static DListNode *DListSplit
+    (
+    DList     *pList,
+    DListNode *pNode,
+    int        pKeep
+    );
+
+static void DListValueAdd
+    (
+    DList     *pList,
+    int        pData,
+    DListNode *pNode
+    );
+
+/*==============================================================================================================
+ * Function definitions.
+ *============================================================================================================*/
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListAlloc
+ * DESCR: Allocate a new linked list. Returns a pointer to the allocated list or NULL on failure.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListAlloc
+    (
+    )
+{
+    DList *new_list = (DList *)malloc(sizeof(DList));
+    if (new_list) {
+        DListSetHead(new_list, NULL);
+        DListSetTail(new_list, NULL);
+        DListSetSize(new_list, 0);
+        new_list->mArena = PoolAlloc(sizeof(DListNode));
+        if (!new_list->mArena) {
+            free(new_list);
+            return NULL;
+        }
+        new_list->mValues = NULL;
+    }
+    return new_list;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListAppend
+ * DESCR: Appends pData to the list pList. Returns a pointer to pList or NULL on failure, i.e., if a node cannot
+ *        be allocated. Assertion error if pList is NULL.
+ * PCODE:
+ * If the tail node has room Then Store pData after its last element and Return
+ * Link a new node holding just pData after the tail node, as in DList.c
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListAppend
+    (
+    DList *pList,
+    int    pData
+    )
+{
+    DListNode *tail, *new_node;
+    assert(pList);
+    tail = DListGetTail(pList);
+    if (tail && tail->mCount < DLISTNODE_CAPACITY) return DListInsertAt(pList, tail, tail->mCount, pData);
+    new_node = DListNodeAllocFrom(pList->mArena, pData, tail, NULL);
+    if (!new_node) return NULL;
+    if (tail) {
+        DListNodeSetNext(tail, new_node);
+    } else {
+        DListSetHead(pList, new_node);
+    }
+    DListSetTail(pList, new_node);
+    DListSetSize(pList, DListGetSize(pList) + 1);
+    DListValueAdd(pList, pData, new_node);
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListAppendN
+ * DESCR: Appends the pCount elements of pData to the list pList. The elements are copied into the tail node a
+ *        run at a time, and a new tail node is started only when the old one is full. Returns a pointer to
+ *        pList or NULL on failure, i.e., if a node cannot be allocated, in which case the elements appended
+ *        before the failure stay in the list. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListAppendN
+    (
+    DList     *pList,
+    const int *pData,
+    size_t     pCount
+    )
+{
+    DListNode *tail;
+    size_t i, j, run;
+    assert(pList);
+    for (i = 0; i < pCount; i += run) {
+        tail = DListGetTail(pList);
+        if (!tail || tail->mCount == DLISTNODE_CAPACITY) {
+            if (!DListAppend(pList, pData[i])) return NULL;
+            run = 1;
+            continue;
+        }
+        run = DLISTNODE_CAPACITY - tail->mCount;
+        if (run > pCount - i) run = pCount - i;
+        memcpy(&tail->mData[tail->mCount], &pData[i], run * sizeof(int));
+        tail->mCount += (int)run;
+        DListSetSize(pList, DListGetSize(pList) + (int)run);
+        for (j = i; j < i + run; ++j) DListValueAdd(pList, pData[j], tail);
+    }
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListConcat
+ * DESCR: Moves every element of pSrc to the end of pDst, leaving pSrc empty. See DListSplice(). Returns pDst, or
+ *        NULL if pDst and pSrc are the same list or memory cannot be allocated. Assertion error if pDst or pSrc
+ *        is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListConcat
+    (
+    DList *pDst,
+    DList *pSrc
+    )
+{
+    assert(pDst && pSrc);
+    return DListSplice(pDst, DListGetSize(pDst), pSrc, 0, DListGetSize(pSrc));
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListCopy
+ * DESCR: Makes an identical copy of list pSrcList and returns a pointer to the new list. Each node is copied as
+ *        a whole, so the copy has the same shape as pSrcList. If pSrcList keeps a value index, so does the copy.
+ *        Returns NULL if memory cannot be allocated. Assertion error if pSrcList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListCopy
+    (
+    DList *pSrcList
+    )
+{
+    DList *copy_list;
+    DListNode *traverse, *copy_node, *copy_tail = NULL;
+    assert(pSrcList);
+    if (!(copy_list = DListAlloc())) return NULL;
+    for (traverse = DListGetHead(pSrcList); traverse; traverse = DListNodeGetNext(traverse)) {
+        copy_node = DListNodeAllocFrom(copy_list->mArena, traverse->mData[0], copy_tail, NULL);
+        if (!copy_node) return DListFree(copy_list);
+        memcpy(copy_node->mData, traverse->mData, traverse->mCount * sizeof(int));
+        copy_node->mCount = traverse->mCount;
+        if (copy_tail) {
+            DListNodeSetNext(copy_tail, copy_node);
+        } else {
+            DListSetHead(copy_list, copy_node);
+        }
+        copy_tail = copy_node;
+    }
+    DListSetTail(copy_list, copy_tail);
+    DListSetSize(copy_list, DListGetSize(pSrcList));
+    if (pSrcList->mValues) DListIndexValues(copy_list);
+    return copy_list;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListDebugPrint
+ * DESCR: Prints the contents of the list pList to pOut. Prints "List is NULL" if L is NULL. This is primarily a
+ *        testing and debugging function. Room for a whole node is reserved in the output buffer at once.
+ *------------------------------------------------------------------------------------------------------------*/
+void DListDebugPrint
+    (
+    Out   *pOut,
+    DList *pList
+    )
+{
+    DListNode *traverse;
+    char *pos;
+    int i;
+    if (!pList) {
+        OutStr(pOut, "List is NULL.\n");
+        return;
+    }
+    OutStr(pOut, "[ ");
+    for (traverse = DListGetHead(pList); traverse; traverse = DListNodeGetNext(traverse)) {
+        pos = OutReserve(pOut, DLISTNODE_CAPACITY * (OUT_INT_CHARS + 1));
+        for (i = 0; i < traverse->mCount; ++i) {
+            pos = OutItoa(pos, traverse->mData[i]);
+            *pos++ = ' ';
+        }
+        OutCommit(pOut, pos);
+    }
+    OutStr(pOut, "]");
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListDebugPrintRev
+ * DESCR: Prints the contents of the list pList in reverse order to pOut. Prints "List is NULL" if L is NULL.
+ *        This is primarily a debugging function.
+ *------------------------------------------------------------------------------------------------------------*/
+void DListDebugPrintRev
+    (
+    Out   *pOut,
+    DList *pList
+    )
+{
+    DListNode *traverse;
+    char *pos;
+    int i;
+    if (!pList) {
+        OutStr(pOut, "List is NULL.\n");
+        return;
+    }
+    OutStr(pOut, "[ ");
+    for (traverse = DListGetTail(pList); traverse; traverse = DListNodeGetPrev(traverse)) {
+        pos = OutReserve(pOut, DLISTNODE_CAPACITY * (OUT_INT_CHARS + 1));
+        for (i = traverse->mCount - 1; i >= 0; --i) {
+            pos = OutItoa(pos, traverse->mData[i]);
+            *pos++ = ' ';
+        }
+        OutCommit(pOut, pos);
+    }
+    OutStr(pOut, "]");
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListFindData
+ * DESCR: Returns a pointer to the first node holding an element equal to pData. Returns NULL if pData is not in
+ *        pList. Assertion error if pList is NULL. O(1) expected if pList keeps a value index.
+ *------------------------------------------------------------------------------------------------------------*/
+DListNode *DListFindData
+    (
+    DList *pList,
+    int    pData
+    )
+{
+    DListNode *traverse;
+    assert(pList);
+    if (pList->mValues) return DListHashFind(pList->mValues, pData);
+    traverse = DListGetHead(pList);
+    while (traverse && DListOffsetOf(traverse, pData) < 0) {
+        traverse = DListNodeGetNext(traverse);
+    }
+    return traverse;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListFindIndex
+ * DESCR: Returns a pointer to the node holding the element at index pIndex of pList. Fails if pIndex < 0 or
+ *        pIndex >= pList->mSize and returns NULL. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DListNode *DListFindIndex
+    (
+    DList *pList,
+    int    pIndex
+    )
+{
+    int offset;
+    assert(pList);
+    if (pIndex < 0 || pIndex >= DListGetSize(pList)) return NULL;
+    return DListSeek(pList, pIndex, &offset);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListFree
+ * DESCR: Deallocates the linked list pList, releasing its nodes a slab at a time, and its value index if it has
+ *        one. If the arena has been merged with that of a list which is still in use (see DListSplice()), the
+ *        nodes are given back to it one at a time instead, in O(n) time, and the slabs stay allocated until the
+ *        last list using the arena is freed. Returns NULL. Does nothing and returns NULL if pList
+ *        is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListFree
+    (
+    DList *pList
+    )
+{
+    DListNode *traverse, *next;
+    if (!pList) return NULL;
+    if (PoolIsShared(pList->mArena)) {
+        for (traverse = DListGetHead(pList); traverse; traverse = next) {
+            next = DListNodeGetNext(traverse);
+            DListNodeFreeTo(pList->mArena, traverse);
+        }
+    }
+    pList->mArena = PoolFree(pList->mArena);
+    pList->mValues = DListHashFree(pList->mValues);
+    free(pList);
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListGetHead
+ * DESCR: Accessor function for the pList->mHead data member. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DListNode *DListGetHead
+    (
+    DList *pList
+    )
+{
+    assert(pList);
+    return pList->mHead;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListGetIndex
+ * DESCR: Searches pList for an element equal to pData. Returns the index of the first one if it is found, or -1
+ *        if pData is not in pList. Assertion error if pList is NULL. If pList keeps a value index, a missing
+ *        pData is detected in O(1) expected time.
+ *------------------------------------------------------------------------------------------------------------*/
+int DListGetIndex
+    (
+    DList *pList,
+    int    pData
+    )
+{
+    int index = 0, offset;
+    DListNode *traverse;
+    assert(pList);
+    if (pList->mValues && !DListHashFind(pList->mValues, pData)) return -1;
+    for (traverse = DListGetHead(pList); traverse; traverse = DListNodeGetNext(traverse)) {
+        if ((offset = DListOffsetOf(traverse, pData)) >= 0) return index + offset;
+        index += traverse->mCount;
+    }
+    return -1;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListGetSize
+ * DESCR: Accessor function for the pList->mSize data member. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+int DListGetSize
+    (
+    DList *pList
+    )
+{
+    assert(pList);
+    return pList->mSize;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListGetTail
+ * DESCR: Accessor function for the pList->tail data member. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DListNode *DListGetTail
+    (
+    DList *pList
+    )
+{
+    assert(pList);
+    return pList->mTail;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListIndexValues
+ * DESCR: Makes pList keep a value index, as in DList.c. Returns pList, or NULL if pList is NULL or the index
+ *        cannot be built. Does nothing if pList already keeps a value index.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListIndexValues
+    (
+    DList *pList
+    )
+{
+    DListHash *values;
+    DListNode *traverse;
+    int i;
+    if (!pList) return NULL;
+    if (pList->mValues) return pList;
+    if (!(values = DListHashAlloc())) return NULL;
+    for (traverse = DListGetHead(pList); traverse; traverse = DListNodeGetNext(traverse)) {
+        for (i = 0; i < traverse->mCount; ++i) {
+            if (!DListHashAdd(values, traverse->mData[i], traverse)) {
+                DListHashFree(values);
+                return NULL;
+            }
+        }
+    }
+    pList->mValues = values;
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListInsertAt
+ * DESCR: Inserts pData into the node pNode of pList before the element at pOffset, where pOffset may equal the
+ *        number of elements of pNode to insert after the last one. Returns pList, or NULL if pNode is full and
+ *        a node cannot be allocated to split it.
+ * PCODE:
+ * If pNode is full Then
+ *     If pData goes first in pNode and the prev node has room Then Store pData after its last element instead
+ *     Else split pNode and continue with whichever half pOffset falls in
+ * End If
+ * Shift the elements from pOffset on up by one and store pData at pOffset
+ *------------------------------------------------------------------------------------------------------------*/
+static DList *DListInsertAt
+    (
+    DList     *pList,
+    DListNode *pNode,
+    int        pOffset,
+    int        pData
+    )
+{
+    DListNode *prev;
+    if (pNode->mCount == DLISTNODE_CAPACITY) {
+        prev = DListNodeGetPrev(pNode);
+        if (pOffset == 0 && prev && prev->mCount < DLISTNODE_CAPACITY) {
+            pNode = prev;
+            pOffset = prev->mCount;
+        } else {
+            if (!DListSplit(pList, pNode, (pNode->mCount + 1) / 2)) return NULL;
+            if (pOffset > pNode->mCount) {
+                pOffset -= pNode->mCount;
+                pNode = DListNodeGetNext(pNode);
+            }
+        }
+    }
+    memmove(&pNode->mData[pOffset + 1], &pNode->mData[pOffset], (pNode->mCount - pOffset) * sizeof(int));
+    pNode->mData[pOffset] = pData;
+    pNode->mCount++;
+    DListSetSize(pList, DListGetSize(pList) + 1);
+    DListValueAdd(pList, pData, pNode);
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListInsertBefore
+ * DESCR: Inserts pData into list pList before the first occurrence of pBefore. On success, returns the list
+ *        pList. Fails if pBefore is not found or memory cannot be allocated and returns NULL. Assertion error if
+ *        pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListInsertBefore
+    (
+    DList *pList,
+    int    pBefore,
+    int    pData
+    )
+{
+    DListNode *before_node;
+    assert(pList);
+    before_node = DListFindData(pList, pBefore);
+    if (!before_node) return NULL;
+    return DListInsertAt(pList, before_node, DListOffsetOf(before_node, pBefore), pData);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListInsertIndex
+ * DESCR: Inserts pData into the list pList at index pIndex. The elements in the list are numbered starting at
+ *        0. Fails and returns NULL if: (1) pList is empty; or (2) pIndex < 0; or (3) pIndex >= pList->mSize; or
+ *        (4) memory cannot be allocated. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListInsertIndex
+    (
+    DList *pList,
+    int    pIndex,
+    int    pData
+    )
+{
+    DListNode *index_node;
+    int offset;
+    assert(pList);
+    if (DListIsEmpty(pList) || pIndex < 0 || pIndex >= DListGetSize(pList)) return NULL;
+    index_node = DListSeek(pList, pIndex, &offset);
+    return DListInsertAt(pList, index_node, offset, pData);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListIsEmpty
+ * DESCR: Returns true if the pList is empty, false otherwise. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+bool DListIsEmpty
+    (
+    DList *pList
+    )
+{
+    assert(pList);
+    return pList->mSize == 0;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListMergeNext
+ * DESCR: Moves the elements of the node after pNode to the end of pNode and unlinks and frees that node. The
+ *        two nodes must fit in one.
+ *------------------------------------------------------------------------------------------------------------*/
+static void DListMergeNext
+    (
+    DList     *pList,
+    DListNode *pNode
+    )
+{
+    DListNode *next = DListNodeGetNext(pNode);
+    DListNode *next_next = DListNodeGetNext(next);
+    int i;
+    assert(pNode->mCount + next->mCount <= DLISTNODE_CAPACITY);
+    memcpy(&pNode->mData[pNode->mCount], next->mData, next->mCount * sizeof(int));
+    pNode->mCount += next->mCount;
+    if (pList->mValues) {
+        for (i = 0; i < next->mCount; ++i) DListHashMove(pList->mValues, next->mData[i], next, pNode);
+    }
+    DListNodeSetNext(pNode, next_next);
+    if (next_next) {
+        DListNodeSetPrev(next_next, pNode);
+    } else {
+        DListSetTail(pList, pNode);
+    }
+    DListNodeFreeTo(pList->mArena, next);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListMergeRuns
+ * DESCR: Merges the sorted runs of nodes pP and pQ, each ended by a NULL next link, into one sorted run of full
+ *        nodes (but the last) and returns its first node, storing its last node in *pLast. The elements are
+ *        copied into nodes taken from the stack of spare nodes *pSpare, linked through their next links, and
+ *        each node of pP and pQ is pushed onto the stack as soon as it has been read. At most one node of each
+ *        input run is partly read at any time, so the output never needs more than two nodes beyond the ones
+ *        read so far, and two spare nodes to start with are enough. Equal elements are taken from pP first.
+ *------------------------------------------------------------------------------------------------------------*/
+static DListNode *DListMergeRuns
+    (
+    DListNode  *pP,
+    DListNode  *pQ,
+    DListNode **pSpare,
+    DListNode **pLast
+    )
+{
+    DListNode *first = NULL, *out = NULL, *node;
+    int p_offset = 0, q_offset = 0, data;
+    while (pP || pQ) {
+        if (pP && (!pQ || pP->mData[p_offset] <= pQ->mData[q_offset])) {
+            data = pP->mData[p_offset];
+            if (++p_offset == pP->mCount) {
+                node = pP;
+                pP = DListNodeGetNext(pP);
+                p_offset = 0;
+                DListNodeSetNext(node, *pSpare);
+                *pSpare = node;
+            }
+        } else {
+            data = pQ->mData[q_offset];
+            if (++q_offset == pQ->mCount) {
+                node = pQ;
+                pQ = DListNodeGetNext(pQ);
+                q_offset = 0;
+                DListNodeSetNext(node, *pSpare);
+                *pSpare = node;
+            }
+        }
+        if (!out || out->mCount == DLISTNODE_CAPACITY) {
+            node = *pSpare;
+            *pSpare = DListNodeGetNext(node);
+            node->mCount = 0;
+            DListNodeSetPrev(node, out);
+            DListNodeSetNext(node, NULL);
+            if (out) {
+                DListNodeSetNext(out, node);
+            } else {
+                first = node;
+            }
+            out = node;
+        }
+        out->mData[out->mCount++] = data;
+    }
+    *pLast = out;
+    return first;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListOffsetOf
+ * DESCR: Returns the offset of the first element of pNode equal to pData, or -1 if pNode does not hold pData.
+ *------------------------------------------------------------------------------------------------------------*/
+static int DListOffsetOf
+    (
+    DListNode *pNode,
+    int        pData
+    )
+{
+    return SearchInt(pNode->mData, pNode->mCount, pData);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListRemoveAt
+ * DESCR: Removes the element at pOffset of the node pNode from pList. Returns pList.
+ * PCODE:
+ * Remove the element from the value index of pList, if it has one
+ * Shift the elements after pOffset down by one
+ * If pNode and the next node fit in one node Then Merge the next node into pNode
+ * If the prev node and pNode fit in one node Then Merge pNode into the prev node
+ * Else If pNode is empty Then It was the only node, so the list is now empty; free pNode
+ *------------------------------------------------------------------------------------------------------------*/
+static DList *DListRemoveAt
+    (
+    DList     *pList,
+    DListNode *pNode,
+    int        pOffset
+    )
+{
+    DListNode *prev, *next;
+    if (pList->mValues) DListHashRemove(pList->mValues, pNode->mData[pOffset], pNode);
+    memmove(&pNode->mData[pOffset], &pNode->mData[pOffset + 1], (pNode->mCount - pOffset - 1) * sizeof(int));
+    pNode->mCount--;
+    DListSetSize(pList, DListGetSize(pList) - 1);
+    next = DListNodeGetNext(pNode);
+    if (next && pNode->mCount + next->mCount <= DLISTNODE_CAPACITY) DListMergeNext(pList, pNode);
+    prev = DListNodeGetPrev(pNode);
+    if (prev && prev->mCount + pNode->mCount <= DLISTNODE_CAPACITY) {
+        DListMergeNext(pList, prev);
+    } else if (pNode->mCount == 0) {
+        DListSetHead(pList, NULL);
+        DListSetTail(pList, NULL);
+        DListNodeFreeTo(pList->mArena, pNode);
+    }
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListRemoveData
+ * DESCR: Finds and removes the first occurrence of pData in pList. On success returns the list pList. Fails if
+ *        pData is not found and returns NULL. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListRemoveData
+    (
+    DList *pList,
+    int    pData
+    )
+{
+    DListNode *data_node;
+    assert(pList);
+    data_node = DListFindData(pList, pData);
+    if (!data_node) return NULL;
+    return DListRemoveAt(pList, data_node, DListOffsetOf(data_node, pData));
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListRemoveIndex
+ * DESCR: Removes the element at index pIndex in list pList. On success, returns the list pList. Fails if
+ *        pIndex < 0 or pIndex >= pList->mSize and returns NULL. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListRemoveIndex
+    (
+    DList *pList,
+    int    pIndex
+    )
+{
+    DListNode *index_node;
+    int offset;
+    assert(pList);
+    if (pIndex < 0 || pIndex >= DListGetSize(pList)) return NULL;
+    index_node = DListSeek(pList, pIndex, &offset);
+    return DListRemoveAt(pList, index_node, offset);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListRunEnd
+ * DESCR: Returns the last node of the longest run of nodes starting at pNode whose elements, each node being
+ *        sorted, are in ascending order from one node to the next.
+ *------------------------------------------------------------------------------------------------------------*/
+static DListNode *DListRunEnd
+    (
+    DListNode *pNode
+    )
+{
+    DListNode *next;
+    while ((next = DListNodeGetNext(pNode)) && next->mData[0] >= pNode->mData[pNode->mCount - 1]) pNode = next;
+    return pNode;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListSeek
+ * DESCR: Returns the node holding the element at index pIndex, which must be a valid index of pList, and stores
+ *        the element's offset within the node in *pOffset. Skips a whole node per step, walking forward from
+ *        the head if pIndex is in the first half of the list and backward from the tail otherwise.
+ *------------------------------------------------------------------------------------------------------------*/
+static DListNode *DListSeek
+    (
+    DList *pList,
+    int    pIndex,
+    int   *pOffset
+    )
+{
+    DListNode *traverse;
+    int first;
+    if (pIndex < DListGetSize(pList) / 2) {
+        traverse = DListGetHead(pList);
+        while (pIndex >= traverse->mCount) {
+            pIndex -= traverse->mCount;
+            traverse = DListNodeGetNext(traverse);
+        }
+        *pOffset = pIndex;
+    } else {
+        traverse = DListGetTail(pList);
+        first = DListGetSize(pList) - traverse->mCount;
+        while (pIndex < first) {
+            traverse = DListNodeGetPrev(traverse);
+            first -= traverse->mCount;
+        }
+        *pOffset = pIndex - first;
+    }
+    return traverse;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListSetHead
+ * DESCR: Mutator function for the pList->mHead data member. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListSetHead
+    (
+    DList     *pList,
+    DListNode *pHead
+    )
+{
+    assert(pList);
+    pList->mHead = pHead;
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListSetSize
+ * DESCR: Mutator function for the pList->mSize data member. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListSetSize
+    (
+    DList *pList,
+    int    pSize
+    )
+{
+    assert(pList);
+    pList->mSize = pSize;
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListSetTail
+ * DESCR: Mutator function for the pList->mTail data member. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListSetTail
+    (
+    DList     *pList,
+    DListNode *pTail
+    )
+{
+    assert(pList);
+    pList->mTail = pTail;
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListSort
+ * DESCR: Sorts the elements of pList into ascending order with a bottom-up merge sort. The elements of each
+ *        node are sorted first, so each node is a sorted run. Then each pass walks the list merging every two
+ *        neighboring runs, where a run is as many nodes as are already in order (see DListRunEnd()), until a
+ *        pass finds only one run. The merged runs are written into full nodes using the nodes just read (see
+ *        DListMergeRuns()), so the only allocation is of two spare nodes, and the sorted list is packed. Equal
+ *        elements keep their order. O(n log n). Returns pList, or NULL if the spare nodes cannot be allocated,
+ *        in which case pList is unchanged. Assertion error if pList is NULL.
+ * PCODE:
+ * Allocate two spare nodes. If either allocation fails Then Free the other and return null
+ * Drop the value index of pList, remembering whether it had one
+ * Sort the elements of each node  -- Hint: Call DListSortNode()
+ * Repeat
+ *     Walk the list: cut off the next two runs and append their merge, or the last run alone, to the new list
+ * Until a pass merges no runs
+ * Set the head and the tail of pList to the first and last node of the new list
+ * Free the spare nodes, and rebuild the value index if pList had one
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListSort
+    (
+    DList *pList
+    )
+{
+    DListNode *spare = NULL, *list, *tail, *p, *p_end, *q, *q_end, *rest, *first, *last, *node;
+    bool values;
+    int merges;
+    assert(pList);
+    if (DListGetSize(pList) < 2) return pList;
+    for (merges = 0; merges < 2; ++merges) {
+        if (!(node = DListNodeAllocFrom(pList->mArena, 0, NULL, spare))) {
+            if (spare) DListNodeFreeTo(pList->mArena, spare);
+            return NULL;
+        }
+        spare = node;
+    }
+    values = pList->mValues != NULL;
+    pList->mValues = DListHashFree(pList->mValues);
+    for (node = DListGetHead(pList); node; node = DListNodeGetNext(node)) DListSortNode(node);
+    list = DListGetHead(pList);
+    do {
+        p = list;
+        list = tail = NULL;
+        for (merges = 0; p; p = rest) {
+            p_end = DListRunEnd(p);
+            q = DListNodeGetNext(p_end);
+            if (q) {
+                q_end = DListRunEnd(q);
+                rest = DListNodeGetNext(q_end);
+                DListNodeSetNext(p_end, NULL);
+                DListNodeSetNext(q_end, NULL);
+                first = DListMergeRuns(p, q, &spare, &last);
+                ++merges;
+            } else {
+                first = p;
+                last = p_end;
+                rest = NULL;
+            }
+            if (tail) {
+                DListNodeSetNext(tail, first);
+            } else {
+                list = first;
+            }
+            DListNodeSetPrev(first, tail);
+            tail = last;
+        }
+    } while (merges > 0);
+    DListSetHead(pList, list);
+    DListSetTail(pList, tail);
+    while (spare) {
+        node = spare;
+        spare = DListNodeGetNext(spare);
+        DListNodeFreeTo(pList->mArena, node);
+    }
+    if (values) DListIndexValues(pList);
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListSortNode
+ * DESCR: Sorts the elements of pNode into ascending order by insertion sort, which is quick for the short
+ *        array of an unrolled node. Equal elements keep their order.
+ *------------------------------------------------------------------------------------------------------------*/
+static void DListSortNode
+    (
+    DListNode *pNode
+    )
+{
+    int i, j, data;
+    for (i = 1; i < pNode->mCount; ++i) {
+        data = pNode->mData[i];
+        for (j = i; j > 0 && pNode->mData[j - 1] > data; --j) pNode->mData[j] = pNode->mData[j - 1];
+        pNode->mData[j] = data;
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListSortParallel
+ * DESCR: Sorts the elements of pList into ascending order: the elements are copied into an array, where
+ *        SortParallelInt() radix sorts one run of them on each of up to pThreads threads (one per processor if
+ *        pThreads is less than 1) and then merges the runs, and they are copied back into the nodes in order, a run
+ *        at a time. The nodes and their counts stay as they are. The result is the same for any number of threads.
+ *        Takes two temporary arrays of n ints. Returns pList, or NULL if memory cannot be allocated, in which case
+ *        pList is unchanged. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListSortParallel
+    (
+    DList *pList,
+    int    pThreads
+    )
+{
+    DListNode *traverse;
+    int *values, i;
+    assert(pList);
+    if (DListGetSize(pList) < 2) return pList;
+    if (!(values = (int *)malloc(DListGetSize(pList) * sizeof(int)))) return NULL;
+    for (i = 0, traverse = DListGetHead(pList); traverse; traverse = DListNodeGetNext(traverse)) {
+        memcpy(&values[i], traverse->mData, traverse->mCount * sizeof(int));
+        i += traverse->mCount;
+    }
+    if (!SortParallelInt(values, (size_t)DListGetSize(pList), pThreads)) {
+        free(values);
+        return NULL;
+    }
+    for (i = 0, traverse = DListGetHead(pList); traverse; traverse = DListNodeGetNext(traverse)) {
+        memcpy(traverse->mData, &values[i], traverse->mCount * sizeof(int));
+        i += traverse->mCount;
+    }
+    free(values);
+    if (pList->mValues) {
+        pList->mValues = DListHashFree(pList->mValues);
+        DListIndexValues(pList);
+    }
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListSortRadix
+ * DESCR: Sorts the elements of pList into ascending order with DListSortParallel() on one thread, so the whole list
+ *        is a single run, radix sorted by SortRadixInt() in O(n) time, and there is nothing to merge. Faster than
+ *        DListSort() for large lists. Returns pList, or NULL if memory cannot be allocated, in which case pList is
+ *        unchanged. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListSortRadix
+    (
+    DList *pList
+    )
+{
+    return DListSortParallel(pList, 1);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListSplice
+ * DESCR: Moves the elements at indices pFrom through pTo - 1 of pSrc into pDst, before the element at index
+ *        pPos, or at the end if pPos is the size of pDst. A node that straddles one of the three boundaries is
+ *        split there, and then whole nodes are relinked rather than copied and the arenas of the two lists are
+ *        merged, as in DList.c and with the same cost to DListFree(). Nodes that meet at a seam are merged
+ *        again if they fit in one node. A list with a value index has it rebuilt, so the splice takes O(n) time
+ *        at worst. Returns pDst, or NULL if pDst and pSrc are the same list, an index is
+ *        out of range, or memory cannot be allocated. Assertion error if pDst or pSrc is NULL.
+ * PCODE:
+ * Drop the value indices of both lists, remembering which had one
+ * first <- the node starting at index pFrom of pSrc, splitting the node holding it if it starts mid-node
+ * last <- the node ending at index pTo - 1 of pSrc, splitting the node holding index pTo if it starts mid-node
+ * before <- the node starting at index pPos of pDst, splitting as above, or null if pPos is the size of pDst
+ * Unlink the chain first..last from pSrc and link it into pDst before before, as in DList.c
+ * Merge the arena of pSrc into the arena of pDst  -- Hint: Call PoolMerge()
+ * Merge the nodes on either side of each of the three seams if they fit in one node
+ * Rebuild the value indices that were dropped
+ *------------------------------------------------------------------------------------------------------------*/
+DList *DListSplice
+    (
+    DList *pDst,
+    int    pPos,
+    DList *pSrc,
+    int    pFrom,
+    int    pTo
+    )
+{
+    DListNode *first, *last, *before = NULL, *src_prev, *src_next, *dst_prev;
+    bool dst_values, src_values, split = true;
+    int offset;
+    assert(pDst && pSrc);
+    if (pDst == pSrc || pPos < 0 || pPos > DListGetSize(pDst)) return NULL;
+    if (pFrom < 0 || pFrom > pTo || pTo > DListGetSize(pSrc)) return NULL;
+    if (pFrom == pTo) return pDst;
+    dst_values = pDst->mValues != NULL;
+    src_values = pSrc->mValues != NULL;
+    pDst->mValues = DListHashFree(pDst->mValues);
+    pSrc->mValues = DListHashFree(pSrc->mValues);
+    first = DListSeek(pSrc, pFrom, &offset);
+    if (offset > 0) split = (first = DListSplit(pSrc, first, offset)) != NULL;
+    last = DListGetTail(pSrc);
+    if (split && pTo < DListGetSize(pSrc)) {
+        last = DListSeek(pSrc, pTo, &offset);
+        if (offset == 0) {
+            last = DListNodeGetPrev(last);
+        } else {
+            split = DListSplit(pSrc, last, offset) != NULL;
+        }
+    }
+    if (split && pPos < DListGetSize(pDst)) {
+        before = DListSeek(pDst, pPos, &offset);
+        if (offset > 0) split = (before = DListSplit(pDst, before, offset)) != NULL;
+    }
+    if (split) {
+        src_prev = DListNodeGetPrev(first);
+        src_next = DListNodeGetNext(last);
+        if (src_prev) {
+            DListNodeSetNext(src_prev, src_next);
+        } else {
+            DListSetHead(pSrc, src_next);
+        }
+        if (src_next) {
+            DListNodeSetPrev(src_next, src_prev);
+        } else {
+            DListSetTail(pSrc, src_prev);
+        }
+        dst_prev = before ? DListNodeGetPrev(before) : DListGetTail(pDst);
+        DListNodeSetPrev(first, dst_prev);
+        DListNodeSetNext(last, before);
+        if (dst_prev) {
+            DListNodeSetNext(dst_prev, first);
+        } else {
+            DListSetHead(pDst, first);
+        }
+        if (before) {
+            DListNodeSetPrev(before, last);
+        } else {
+            DListSetTail(pDst, last);
+        }
+        DListSetSize(pSrc, DListGetSize(pSrc) - (pTo - pFrom));
+        DListSetSize(pDst, DListGetSize(pDst) + (pTo - pFrom));
+        PoolMerge(pDst->mArena, pSrc->mArena);
+        if (src_prev && src_next && src_prev->mCount + src_next->mCount <= DLISTNODE_CAPACITY) {
+            DListMergeNext(pSrc, src_prev);
+        }
+        if (before && last->mCount + before->mCount <= DLISTNODE_CAPACITY) DListMergeNext(pDst, last);
+        if (dst_prev && dst_prev->mCount + first->mCount <= DLISTNODE_CAPACITY) DListMergeNext(pDst, dst_prev);
+    }
+    if (dst_values) DListIndexValues(pDst);
+    if (src_values) DListIndexValues(pSrc);
+    return split ? pDst : NULL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListSplit
+ * DESCR: Keeps the first pKeep elements of pNode, where 0 < pKeep < the number of elements of pNode, and moves
+ *        the rest to a new node linked in after it. Returns the new node, or NULL if it cannot be allocated, in
+ *        which case pNode is unchanged.
+ *------------------------------------------------------------------------------------------------------------*/
+static DListNode *DListSplit
+    (
+    DList     *pList,
+    DListNode *pNode,
+    int        pKeep
+    )
+{
+    DListNode *next = DListNodeGetNext(pNode);
+    DListNode *new_node = DListNodeAllocFrom(pList->mArena, pNode->mData[pKeep], pNode, next);
+    int i;
+    if (!new_node) return NULL;
+    new_node->mCount = pNode->mCount - pKeep;
+    memcpy(new_node->mData, &pNode->mData[pKeep], new_node->mCount * sizeof(int));
+    pNode->mCount = pKeep;
+    DListNodeSetNext(pNode, new_node);
+    if (next) {
+        DListNodeSetPrev(next, new_node);
+    } else {
+        DListSetTail(pList, new_node);
+    }
+    if (pList->mValues) {
+        for (i = 0; i < new_node->mCount; ++i) {
+            DListHashMove(pList->mValues, new_node->mData[i], pNode, new_node);
+        }
+    }
+    return new_node;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: DListValueAdd
+ * DESCR: Records in the value index of pList, if it keeps one, that pData has just been stored in pNode. If the
+ *        index cannot grow, it is dropped and the list goes back to finding values by scanning.
+ *------------------------------------------------------------------------------------------------------------*/
+static void DListValueAdd
+    (
+    DList     *pList,
+    int        pData,
+    DListNode *pNode
+    )
+{
+    if (pList->mValues && !DListHashAdd(pList->mValues, pData, pNode)) {
+        pList->mValues = DListHashFree(pList->mValues);
+    }
+}
@@ -0,0 +1,300 @@
+/***************************************************************************************************************
+ * FILE: Intern.c
+ *
+ * DESCRIPTION
+ * The string intern table. The first time a string is passed to InternString() a copy of it is stored and it
+ * is given the next unused id (0, 1, 2, ...). Passing an equal string again returns the same id, so two
+ * strings are equal exactly when their ids are equal, and code that has interned its strings can compare
+ * them with == rather than strcmp(). InternGetString() maps an id back to the stored copy, which is how the
+ * test driver prints list names. Strings of any length can be interned.
+ *
+ * The ids are handed out densely, so the stored copies are kept in blocks of INTERN_BLOCK_IDS entries indexed
+ * by id. Finding the id of a string uses an open addressing hash table of ids with linear probing, which is
+ * replaced by one twice its size when it would be more than half full.
+ *
+ * Several threads may use the table at once. Storing a string takes gInternLock, but nothing else does: an
+ * entry never moves once it is stored, so InternGetString() just reads it, and a hash table that has been
+ * replaced is kept rather than freed, so InternString() can look a string up in whichever table it finds
+ * without a lock. If the string is not there it may have been stored meanwhile, so InternString() takes the
+ * lock and looks again before storing it.
+ *
+ * AUTHOR INFORMATION
+ * agent [AGT]
+ *
+ * Email: agent@local
+ *
+ * MODIFICATION HISTORY:
+ * -------------------------------------------------------------------------------------------------------------
+ * 17 Oct 2026 [AGT] Initial revision.
+ * 17 Oct 2026 [AGT] InternString() only grows the hash table when it stores a new string.
+ * 17 Oct 2026 [AGT] InternString() and InternGetString() may be called by several threads at once, even while
+ *                   strings are being stored.
+ **************************************************************************************************************/
+#define _POSIX_C_SOURCE 200112L  /* For pthread_mutex_lock(), etc. when compiling with -ansi */
+
+#include <assert.h>   /* For assert() */
+#include <pthread.h>  /* For pthread_mutex_lock(), pthread_mutex_t, pthread_mutex_unlock() */
+#include <stdio.h>    /* For fprintf() */
+#include <stdlib.h>   /* For calloc(), exit(), malloc() */
+#include <string.h>   /* For memcmp(), memcpy() */
+#include "Intern.h"
+
+/*==============================================================================================================
+ * Preprocessor macro definitions.
+ *============================================================================================================*/
+#define MIN_SLOTS          64     /* Initial number of slots in the hash table. Always a power of two. */
+#define INTERN_BLOCK_SHIFT 12     /* A block holds 2 to this power entries.                           */
+#define INTERN_BLOCK_IDS   (1 << INTERN_BLOCK_SHIFT)
+#define INTERN_BLOCKS      16384  /* Most blocks of entries, so at most 64M strings can be stored.     */
+
+#define InternEntryOf(id) (&gInternTab.mBlocks[(id) >> INTERN_BLOCK_SHIFT][(id) & (INTERN_BLOCK_IDS - 1)])
+
+/*==============================================================================================================
+ * Typedefs.
+ *============================================================================================================*/
+/*--------------------------------------------------------------------------------------------------------------
+ * The stored copy of the string with some id, its length, and its hash, which is cached so the table can be
+ * grown, and most probes rejected, without touching the string itself.
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct {
+    char     *mStr;
+    int       mLen;
+    unsigned  mHash;
+} InternEntry;
+
+/*--------------------------------------------------------------------------------------------------------------
+ * A hash table. Each of the mMask + 1 slots holds an id plus one, so 0 marks an empty slot. mSlots is declared
+ * with one element but allocated with as many as the table has. mOld is the table this one replaced.
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct InternSlots_ {
+    struct InternSlots_ *mOld;
+    unsigned             mMask;
+    int                  mSlots[1];
+} InternSlots;
+
+/*--------------------------------------------------------------------------------------------------------------
+ * The entry of id is InternEntryOf(id). mSlots is only replaced, and a slot of it only filled, while holding
+ * gInternLock; both are stored atomically after what they point to, so a thread that reads them without the
+ * lock sees the table or the entry whole.
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct {
+    InternEntry *mBlocks[INTERN_BLOCKS];
+    int          mCount;  /* Number of ids handed out so far.        */
+    int          mFull;   /* mCount at which the table must be grown. */
+    InternSlots *mSlots;
+} InternTab;
+
+/*==============================================================================================================
+ * Static global variable definitions.
+ *============================================================================================================*/
+static InternTab       gInternTab;
+static pthread_mutex_t gInternLock = PTHREAD_MUTEX_INITIALIZER;
+
+/*==============================================================================================================
+ * Static function declarations.
+ *============================================================================================================*/
+static int InternFind
+    (
+    InternSlots *pSlots,
+    char        *pStr,
+    int          pLen,
+    unsigned     pHash,
+    unsigned    *pSlot
+    );
+
+static void InternGrowSlots
+    (
+    );
+
+static unsigned InternHash
+    (
+    char *pStr,
+    int   pLen
+    );
+
+static void *InternMalloc
+    (
+    size_t pSize
+    );
+
+static int InternStore
+    (
+    char     *pStr,
+    int       pLen,
+    unsigned  pHash
+    );
+
+/*==============================================================================================================
+ * Function definitions.
+ *============================================================================================================*/
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: InternFind
+ * DESCR: Looks up the pLen characters at pStr, whose hash is pHash, in the hash table pSlots. Returns the id of
+ *        the string if it is there. Otherwise returns -1 and stores in *pSlot the empty slot where the probe
+ *        ended.
+ *------------------------------------------------------------------------------------------------------------*/
+static int InternFind
+    (
+    InternSlots *pSlots,
+    char        *pStr,
+    int          pLen,
+    unsigned     pHash,
+    unsigned    *pSlot
+    )
+{
+    unsigned slot;
+    int id;
+    InternEntry *entry;
+    for (slot = pHash & pSlots->mMask; (id = __atomic_load_n(&pSlots->mSlots[slot], __ATOMIC_ACQUIRE) - 1) >= 0;
+         slot = (slot + 1) & pSlots->mMask) {
+        entry = InternEntryOf(id);
+        if (entry->mHash == pHash && entry->mLen == pLen && !memcmp(entry->mStr, pStr, pLen)) return id;
+    }
+    *pSlot = slot;
+    return -1;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: InternGetString
+ * DESCR: Returns the stored, null-terminated copy of the string with id pId. The caller must not modify or free
+ *        it. Assertion error if pId was not returned by InternString().
+ *------------------------------------------------------------------------------------------------------------*/
+char *InternGetString
+    (
+    int pId
+    )
+{
+    assert(pId >= 0 && pId < __atomic_load_n(&gInternTab.mCount, __ATOMIC_RELAXED));
+    return InternEntryOf(pId)->mStr;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: InternGrowSlots
+ * DESCR: Replaces the hash table with one of twice the size (or of MIN_SLOTS on first use) holding every id.
+ *        The old table is kept, since other threads may still be looking in it. Called with gInternLock held.
+ *------------------------------------------------------------------------------------------------------------*/
+static void InternGrowSlots
+    (
+    )
+{
+    InternSlots *old = gInternTab.mSlots, *slots;
+    unsigned slot_count = old ? 2 * (old->mMask + 1) : MIN_SLOTS, slot;
+    int id;
+    slots = (InternSlots *)calloc(1, sizeof(InternSlots) + (slot_count - 1) * sizeof(int));
+    if (!slots) {
+        fprintf(stderr, "Error, cannot grow the string intern table to %u slots\n", slot_count);
+        exit(-1);
+    }
+    slots->mOld = old;
+    slots->mMask = slot_count - 1;
+    for (id = 0; id < gInternTab.mCount; id++) {
+        slot = InternEntryOf(id)->mHash & slots->mMask;
+        while (slots->mSlots[slot]) slot = (slot + 1) & slots->mMask;
+        slots->mSlots[slot] = id + 1;
+    }
+    gInternTab.mFull = (int)(slot_count / 2);
+    __atomic_store_n(&gInternTab.mSlots, slots, __ATOMIC_RELEASE);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: InternHash
+ * DESCR: Returns the 32-bit FNV-1a hash of the pLen characters at pStr.
+ *------------------------------------------------------------------------------------------------------------*/
+static unsigned InternHash
+    (
+    char *pStr,
+    int   pLen
+    )
+{
+    unsigned long hash = 2166136261UL;
+    while (pLen-- > 0) {
+        hash ^= (unsigned char)*pStr++;
+        hash = (hash * 16777619UL) & 0xFFFFFFFFUL;
+    }
+    return (unsigned)hash;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: InternMalloc
+ * DESCR: Calls malloc() and terminates the program with an error message if it fails.
+ *------------------------------------------------------------------------------------------------------------*/
+static void *InternMalloc
+    (
+    size_t pSize
+    )
+{
+    void *block = malloc(pSize);
+    if (!block) {
+        fprintf(stderr, "Error, out of memory in the string intern table\n");
+        exit(-1);
+    }
+    return block;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: InternStore
+ * DESCR: Stores a null-terminated copy of the pLen characters at pStr, whose hash is pHash, gives it the next
+ *        unused id, and returns the id. The string must not be stored already. Called with gInternLock held.
+ *        Terminates the program with an error message if memory runs out or every id is used.
+ *------------------------------------------------------------------------------------------------------------*/
+static int InternStore
+    (
+    char     *pStr,
+    int       pLen,
+    unsigned  pHash
+    )
+{
+    int id = gInternTab.mCount;
+    unsigned slot;
+    InternEntry *entry;
+    if (id == INTERN_BLOCKS * INTERN_BLOCK_IDS) {
+        fprintf(stderr, "Error, the string intern table is full\n");
+        exit(-1);
+    }
+    if (id % INTERN_BLOCK_IDS == 0) {
+        gInternTab.mBlocks[id >> INTERN_BLOCK_SHIFT] = (InternEntry *)InternMalloc(INTERN_BLOCK_IDS *
+                                                                                  sizeof(InternEntry));
+    }
+    if (id >= gInternTab.mFull) InternGrowSlots();
+    entry = InternEntryOf(id);
+    entry->mStr = (char *)InternMalloc(pLen + 1);
+    memcpy(entry->mStr, pStr, pLen);
+    entry->mStr[pLen] = '\0';
+    entry->mLen = pLen;
+    entry->mHash = pHash;
+    __atomic_store_n(&gInternTab.mCount, id + 1, __ATOMIC_RELAXED);
+    InternFind(gInternTab.mSlots, pStr, pLen, pHash, &slot);
+    __atomic_store_n(&gInternTab.mSlots->mSlots[slot], id + 1, __ATOMIC_RELEASE);
+    return id;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: InternString
+ * DESCR: Returns the id of the pLen characters at pStr, which need not be null-terminated. If this string has
+ *        not been seen before, a null-terminated copy of it is stored and it is given the next unused id.
+ *        Terminates the program with an error message if memory runs out. Finding a string that has already
+ *        been stored takes no lock, and any number of threads may call this function at once.
+ * PCODE:
+ * Look the string up in the current hash table; if it is there, return its id
+ * Take gInternLock
+ * Look it up again in the table that is current now, and store it if it is not there either
+ * Release gInternLock, and return its id
+ *------------------------------------------------------------------------------------------------------------*/
+int InternString
+    (
+    char *pStr,
+    int   pLen
+    )
+{
+    unsigned hash = InternHash(pStr, pLen), slot;
+    InternSlots *slots = __atomic_load_n(&gInternTab.mSlots, __ATOMIC_ACQUIRE);
+    int id;
+    if (slots && (id = InternFind(slots, pStr, pLen, hash, &slot)) >= 0) return id;
+    pthread_mutex_lock(&gInternLock);
+    if (!gInternTab.mSlots || (id = InternFind(gInternTab.mSlots, pStr, pLen, hash, &slot)) < 0) {
+        id = InternStore(pStr, pLen, hash);
+    }
+    pthread_mutex_unlock(&gInternLock);
+    return id;
+}
@@ -4,6 +4,22 @@
  * DESCRIPTION
  * See comments in ListMan.h
  *
+ * The database may be used by several threads at once. It is split into LISTMAN_SHARDS shards by the hash of
+ * the name id, and each shard is a hash table of its own with its own lock, so threads that create or free
+ * lists in different shards do not wait for each other. Lookups, which are far more common, take no lock and
+ * write nothing shared: each shard has a sequence count that a writer makes odd while it changes the shard and
+ * even again when it is done (a seqlock). A lookup reads the count, probes the table, and then reads the count
+ * again; if it changed or was odd, a writer got in the way and the lookup is done over. Since lookups never
+ * write to memory that other threads read, adding reader threads adds no contention between them. That is the
+ * design; it has not been measured. The "regstress" command of StressTest.c checks that lookups stay correct
+ * while lists are created and freed, but it has only been run on one core, so how lookups scale with reader
+ * threads is untested.
+ *
+ * A lookup may be probing a shard's table while a writer grows it, so a table that has been replaced is not
+ * freed but kept on the shard's list of old tables until ListManInit(). The tables double in size, so the old
+ * ones take less memory than the current one. The database only guards the mapping from names to lists; two
+ * threads using the same list must still take turns.
+ *
  * AUTHOR INFORMATION
  * Kevin R. Burger [KRB]
  *
@@ -19,134 +35,457 @@
  * MODIFICATION HISTORY:
  * -------------------------------------------------------------------------------------------------------------
  * 10 Mar 2012 [KRB] Initial revision.
+ * 17 Oct 2026 [AGT] The list database is an open addressing hash table that grows as lists are created.
+ * 17 Oct 2026 [AGT] Lists are identified by interned name ids rather than by name strings.
+ * 17 Oct 2026 [AGT] An entry may hold a persistent list (see PList.h) rather than a DList.
+ * 17 Oct 2026 [AGT] The database is split into shards with a lock each, and lookups take no lock.
+ * 17 Oct 2026 [AGT] Creating a list with the name of one in the database frees the list it replaces.
+ * 17 Oct 2026 [AGT] Noted that the scaling of lookups with reader threads has not been measured.
  **************************************************************************************************************/
-#include <stdio.h>    /* For fprintf(), fscanf() */
-#include <stdlib.h>   /* For exit() */
-#include <string.h>   /* For strcmp(), strcpy() */
+#define _POSIX_C_SOURCE 200112L  /* For pthread_mutex_init(), pthread_mutex_lock(), etc. when compiling with -ansi */
+
+#include <pthread.h>  /* For pthread_mutex_init(), pthread_mutex_lock(), pthread_mutex_unlock() */
+#include <stdio.h>    /* For fprintf() */
+#include <stdlib.h>   /* For calloc(), exit(), free(), malloc() */
 #include "ListMan.h"
-#include "String.h"   /* For streq() */
 
 /*==============================================================================================================
  * Preprocess macro definitions.
  *============================================================================================================*/
-#define MAX_LISTS 32
+#define MIN_SLOTS          16                         /* Slots per shard after ListManInit(). A power of two. */
+#define LISTMAN_SHARD_BITS 4                          /* Bits of the hash that choose the shard.              */
+#define LISTMAN_SHARDS     (1 << LISTMAN_SHARD_BITS)  /* Number of shards.                                    */
+
+/* Fields that a lookup may read while a writer changes them are read and written atomically, with no ordering
+ * of their own; the sequence count orders them. */
+#define ListManLoad(p)     __atomic_load_n((p), __ATOMIC_RELAXED)
+#define ListManStore(p, v) __atomic_store_n((p), (v), __ATOMIC_RELAXED)
 
+#define ListManIsUsed(entry) (ListManLoad(&(entry)->mList) || ListManLoad(&(entry)->mVersion))
 /*==============================================================================================================
  * Typedefs.
  *============================================================================================================*/
 /*--------------------------------------------------------------------------------------------------------------
- * This structured data type provides a mapping from linked list name to the linked list pointer. Each name
- * in the testing input file will be seven characters or fewer.
+ * This structured data type provides a mapping from linked list name to the linked list pointer. The name is
+ * stored as the id returned by InternString() (see Intern.c), so names can be any length and comparing two
+ * names is an integer compare. A list is either a DList, in mList, or a persistent list, in mVersion; the other
+ * pointer is NULL. A slot of the table where both are NULL is empty.
  *------------------------------------------------------------------------------------------------------------*/
 typedef struct {
-    char   mListName[8];
+    int    mNameId;
     DList *mList;
+    PList *mVersion;
 } ListId;
 
+/*--------------------------------------------------------------------------------------------------------------
+ * The table of one shard. mSlots is kept with mLists, rather than in the shard, so that a lookup that reads
+ * the table pointer always gets the size that goes with it. mOld is the table this one replaced.
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct ListTable_ {
+    ListId            *mLists;  /* The slots.                                      */
+    unsigned           mSlots;  /* Number of slots. Always a power of two.         */
+    struct ListTable_ *mOld;    /* Table this one replaced, or NULL. See above.    */
+} ListTable;
+
 /*
- * The list database is an array of ListID objects. The data member mSize keeps track of how many lists are in
- * the database. It is initialized to 0. Everytime a new list is added to the database (either because of a
- * "create" command or a "copy" command), then mSize is incremented. Everytime a list is destroyed (by a
- * "destroy" command) then mSize is decremented. We allot room for way more lists than we need to (see
- * MAX_LISTS).
+ * Each shard of the list database is a hash table of ListId objects using open addressing with linear probing.
+ * A name id hashes to a home slot, and the entry for that name is in the first slot at or after the home slot
+ * (wrapping around) which is either empty or holds that name. The number of slots is always a power of two so
+ * the hash can be reduced to a slot with a mask. The data member mSize keeps track of how many lists are in the
+ * shard. Everytime a new list is added to the database (either because of a "create" command or a "copy"
+ * command), then mSize is incremented, and when more than three quarters of the slots are in use the table is
+ * doubled. Everytime a list is destroyed (by a "free" command) then mSize is decremented. mTable and the
+ * entries are only changed with mLock held and mSeq odd.
  */
 typedef struct {
-    ListId mLists[MAX_LISTS];
-    int    mSize;
+    ListTable      *mTable;  /* The current table.                                  */
+    int             mSize;   /* Number of lists in the shard.                       */
+    unsigned        mSeq;    /* Odd while a writer is changing the shard.           */
+    pthread_mutex_t mLock;   /* Held by the writer changing the shard.              */
 } ListDb;
 
 /*==============================================================================================================
  * Static global variable definitions.
  *============================================================================================================*/
-static ListDb gListDb;
+static ListDb gListDb[LISTMAN_SHARDS];
+static int    gLocksReady;  /* True once ListManInit() has initialized the locks of the shards. */
 
 /*==============================================================================================================
  * Static function declarations (prototypes).
  *============================================================================================================*/
+static void ListManBeginWrite
+    (
+    ListDb *pDb
+    );
+
 static void ListManCheckSize
     (
+    ListDb *pDb
+    );
+
+static ListId *ListManCreateEntry
+    (
+    ListDb *pDb,
+    int     pNameId
+    );
+
+static void ListManEndWrite
+    (
+    ListDb *pDb
+    );
+
+static unsigned ListManHash
+    (
+    int pNameId
+    );
+
+static ListId *ListManLookup
+    (
+    ListTable *pTable,
+    int        pNameId
+    );
+
+static void ListManRead
+    (
+    int     pNameId,
+    DList **pList,
+    PList **pVersion
+    );
+
+static void ListManResize
+    (
+    ListDb *pDb,
+    int     pSlots
+    );
+
+static ListDb *ListManShard
+    (
+    int pNameId
     );
 
 /*==============================================================================================================
  * Function definitions.
  *============================================================================================================*/
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListManBeginWrite
+ * DESCR: Locks the shard pDb and makes its sequence count odd, so lookups that overlap the change do it over.
+ *        The release fence keeps the changes that follow from being seen before the count.
+ *------------------------------------------------------------------------------------------------------------*/
+static void ListManBeginWrite
+    (
+    ListDb *pDb
+    )
+{
+    pthread_mutex_lock(&pDb->mLock);
+    ListManStore(&pDb->mSeq, pDb->mSeq + 1);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
 /*--------------------------------------------------------------------------------------------------------------
  * FUNCT: ListManCheckSize
- * DESCR: Checks to make sure there is room in the list database for a new list. Called from ListManCreateList()
+ * DESCR: Checks to make sure there is room in the shard pDb for a new list, doubling the number of slots when
+ *        adding one more list would make the table more than three quarters full. Called from
+ *        ListManCreateEntry().
  *------------------------------------------------------------------------------------------------------------*/
 static void ListManCheckSize
     (
+    ListDb *pDb
     )
 {
-    if (gListDb.mSize < MAX_LISTS) return;
-    fprintf(stderr, "Error, number of lists exceeds maximum (%d)\n", MAX_LISTS);
-    exit(-1);
+    if (4 * ((unsigned)pDb->mSize + 1) <= 3 * pDb->mTable->mSlots) return;
+    ListManResize(pDb, 2 * pDb->mTable->mSlots);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListManCreateEntry
+ * DESCR: Returns the entry for pNameId in the shard pDb, adding an empty one if there is none. The caller has
+ *        begun a write of pDb (see ListManBeginWrite()).
+ *------------------------------------------------------------------------------------------------------------*/
+static ListId *ListManCreateEntry
+    (
+    ListDb *pDb,
+    int     pNameId
+    )
+{
+    ListId *entry;
+    ListManCheckSize(pDb);
+    entry = ListManLookup(pDb->mTable, pNameId);
+    if (!ListManIsUsed(entry)) {
+        ListManStore(&entry->mNameId, pNameId);
+        pDb->mSize++;
+    }
+    return entry;
 }
 
 /*--------------------------------------------------------------------------------------------------------------
  * FUNCT: ListManCreateList
- * DESCR: Called when a new list is being created (either by "create" or "copy").
+ * DESCR: Called when a new list is being created (either by "create" or "copy"). If a list with the same name
+ *        is already in the database, it is replaced by pNewList and freed, so no other thread may still be
+ *        using it. Does nothing if pNewList is NULL. Locks only the shard of pNameId.
  *------------------------------------------------------------------------------------------------------------*/
 void ListManCreateList
     (
-    char  *pListName,
+    int    pNameId,
     DList *pNewList
     )
 {
-    ListManCheckSize();
-    int index = gListDb.mSize;
-    strcpy(gListDb.mLists[index].mListName, pListName);
-    gListDb.mLists[index].mList = pNewList;
-    gListDb.mSize++;
+    ListDb *db = ListManShard(pNameId);
+    ListId *entry;
+    DList *old_list;
+    PList *old_version;
+    if (!pNewList) return;
+    ListManBeginWrite(db);
+    entry = ListManCreateEntry(db, pNameId);
+    old_list = entry->mList;
+    old_version = entry->mVersion;
+    ListManStore(&entry->mList, pNewList);
+    ListManStore(&entry->mVersion, (PList *)NULL);
+    ListManEndWrite(db);
+    if (old_list != pNewList) DListFree(old_list);
+    PListFree(old_version);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListManCreateVersion
+ * DESCR: Like ListManCreateList() but for a persistent list (either by "pcreate", "snapshot", or "copy" of a
+ *        persistent list). The list it replaces, if any, is freed. Does nothing if pNewVersion is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+void ListManCreateVersion
+    (
+    int    pNameId,
+    PList *pNewVersion
+    )
+{
+    ListDb *db = ListManShard(pNameId);
+    ListId *entry;
+    DList *old_list;
+    PList *old_version;
+    if (!pNewVersion) return;
+    ListManBeginWrite(db);
+    entry = ListManCreateEntry(db, pNameId);
+    old_list = entry->mList;
+    old_version = entry->mVersion;
+    ListManStore(&entry->mList, (DList *)NULL);
+    ListManStore(&entry->mVersion, pNewVersion);
+    ListManEndWrite(db);
+    DListFree(old_list);
+    if (old_version != pNewVersion) PListFree(old_version);
+}
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListManEndWrite
+ * DESCR: Makes the sequence count of the shard pDb even again, releasing the changes made since
+ *        ListManBeginWrite() to the lookups that read the new count, and unlocks the shard.
+ *------------------------------------------------------------------------------------------------------------*/
+static void ListManEndWrite
+    (
+    ListDb *pDb
+    )
+{
+    __atomic_store_n(&pDb->mSeq, pDb->mSeq + 1, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&pDb->mLock);
 }
 
 /*--------------------------------------------------------------------------------------------------------------
  * FUNCT: ListManFreeList
- * DESCR: Called when an existing list is being freed (by the "free" command). Note: This code is very sleazy,
- *        but since the array is small, the time it takes to move each element is minimal.
+ * DESCR: Called when an existing list is being freed (by the "free" command). Rather than leaving a tombstone
+ *        in the freed slot, the entries that follow it in the same probe run are shifted back so that every
+ *        entry can still be reached from its home slot without passing an empty slot. Locks only the shard of
+ *        pNameId.
  *------------------------------------------------------------------------------------------------------------*/
 void ListManFreeList
     (
-    char *pListName
+    int pNameId
     )
 {
-    int i;
-    for (i = 0; i < gListDb.mSize; i++) {
-        if (streq(gListDb.mLists[i].mListName, pListName)) {
-           int j;
-           for (j = i; j < gListDb.mSize-1; j++) {
-               strcpy(gListDb.mLists[j].mListName, gListDb.mLists[j+1].mListName);
-               gListDb.mLists[j].mList = gListDb.mLists[j+1].mList;
-           }
-           gListDb.mSize--;
-           break;
+    ListDb *db = ListManShard(pNameId);
+    ListTable *table;
+    ListId *lists;
+    unsigned mask, hole, next, home;
+    ListManBeginWrite(db);
+    table = db->mTable;
+    lists = table->mLists;
+    mask = table->mSlots - 1;
+    hole = ListManLookup(table, pNameId) - lists;
+    if (ListManIsUsed(&lists[hole])) {
+        next = (hole + 1) & mask;
+        while (ListManIsUsed(&lists[next])) {
+            /* The entry in 'next' may move into the hole only if its home slot is not in (hole, next]. */
+            home = (ListManHash(lists[next].mNameId) >> LISTMAN_SHARD_BITS) & mask;
+            if (((next - home) & mask) >= ((next - hole) & mask)) {
+                ListManStore(&lists[hole].mNameId, lists[next].mNameId);
+                ListManStore(&lists[hole].mList, lists[next].mList);
+                ListManStore(&lists[hole].mVersion, lists[next].mVersion);
+                hole = next;
+            }
+            next = (next + 1) & mask;
         }
+        ListManStore(&lists[hole].mList, (DList *)NULL);
+        ListManStore(&lists[hole].mVersion, (PList *)NULL);
+        db->mSize--;
     }
+    ListManEndWrite(db);
 }
 
 /*--------------------------------------------------------------------------------------------------------------
  * FUNCT: ListManGetList
- * DESCR: Given the name of a list in pListName this function finds the list pointer in the database and returns
- *        the list pointer.
+ * DESCR: Given the name id of a list in pNameId this function finds the list pointer in the database and
+ *        returns the list pointer. Returns NULL if there is no list with that name, or if it is a persistent list.
+ *        Takes no lock (see ListManRead()).
  *------------------------------------------------------------------------------------------------------------*/
 DList *ListManGetList
     (
-    char *pListName
+    int pNameId
     )
 {
-    int i;
-    for (i = 0; i < gListDb.mSize; i++) {
-        if (streq(gListDb.mLists[i].mListName, pListName)) return gListDb.mLists[i].mList;
-    }
-    return NULL;
+    DList *list;
+    PList *version;
+    ListManRead(pNameId, &list, &version);
+    return list;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListManGetVersion
+ * DESCR: Returns the persistent list named by pNameId, or NULL if there is no list with that name or if it is a
+ *        DList. Takes no lock (see ListManRead()).
+ *------------------------------------------------------------------------------------------------------------*/
+PList *ListManGetVersion
+    (
+    int pNameId
+    )
+{
+    DList *list;
+    PList *version;
+    ListManRead(pNameId, &list, &version);
+    return version;
 }
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListManHash
+ * DESCR: Returns a hash of the name id pNameId. Ids are handed out consecutively, so they are spread over the
+ *        table by Fibonacci hashing (multiplying by 2^32 divided by the golden ratio). The low LISTMAN_SHARD_BITS
+ *        bits choose the shard and the bits above them the home slot in the shard.
+ *------------------------------------------------------------------------------------------------------------*/
+static unsigned ListManHash
+    (
+    int pNameId
+    )
+{
+    unsigned long hash = ((unsigned long)pNameId * 2654435769UL) & 0xFFFFFFFFUL;
+    return (unsigned)(hash ^ (hash >> 16));
+}
+
 /*--------------------------------------------------------------------------------------------------------------
  * FUNCT: ListManInit()
- * DESCR: The list database is initialized by setting the mSize data member to 0.
+ * DESCR: The list database is initialized by giving every shard MIN_SLOTS empty slots and setting its mSize data
+ *        member to 0. The tables of an earlier database, old ones too, are freed, so no other thread may be
+ *        using the database.
  *------------------------------------------------------------------------------------------------------------*/
 void ListManInit
     (
     )
 {
-    gListDb.mSize = 0;
+    ListTable *table, *old;
+    int shard;
+    for (shard = 0; shard < LISTMAN_SHARDS; ++shard) {
+        if (!gLocksReady) pthread_mutex_init(&gListDb[shard].mLock, NULL);
+        for (table = gListDb[shard].mTable; table; table = old) {
+            old = table->mOld;
+            free(table->mLists);
+            free(table);
+        }
+        gListDb[shard].mTable = NULL;
+        gListDb[shard].mSize = 0;
+        ListManResize(&gListDb[shard], MIN_SLOTS);
+    }
+    gLocksReady = 1;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListManLookup
+ * DESCR: Returns a pointer to the slot of pTable holding the entry for pNameId, or if there is no such entry, to
+ *        the empty slot where it would be inserted. A lookup that overlaps a write may see the table part way
+ *        through a change, so the probe stops after every slot has been looked at even if none was empty; the
+ *        caller throws such a result away.
+ *------------------------------------------------------------------------------------------------------------*/
+static ListId *ListManLookup
+    (
+    ListTable *pTable,
+    int        pNameId
+    )
+{
+    unsigned mask = pTable->mSlots - 1;
+    unsigned slot = (ListManHash(pNameId) >> LISTMAN_SHARD_BITS) & mask;
+    unsigned probes;
+    for (probes = 0; probes < mask && ListManIsUsed(&pTable->mLists[slot]); ++probes) {
+        if (ListManLoad(&pTable->mLists[slot].mNameId) == pNameId) break;
+        slot = (slot + 1) & mask;
+    }
+    return &pTable->mLists[slot];
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListManRead
+ * DESCR: Looks up pNameId without taking a lock, storing its DList in *pList and its persistent list in
+ *        *pVersion (NULL if there is none). The lookup is done over until the sequence count of the shard is
+ *        even and the same before and after it, so the two are from one state of the database. The acquire fence
+ *        keeps the reads of the entry from being done after the second read of the count.
+ *------------------------------------------------------------------------------------------------------------*/
+static void ListManRead
+    (
+    int     pNameId,
+    DList **pList,
+    PList **pVersion
+    )
+{
+    ListDb *db = ListManShard(pNameId);
+    ListId *entry;
+    unsigned seq;
+    for (;;) {
+        if ((seq = __atomic_load_n(&db->mSeq, __ATOMIC_ACQUIRE)) & 1) continue;
+        entry = ListManLookup(__atomic_load_n(&db->mTable, __ATOMIC_ACQUIRE), pNameId);
+        *pList = ListManLoad(&entry->mList);
+        *pVersion = ListManLoad(&entry->mVersion);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (ListManLoad(&db->mSeq) == seq) return;
+    }
+}
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListManResize
+ * DESCR: Replaces the table of the shard pDb with one of pSlots empty slots and reinserts every entry of the old
+ *        table, which is kept on mOld of the new one (see the comments at the top of the file). The new table is
+ *        filled before it is published, so its slots need no atomic stores. If the new table cannot be
+ *        allocated, displays an error message and terminates the program.
+ *------------------------------------------------------------------------------------------------------------*/
+static void ListManResize
+    (
+    ListDb *pDb,
+    int     pSlots
+    )
+{
+    ListTable *old_table = pDb->mTable;
+    ListTable *new_table = (ListTable *)malloc(sizeof(ListTable));
+    unsigned i;
+    if (!new_table || !(new_table->mLists = (ListId *)calloc(pSlots, sizeof(ListId)))) {
+        fprintf(stderr, "Error, cannot grow the list database to %d slots\n", pSlots);
+        exit(-1);
+    }
+    new_table->mSlots = (unsigned)pSlots;
+    new_table->mOld = old_table;
+    for (i = 0; old_table && i < old_table->mSlots; i++) {
+        if (ListManIsUsed(&old_table->mLists[i])) {
+            *ListManLookup(new_table, old_table->mLists[i].mNameId) = old_table->mLists[i];
+        }
+    }
+    __atomic_store_n(&pDb->mTable, new_table, __ATOMIC_RELEASE);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListManShard
+ * DESCR: Returns the shard that holds the entry for pNameId.
+ *------------------------------------------------------------------------------------------------------------*/
+static ListDb *ListManShard
+    (
+    int pNameId
+    )
+{
+    return &gListDb[ListManHash(pNameId) & (LISTMAN_SHARDS - 1)];
 }
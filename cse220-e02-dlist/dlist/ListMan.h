@@ -20,29 +20,43 @@
  * MODIFICATION HISTORY:
  * -------------------------------------------------------------------------------------------------------------
  * 10 Mar 2012 [KRB] Initial revision.
+ * 17 Oct 2026 [AGT] Lists are identified by interned name ids. See Intern.h.
+ * 17 Oct 2026 [AGT] Added ListManCreateVersion() and ListManGetVersion() for persistent lists.
  **************************************************************************************************************/
 #ifndef __LISTMAN_H__
 #define __LISTMAN_H__
 
 #include "DList.h"
+#include "PList.h"
 
 /*==============================================================================================================
  * Global function declarations. See function comments in ListMan.c
  *============================================================================================================*/
 extern void ListManCreateList
     (
-    char  *pListName,
+    int    pNameId,
     DList *pNewList
     );
 
+extern void ListManCreateVersion
+    (
+    int    pNameId,
+    PList *pNewVersion
+    );
+
 extern void ListManFreeList
     (
-    char *pListname
+    int pNameId
     );
 
 extern DList *ListManGetList
     (
-    char *pListName
+    int pNameId
+    );
+
+extern PList *ListManGetVersion
+    (
+    int pNameId
     );
 
 extern void ListManInit
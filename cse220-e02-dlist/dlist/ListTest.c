@@ -19,97 +19,434 @@
  * MODIFICATION HISTORY:
  * -------------------------------------------------------------------------------------------------------------
  * 10 Mar 2012 [KRB] Initial revision.
+ * 17 Oct 2026 [AGT] Fixed the prototypes that did not match their handlers, the Dlist typo, and the "copied"
+ *                   message, so ListTest.c compiles.
+ * 17 Oct 2026 [AGT] Words are read by ListTestReadWord(), so list names and commands can be any length. List
+ *                   names are interned and passed to the list manager as name ids.
+ * 17 Oct 2026 [AGT] The input file is mapped into memory and split into tokens by the scanner in Scan.c
+ *                   rather than read with fscanf().
+ * 17 Oct 2026 [AGT] Commands are registered in gCommands[] and dispatched through a perfect hash of the command
+ *                   name rather than an if-else chain of string compares.
+ * 17 Oct 2026 [AGT] Results are written through the buffered writer in Out.c rather than with fprintf().
+ * 17 Oct 2026 [AGT] Added the "hash list" command.
+ * 17 Oct 2026 [AGT] Added persistent lists: the "pcreate list" and "snapshot list name" commands, and the
+ *                   other commands work on persistent lists too.
+ * 17 Oct 2026 [AGT] Added the "appendn" and "appendrange" commands.
+ * 17 Oct 2026 [AGT] Added the "splice" and "concat" commands.
+ * 17 Oct 2026 [AGT] Added the "sort" command.
+ * 17 Oct 2026 [AGT] Added "sort list parallel [threads]".
+ * 17 Oct 2026 [AGT] Added the "stress" command, which tests CDList.c on several threads.
+ * 17 Oct 2026 [AGT] Added the "regstress" command, which tests ListMan.c on several threads.
+ * 17 Oct 2026 [AGT] Added parallel runs: given a thread count after the file names, ListTest runs commands on
+ *                   lists that share nothing on several threads, and writes their output in input order.
+ * 17 Oct 2026 [AGT] Added pipelined runs: given the word pipeline after the file names, ListTest reads the input,
+ *                   performs the commands, and writes the output on three threads at once.
+ * 17 Oct 2026 [AGT] Moved the "stress" and "regstress" commands to StressTest.c, so gCommands[] only holds
+ *                   list commands.
+ * 17 Oct 2026 [AGT] "copy" reports a source list that does not exist or a copy that failed.
+ * 17 Oct 2026 [AGT] A parallel run starts its threads once and hands them each batch, rather than starting
+ *                   threads for every batch. "sort" is a barrier, since it may start threads of its own.
+ * 17 Oct 2026 [AGT] Noted that parallel and pipelined runs are untested for speed-up.
  **************************************************************************************************************/
-#include <stdio.h>    /* For FILE, fprintf(), fscanf(), NULL */
-#include <stdlib.h>   /* For exit() */
+#define _POSIX_C_SOURCE 200112L  /* For pthread_create(), pthread_join(), etc. when compiling with -ansi */
+
+#include <pthread.h>  /* For pthread_cond_wait(), pthread_create(), pthread_join(), pthread_mutex_lock(), etc. */
+#include <stdio.h>    /* For fprintf(), NULL */
+#include <stdlib.h>   /* For atoi(), calloc(), exit(), free(), realloc() */
+#include <string.h>   /* For strlen() */
+#include "Intern.h"   /* For InternGetString(), InternString() */
 #include "ListMan.h"
+#include "Out.h"      /* For Out, OutClose(), OutFormat(), OutOpen() */
 #include "DList.h"
-#include "String.h"
+#include "PList.h"    /* For PList, PListAlloc(), PListSnapshot(), etc. */
+#include "Ring.h"     /* For Ring, RingAlloc(), RingFree(), RingPop(), RingPush() */
+#include "Scan.h"     /* For Scan, Token, ScanNextInt(), ScanNextToken(), ScanNextTokenOnLine(), etc. */
+#include "String.h"   /* For streq() */
+
+/*==============================================================================================================
+ * Preprocessor macro definitions.
+ *============================================================================================================*/
+#define CMD_SLOTS      64    /* Size of the command hash table. Must be a power of 2 >= the number of commands.    */
+#define CMD_MAX_SEEDS  4096  /* ListTestInit() gives up if none of this many seeds gives a perfect hash.           */
+#define APPEND_CHUNK   4096  /* "appendn" and "appendrange" append this many values at a time.                     */
+#define BATCH_CMDS     4096  /* Most commands a parallel run gathers before running them.                          */
+#define PARALLEL_MAX   64    /* Most threads a parallel run will use.                                              */
+#define CMD_BARRIER    1     /* The command runs alone, after the commands before it and before those after it.    */
+#define CMD_LINKS      2     /* The lists the command names share storage from then on.                            */
+#define CMD_PERSISTENT 4     /* The command makes a persistent list. They share the node pool of PList.c.          */
+#define PIPE_RING      65536 /* Most commands and operands read by a pipelined run and not yet performed.          */
+#define PIPE_BUFFERS   4     /* Number of writers a pipelined run passes between its last two stages.              */
+#define PIPE_CHUNK     65536 /* A writer is passed on once it holds this many characters.                          */
+
+#define METHOD_MERGE    0  /* The methods of "sort", see ListTestScanMethod(). */
+#define METHOD_RADIX    1
+#define METHOD_PARALLEL 2
+#define METHOD_UNKNOWN  3
+
+/*==============================================================================================================
+ * Typedefs.
+ *============================================================================================================*/
+/*--------------------------------------------------------------------------------------------------------------
+ * What a command handler reads its operands from and writes its results to. gIo, which a serial run uses for
+ * every command and a parallel run for its barrier commands, reads gScan and writes gOut. Each thread of a
+ * parallel run has one of its own, which reads a copy of gScan positioned at the operands of the command it
+ * is running and writes a memory writer (see OutOpenMem()). In a pipelined run, gIo reads the operands from
+ * gPipeIn, already converted by the reading stage, and writes the memory writers of gPipeOut[].
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct {
+    Scan *mIn;                    /* Scanner the operands are read from if mRing is NULL.                    */
+    Ring *mRing;                  /* Ring the operands are read from in a pipelined run, or NULL.            */
+    Out  *mOut;                   /* Writer the results go to.                                               */
+    int   mValues[APPEND_CHUNK];  /* Values read by "appendn" or made by "appendrange", waiting to be appended. */
+} ListTestIo;
+
+/*--------------------------------------------------------------------------------------------------------------
+ * An entry of the command table. mOperands spells out the operands that follow the command name, one letter
+ * each, so a parallel run can step over them and find the lists the command names, and a pipelined run can
+ * read them ahead of the command (see ListTestSkip()).
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct {
+    char  *mName;                    /* Name of the command as it appears in the test input file. */
+    char  *mOperands;                /* The operands, see ListTestSkip().                         */
+    int    mFlags;                   /* CMD_BARRIER, CMD_LINKS, and CMD_PERSISTENT, or 0.         */
+    void (*mHandler)(ListTestIo *);  /* Function that reads the operands and performs the command. */
+} ListTestCmd;
+
+/*--------------------------------------------------------------------------------------------------------------
+ * A command gathered by a parallel run. The commands of a batch are put into groups so that no two groups name
+ * lists that share anything. The commands of a group are linked through mNext in input order and one thread
+ * runs them in that order. mBegin and mEnd locate the output of the command in the memory writer of that
+ * thread.
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct {
+    ListTestCmd *mCmd;       /* The command.                                              */
+    char        *mOperands;  /* Where its operands start in the input.                    */
+    int          mNext;      /* Index in gJobs[] of the next command of its group, or -1. */
+    int          mWorker;    /* Index in gWorkers[] of the thread that ran it.            */
+    size_t       mBegin;     /* Offset of its output in the writer of that thread.        */
+    size_t       mEnd;       /* Offset of the end of its output.                          */
+} ListTestJob;
+
+typedef struct {
+    int mFirst;  /* Index in gJobs[] of the first command of the group.               */
+    int mLast;   /* Index in gJobs[] of the last command of the group.                */
+    int mKey;    /* Alias set of the lists it names, see ListTestAliasFind().         */
+} ListTestGroup;
+
+/*--------------------------------------------------------------------------------------------------------------
+ * A thread of a parallel run. gWorkers[0] is the main thread.
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct {
+    ListTestIo mIo;      /* What the thread's commands read and write. mIo.mIn points to mCursor. */
+    Scan       mCursor;  /* Copy of gScan positioned at the operands of the command being run.   */
+    int        mId;      /* Index of the thread in gWorkers[].                                   */
+} ListTestWorker;
 
 /*==============================================================================================================
  * Static function declarations.
  *============================================================================================================*/
 static void ListTest
     (
+    int  pThreads,
+    bool pPipeline
+    );
+
+static int ListTestAliasFind
+    (
+    int pNode
+    );
+
+static void ListTestAliasJoin
+    (
+    int pNode1,
+    int pNode2
+    );
+
+static bool ListTestAppendN
+    (
+    int        pListName,
+    const int *pData,
+    int        pCount
     );
 
 static void ListTestCmdAppend
     (
+    ListTestIo *pIo
+    );
+
+static void ListTestCmdAppendN
+    (
+    ListTestIo *pIo
+    );
+
+static void ListTestCmdAppendRange
+    (
+    ListTestIo *pIo
+    );
+
+static void ListTestCmdConcat
+    (
+    ListTestIo *pIo
     );
 
 /* Function declaration for ListTestCmdCopy() */
 static void ListTestCmdCopy
     (
+    ListTestIo *pIo
     );
 
 static void ListTestCmdCreate
     (
+    ListTestIo *pIo
     );
 
 static void ListTestCmdFind
     (
+    ListTestIo *pIo
     );
 
 /* Function declaration for ListTestCmdFindAt() */
 static void ListTestCmdFindAt
     (
+    ListTestIo *pIo
     );
 
 static void ListTestCmdFree
     (
+    ListTestIo *pIo
     );
 
-/* Function declaration for ListTestInsert() */
-static void ListTestInsert
+static void ListTestCmdHash
     (
+    ListTestIo *pIo
     );
 
-/* Function declaration for ListTestInsertAt() */
-static void ListTestInsertAt
+/* Function declaration for ListTestCmdInsert() */
+static void ListTestCmdInsert
+    (
+    ListTestIo *pIo
+    );
+
+/* Function declaration for ListTestCmdInsertAt() */
+static void ListTestCmdInsertAt
+    (
+    ListTestIo *pIo
+    );
+
+static void ListTestCmdPCreate
     (
+    ListTestIo *pIo
     );
 
 static void ListTestCmdPrint
     (
+    ListTestIo *pIo
     );
 
 /* Function declaration for ListTestCmdPrintRev() */
 static void ListTestCmdPrintRev
     (
+    ListTestIo *pIo
     );
 
-/* Function declaration for ListTestRemove() */
-static void ListTestRemove
+/* Function declaration for ListTestCmdRemove() */
+static void ListTestCmdRemove
     (
+    ListTestIo *pIo
     );
 
 /* Function declaration for ListTestCmdRemoveAt() */
 static void ListTestCmdRemoveAt
     (
-    )
+    ListTestIo *pIo
+    );
 
-static void ListTestFileClose
+static void ListTestCmdSnapshot
     (
-    FILE *pStream
+    ListTestIo *pIo
     );
 
-static FILE *ListTestFileOpen
+static void ListTestCmdSort
     (
-    char *pFileName, 
-    char *pMode, 
-    char *pMsg
+    ListTestIo *pIo
     );
 
-static void ListTestPerform
+static void ListTestCmdSplice
     (
-    char *pCmd
+    ListTestIo *pIo
+    );
+
+static unsigned ListTestHash
+    (
+    char    *pStr,
+    int      pLen,
+    unsigned pSeed
+    );
+
+static void ListTestInit
+    (
+    );
+
+static ListTestCmd *ListTestLookup
+    (
+    Token *pCmd
+    );
+
+static void ListTestParallel
+    (
+    int pThreads
+    );
+
+static void ListTestParallelBatch
+    (
+    ListTestWorker *pWorker
+    );
+
+static void ListTestParallelRun
+    (
+    int pThreads
+    );
+
+static void *ListTestParallelWorker
+    (
+    void *pWorker
+    );
+
+static void ListTestPipeline
+    (
+    );
+
+static void *ListTestPipelineReader
+    (
+    void *pUnused
+    );
+
+static void *ListTestPipelineWriter
+    (
+    void *pUnused
+    );
+
+static bool ListTestReadInt
+    (
+    ListTestIo *pIo,
+    int        *pInt
+    );
+
+static int ListTestReadMethod
+    (
+    ListTestIo *pIo,
+    int        *pThreads
+    );
+
+static int ListTestReadName
+    (
+    ListTestIo *pIo
+    );
+
+static int ListTestScanMethod
+    (
+    Scan *pScan,
+    int  *pThreads
+    );
+
+static int ListTestScanName
+    (
+    Scan *pScan
+    );
+
+static int ListTestSkip
+    (
+    Scan *pScan,
+    char *pOperands,
+    int  *pNames,
+    Ring *pRing
     );
 
 /*==============================================================================================================
  * Global variable definitions.
  *============================================================================================================*/
-static FILE *gFin;
-static FILE *gFout;
+static Scan *gScan;
+static Out  *gOut;
+static ListTestIo gIo;
+
+/*--------------------------------------------------------------------------------------------------------------
+ * The command table. To add a command, write its ListTestCmdXXX() handler and add one line here; nothing else
+ * needs to change. ListTestInit() builds gCmdSlot[] from this table. A command that creates or frees a list,
+ * makes lists share storage, or uses threads of its own (as "sort list parallel" does) is a barrier in a
+ * parallel run; any other command names one list, first.
+ *------------------------------------------------------------------------------------------------------------*/
+static ListTestCmd gCommands[] = {
+    { "append",      "ni",    0,                                        ListTestCmdAppend      },
+    { "appendn",     "nv",    0,                                        ListTestCmdAppendN     },
+    { "appendrange", "niii",  0,                                        ListTestCmdAppendRange },
+    { "concat",      "nn",    CMD_BARRIER | CMD_LINKS,                  ListTestCmdConcat      },
+    { "copy",        "nn",    CMD_BARRIER | CMD_LINKS,                  ListTestCmdCopy        },
+    { "create",      "n",     CMD_BARRIER,                              ListTestCmdCreate      },
+    { "find",        "ni",    0,                                        ListTestCmdFind        },
+    { "findat",      "ni",    0,                                        ListTestCmdFindAt      },
+    { "free",        "n",     CMD_BARRIER,                              ListTestCmdFree        },
+    { "hash",        "n",     0,                                        ListTestCmdHash        },
+    { "insert",      "nii",   0,                                        ListTestCmdInsert      },
+    { "insertat",    "nii",   0,                                        ListTestCmdInsertAt    },
+    { "pcreate",     "n",     CMD_BARRIER | CMD_PERSISTENT,             ListTestCmdPCreate     },
+    { "print",       "n",     0,                                        ListTestCmdPrint       },
+    { "printr",      "n",     0,                                        ListTestCmdPrintRev    },
+    { "remove",      "ni",    0,                                        ListTestCmdRemove      },
+    { "removeat",    "ni",    0,                                        ListTestCmdRemoveAt    },
+    { "snapshot",    "nn",    CMD_BARRIER | CMD_LINKS | CMD_PERSISTENT, ListTestCmdSnapshot    },
+    { "sort",        "ns",    CMD_BARRIER,                              ListTestCmdSort        },
+    { "splice",      "ninii", CMD_BARRIER | CMD_LINKS,                  ListTestCmdSplice      }
+};
+
+/*--------------------------------------------------------------------------------------------------------------
+ * gCmdSlot[ListTestHash(name, len, gCmdSeed)] is 1 + the index in gCommands[] of the command with that name, or
+ * 0 if no command hashes there. ListTestInit() picks gCmdSeed so no two commands share a slot, so looking up a
+ * command costs one hash and at most one string compare.
+ *------------------------------------------------------------------------------------------------------------*/
+static int      gCmdSlot[CMD_SLOTS];
+static unsigned gCmdSeed;
+
+/*--------------------------------------------------------------------------------------------------------------
+ * The state of a parallel run, see ListTestParallel(). gJobs[] and gGroups[] hold the batch being gathered.
+ * gAlias[] is a union-find forest of the lists: gAlias[0] stands for every persistent list and gAlias[id + 1]
+ * for the list with name id id. Lists in one tree may share storage, so their commands must run on one
+ * thread. gAliasGroup[root] is the index in gGroups[] of the group of the tree, or -1 if it has none yet.
+ *------------------------------------------------------------------------------------------------------------*/
+static ListTestJob     gJobs[BATCH_CMDS];
+static ListTestGroup   gGroups[BATCH_CMDS];
+static int             gJobCount;
+static int             gGroupCount;
+static int             gNextGroup;  /* Index in gGroups[] of the next group a thread will take. */
+static ListTestWorker *gWorkers;
+static int            *gAlias;
+static int            *gAliasGroup;
+static int             gAliasSlots;  /* Number of elements of gAlias[] and gAliasGroup[]. */
+
+/*--------------------------------------------------------------------------------------------------------------
+ * The threads of a parallel run, which are started once by ListTestParallel() and wait between batches. To hand
+ * them a batch, ListTestParallelRun() sets gParallelBusy to the number of threads and adds one to
+ * gParallelBatch; each thread runs its share and takes one off gParallelBusy, and the last one signals
+ * gParallelDone. gParallelQuit tells them to return. All of these are guarded by gParallelLock.
+ *------------------------------------------------------------------------------------------------------------*/
+static pthread_mutex_t gParallelLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  gParallelWake = PTHREAD_COND_INITIALIZER;  /* Signaled when a batch is ready or on quit. */
+static pthread_cond_t  gParallelDone = PTHREAD_COND_INITIALIZER;  /* Signaled when gParallelBusy reaches 0.    */
+static pthread_t       gParallelThreads[PARALLEL_MAX];
+static int             gParallelStarted;  /* Number of threads started, not counting this one.               */
+static int             gParallelBatch;    /* Number of batches handed to the threads so far.                 */
+static int             gParallelBusy;     /* Number of threads still running the current batch.              */
+static bool            gParallelQuit;     /* True once the threads are to return.                            */
+
+/*--------------------------------------------------------------------------------------------------------------
+ * The rings between the stages of a pipelined run, see ListTestPipeline(). gPipeIn carries the commands and
+ * their operands from the reading stage to the executing stage. gPipeFull carries the index in gPipeOut[] of
+ * each writer the executing stage has filled to the writing stage, and gPipeFree carries it back once the
+ * writing stage has written it out.
+ *------------------------------------------------------------------------------------------------------------*/
+static Ring *gPipeIn;
+static Ring *gPipeFull;
+static Ring *gPipeFree;
+static Out  *gPipeOut[PIPE_BUFFERS];
 
 /*==============================================================================================================
  * Function definitions.
@@ -118,7 +455,8 @@ static FILE *gFout;
 /*--------------------------------------------------------------------------------------------------------------
  * FUNCT: main
  * DESCR: Starting point of execution. Opens the input and output files and calls ListTest() to perform the
- *        testing. On return, closes the input and output files and terminates.
+ *        testing, on the number of threads given after the file names, or one, or pipelined if the word pipeline
+ *        is given instead. On return, closes the input and output files and terminates.
  *------------------------------------------------------------------------------------------------------------*/
 int main
     (
@@ -126,26 +464,101 @@ int main
     char *pArgv[]
     )
 {
-    if (pArgc < 3) {
-        fprintf(stderr, "Usage: ListTest inputfile outputfile\n");
+    bool pipeline = pArgc > 3 && streq(pArgv[3], "pipeline");
+    int threads = pArgc > 3 && !pipeline ? atoi(pArgv[3]) : 1;
+    if (pArgc < 3 || threads < 1 || threads > PARALLEL_MAX) {
+        fprintf(stderr, "Usage: ListTest inputfile outputfile [threads | pipeline]\n");
         exit(-1);
     }
-    gFin = ListTestFileOpen(pArgv[1], "rt", "reading");
-    gFout = ListTestFileOpen(pArgv[2], "wt", "writing");
-    ListTest();
-    ListTestFileClose(gFin);
-    ListTestFileClose(gFout);
+    if (!(gScan = ScanOpen(pArgv[1]))) {
+        fprintf(stdout, "Cannot open '%s' for reading. Terminating.\n", pArgv[1]);
+        exit(-1);
+    }
+    if (!(gOut = OutOpen(pArgv[2]))) {
+        fprintf(stdout, "Cannot open '%s' for writing. Terminating.\n", pArgv[2]);
+        exit(-1);
+    }
+    ListTest(threads, pipeline);
+    gScan = ScanClose(gScan);
+    gOut = OutClose(gOut);
     return 0;
 }
 
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestAliasFind
+ * DESCR: Returns the root of the tree of node pNode in gAlias[], growing gAlias[] and gAliasGroup[] first if
+ *        pNode is past their end. The new nodes are trees of their own with no group. Halves the path from
+ *        pNode to the root on the way up. If memory cannot be allocated, displays an error message and
+ *        terminates.
+ *------------------------------------------------------------------------------------------------------------*/
+static int ListTestAliasFind
+    (
+    int pNode
+    )
+{
+    int slots = gAliasSlots ? gAliasSlots : 64;
+    if (pNode >= gAliasSlots) {
+        while (slots <= pNode) slots *= 2;
+        gAlias = (int *)realloc(gAlias, slots * sizeof(int));
+        gAliasGroup = (int *)realloc(gAliasGroup, slots * sizeof(int));
+        if (!gAlias || !gAliasGroup) {
+            fprintf(stderr, "Error, cannot grow the list aliases to %d lists\n", slots);
+            exit(-1);
+        }
+        for (; gAliasSlots < slots; ++gAliasSlots) {
+            gAlias[gAliasSlots] = gAliasSlots;
+            gAliasGroup[gAliasSlots] = -1;
+        }
+    }
+    while (gAlias[pNode] != pNode) pNode = gAlias[pNode] = gAlias[gAlias[pNode]];
+    return pNode;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestAliasJoin
+ * DESCR: Joins the trees of nodes pNode1 and pNode2 of gAlias[]. Only called between batches, when no tree has
+ *        a group.
+ *------------------------------------------------------------------------------------------------------------*/
+static void ListTestAliasJoin
+    (
+    int pNode1,
+    int pNode2
+    )
+{
+    pNode1 = ListTestAliasFind(pNode1);
+    pNode2 = ListTestAliasFind(pNode2);
+    gAlias[pNode1] = pNode2;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestAppendN
+ * DESCR: Appends the pCount values of pData to the list named by pListName, with DListAppendN() for a DList or
+ *        PListAppend() for a persistent list. Returns true if every value was appended.
+ *------------------------------------------------------------------------------------------------------------*/
+static bool ListTestAppendN
+    (
+    int        pListName,
+    const int *pData,
+    int        pCount
+    )
+{
+    PList *version = ListManGetVersion(pListName);
+    int i;
+    if (!version) return DListAppendN(ListManGetList(pListName), pData, (size_t)pCount) != NULL;
+    for (i = 0; i < pCount; ++i) {
+        if (!PListAppend(version, pData[i])) return false;
+    }
+    return true;
+}
+
 /*--------------------------------------------------------------------------------------------------------------
  * FUNCT: ListTestCmdAppend
  * DESCR: Performs the "append list data" command. Prints the list after appending so it can be inspected to
  *        determine if the DListAppend() function worked correctly.
  * PCODE:
- * Read the listname and data value from gFin.
- * list <- ListManGetList(listname)
- * If DListAppend(list, data) succeeds Then
+ * Read the listname and data value from pIo.
+ * If listname is a persistent list Then done <- PListAppend(version, data) Else done <- DListAppend(list, data)
+ * If done Then
  *     Print "appended ..."
  * Else
  *     Print "failed ..."
@@ -153,15 +566,137 @@ int main
  *------------------------------------------------------------------------------------------------------------*/
 static void ListTestCmdAppend
     (
+    ListTestIo *pIo
     )
 {
-    char listname[8];
+    int listname;
     int data;
-    DList *list;
-    fscanf(gFin, "%s%d", listname, &data);
-    list = ListManGetList(listname);
-    if (DListAppend(list, data)) fprintf(gFout, "appended %d to %s\n", data, listname);
-    else fprintf(gFout, "failed to append %d to %s\n", data, listname);
+    PList *version;
+    bool done;
+    listname = ListTestReadName(pIo);
+    ListTestReadInt(pIo, &data);
+    if ((version = ListManGetVersion(listname))) done = PListAppend(version, data) != NULL;
+    else done = DListAppend(ListManGetList(listname), data) != NULL;
+    if (done) OutFormat(pIo->mOut, "appended %d to %s\n", data, InternGetString(listname));
+    else OutFormat(pIo->mOut, "failed to append %d to %s\n", data, InternGetString(listname));
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestCmdAppendN
+ * DESCR: Performs the "appendn list count v1 v2 ..." command, which appends count values to the list with
+ *        DListAppendN() and prints one line for all of them. The values are read and appended APPEND_CHUNK at a
+ *        time, so count may be larger than pIo->mValues[].
+ * PCODE:
+ * Read the listname and count from pIo.
+ * While fewer than count values have been read Do
+ *     Read the next chunk of up to APPEND_CHUNK values into pIo->mValues[]
+ *     If every chunk so far was appended Then Call ListTestAppendN() to append this one
+ * End While
+ * If every chunk was appended Then
+ *     Print "appended ..."
+ * Else
+ *     Print "failed ..."
+ * End If
+ *------------------------------------------------------------------------------------------------------------*/
+static void ListTestCmdAppendN
+    (
+    ListTestIo *pIo
+    )
+{
+    int listname;
+    int count, chunk, i, read;
+    bool done = true;
+    listname = ListTestReadName(pIo);
+    ListTestReadInt(pIo, &count);
+    for (read = 0; read < count; read += chunk) {
+        chunk = count - read < APPEND_CHUNK ? count - read : APPEND_CHUNK;
+        for (i = 0; i < chunk; ++i) ListTestReadInt(pIo, &pIo->mValues[i]);
+        if (done) done = ListTestAppendN(listname, pIo->mValues, chunk);
+    }
+    if (done && count >= 0) OutFormat(pIo->mOut, "appended %d values to %s\n", count, InternGetString(listname));
+    else OutFormat(pIo->mOut, "failed to append %d values to %s\n", count, InternGetString(listname));
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestCmdAppendRange
+ * DESCR: Performs the "appendrange list start end step" command, which appends start, start + step, start +
+ *        2 * step, ... up to but not including end, and prints one line for all of them. A negative step counts
+ *        down. Fails if step is 0.
+ * PCODE:
+ * Read the listname, start, end, and step from pIo.
+ * For value <- start, start + step, ... while value has not reached end Do
+ *     Store value in pIo->mValues[]; when it is full, Call ListTestAppendN() to append it and empty it
+ * End For
+ * Call ListTestAppendN() to append what is left in pIo->mValues[].
+ * If step is not 0 and every append succeeded Then
+ *     Print "appended ..."
+ * Else
+ *     Print "failed ..."
+ * End If
+ *------------------------------------------------------------------------------------------------------------*/
+static void ListTestCmdAppendRange
+    (
+    ListTestIo *pIo
+    )
+{
+    int listname;
+    int start, end, step, count = 0, chunk = 0;
+    long value;
+    bool done;
+    listname = ListTestReadName(pIo);
+    ListTestReadInt(pIo, &start);
+    ListTestReadInt(pIo, &end);
+    ListTestReadInt(pIo, &step);
+    done = step != 0;
+    for (value = start; done && (step > 0 ? value < end : value > end); value += step) {
+        pIo->mValues[chunk++] = (int)value;
+        if (chunk == APPEND_CHUNK) {
+            done = ListTestAppendN(listname, pIo->mValues, chunk);
+            count += chunk;
+            chunk = 0;
+        }
+    }
+    if (done && chunk) done = ListTestAppendN(listname, pIo->mValues, chunk);
+    count += chunk;
+    if (done) {
+        OutFormat(pIo->mOut, "appended %d values to %s\n", count, InternGetString(listname));
+    } else {
+        OutFormat(pIo->mOut, "failed to append range %d %d %d to %s\n", start, end, step, InternGetString(listname));
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestCmdConcat
+ * DESCR: Performs the "concat dst src" command, which moves every element of src to the end of dst, leaving src
+ *        empty. Both lists stay in the list manager database. Fails if either list is a persistent list.
+ * PCODE:
+ * Read dstlistname and srclistname from pIo
+ * If neither list is a persistent list and DListConcat(dstlist, srclist) succeeds Then
+ *     Print "concatenated ..."
+ * Else
+ *     Print "failed ..."
+ * End If
+ *------------------------------------------------------------------------------------------------------------*/
+static void ListTestCmdConcat
+    (
+    ListTestIo *pIo
+    )
+{
+    int dstlistname;
+    int srclistname;
+    DList *dstlist;
+    DList *srclist;
+    dstlistname = ListTestReadName(pIo);
+    srclistname = ListTestReadName(pIo);
+    dstlist = ListManGetList(dstlistname);
+    srclist = ListManGetList(srclistname);
+    if (dstlist && srclist && DListConcat(dstlist, srclist)) {
+        OutFormat(pIo->mOut, "concatenated %s onto %s\n", InternGetString(srclistname),
+            InternGetString(dstlistname));
+    } else {
+        OutFormat(pIo->mOut, "failed to concatenate %s onto %s\n", InternGetString(srclistname),
+            InternGetString(dstlistname));
+    }
 }
 
 /*--------------------------------------------------------------------------------------------------------------
@@ -169,32 +704,53 @@ static void ListTestCmdAppend
  * DESCR: Performs the "copy dst src" command. Prints the destination list after copying so it can be inspected
  *        to etermine if the dlist_copy() function worked correctly.
  * PCODE:
- * Read dstlistname and srclistname from gFin 
- * srclist <- ListManGetList(srclistname)
- * dstlist <- DListCopy(srclist)
- * Call ListManCreateList() to add the dstlist to the list manager database.
- * Print "copied ..."
+ * Read dstlistname and srclistname from pIo 
+ * If srclistname is a persistent list Then
+ *     dstversion <- PListCopy(srcversion)
+ *     Call ListManCreateVersion() to add dstversion to the list manager database.
+ * Else If srclistname is a list Then
+ *     dstlist <- DListCopy(srclist)
+ *     Call ListManCreateList() to add the dstlist to the list manager database.
+ * Else
+ *     Print " ... does not exist" and return
+ * End If
+ * If the copy was made Then Print "copied ..." Else Print "failed to copy ..."
  *------------------------------------------------------------------------------------------------------------*/
 static void ListTestCmdCopy
     (
+    ListTestIo *pIo
     )
 {
-    char dstlistname[8];
-    char srclistname[8];
+    int dstlistname;
+    int srclistname;
     DList *srclist;
-    Dlist *dstlist;
-    fscanf(gFin, "%s%s", dstlistname, srclistname);
-    srclist = ListManGetList(srclistname);
-    dstlist = DListCopy(srclist);
-    ListManCreateList(dstlistname, dstlist);
-    fprintf(gFout, "copied %s to %s", dstlist, dstlistname);
+    DList *dstlist;
+    PList *srcversion;
+    PList *dstversion;
+    bool copied;
+    dstlistname = ListTestReadName(pIo);
+    srclistname = ListTestReadName(pIo);
+    if ((srcversion = ListManGetVersion(srclistname))) {
+        dstversion = PListCopy(srcversion);
+        copied = dstversion != NULL;
+        ListManCreateVersion(dstlistname, dstversion);
+    } else if ((srclist = ListManGetList(srclistname))) {
+        dstlist = DListCopy(srclist);
+        copied = dstlist != NULL;
+        ListManCreateList(dstlistname, dstlist);
+    } else {
+        OutFormat(pIo->mOut, "%s does not exist\n", InternGetString(srclistname));
+        return;
+    }
+    OutFormat(pIo->mOut, "%s %s to %s\n", copied ? "copied" : "failed to copy", InternGetString(srclistname),
+        InternGetString(dstlistname));
 }
 
 /*--------------------------------------------------------------------------------------------------------------
  * FUNCT: ListTestCmdCreate
  * DESCR: Performs the "create list" command.
  * PCODE:
- * Read the listname from gFin.
+ * Read the listname from pIo.
  * new_list <- DListAlloc()
  * If the new list was created Then
  *     Call ListManCreateList() to add new_list to the list manager database.
@@ -205,16 +761,17 @@ static void ListTestCmdCopy
  *------------------------------------------------------------------------------------------------------------*/
 static void ListTestCmdCreate
     (
+    ListTestIo *pIo
     )
 {
-    char listname[8];
-    fscanf(gFin, "%s", listname);
+    int listname;
+    listname = ListTestReadName(pIo);
     DList *new_list = DListAlloc();
     if (new_list) {
         ListManCreateList(listname, new_list);
-        fprintf(gFout, "%s created\n", listname);
+        OutFormat(pIo->mOut, "%s created\n", InternGetString(listname));
     } else {
-        fprintf(gFout, "failed to create %s\n", listname);
+        OutFormat(pIo->mOut, "failed to create %s\n", InternGetString(listname));
     }
 }
 
@@ -222,10 +779,10 @@ static void ListTestCmdCreate
  * FUNCT: ListTestCmdFind
  * DESCR: Performs the "find list data" command.
  * PCODE:
- * Read the listname and data from gFin
- * list <- ListManGetList(listname)
- * found_node <- DListFindData(list, data)
- * If found_node is not null Then
+ * Read the listname and data from pIo
+ * If listname is a persistent list Then found <- PListFindData(version, data)
+ * Else found <- DListFindData(list, data)
+ * If found is not null Then
  *     Print "found ..."
  * Else
  *     Print *failed ..."
@@ -233,27 +790,29 @@ static void ListTestCmdCreate
  *------------------------------------------------------------------------------------------------------------*/
 static void ListTestCmdFind
     (
+    ListTestIo *pIo
     )
 {
-    char listname[8];
+    int listname;
     int data;
-    DList *list;
-    DListNode *found_node;
-    fscanf(gFin, "%s%d", listname, &data);
-    list = ListManGetList(listname);
-    found_node = DListFindData(list, data);
-    if (found_node) fprintf(gFout, "found %d in %s\n", data, listname);
-    else fprintf(gFout, "failed to find %d in %s\n", data, listname);
+    PList *version;
+    bool found;
+    listname = ListTestReadName(pIo);
+    ListTestReadInt(pIo, &data);
+    if ((version = ListManGetVersion(listname))) found = PListFindData(version, data) != NULL;
+    else found = DListFindData(ListManGetList(listname), data) != NULL;
+    if (found) OutFormat(pIo->mOut, "found %d in %s\n", data, InternGetString(listname));
+    else OutFormat(pIo->mOut, "failed to find %d in %s\n", data, InternGetString(listname));
 }
 
 /*--------------------------------------------------------------------------------------------------------------
  * FUNCT: ListTestCmdFindAt
  * DESCR: Performs the "findat list index" command.
  * PCODE:
- * Read the listname and index from gFin
- * list <- ListManGetList(listname)
- * found_node <- DListFindIndex(list, index)
- * If found_node is not null Then
+ * Read the listname and index from pIo
+ * If listname is a persistent list Then found <- PListFindIndex(version, index)
+ * Else found <- DListFindIndex(list, index)
+ * If found is not null Then
  *     Print "found ..."
  * Else
  *     Print "failed to findat ..."
@@ -261,27 +820,30 @@ static void ListTestCmdFind
  *------------------------------------------------------------------------------------------------------------*/
 static void ListTestCmdFindAt
     (
+    ListTestIo *pIo
     )
 {
-    char listname[8];
+    int listname;
     int index;
-    DList *list;
-    DListNode *found_node;
-    fscanf(gFin, "%s%d", listname, &index);
-    list = ListManGetList(listname);
-    found_node = DListFindIndex(list, index);
-    if (found_node) fprintf(gFout, "found index %d in %s\n", index, listname);
-    else fprintf(gFout, "failed to find index %d in %s\n", index, listname);
+    PList *version;
+    bool found;
+    listname = ListTestReadName(pIo);
+    ListTestReadInt(pIo, &index);
+    if ((version = ListManGetVersion(listname))) found = PListFindIndex(version, index) != NULL;
+    else found = DListFindIndex(ListManGetList(listname), index) != NULL;
+    if (found) OutFormat(pIo->mOut, "found index %d in %s\n", index, InternGetString(listname));
+    else OutFormat(pIo->mOut, "failed to find index %d in %s\n", index, InternGetString(listname));
 }
 
 /*--------------------------------------------------------------------------------------------------------------
  * FUNCT: ListTestCmdFree
  * DESCR: Performs the "free list" command.
  * PCODE:
- * Read the listname from gFin.
+ * Read the listname from pIo.
  * list <- ListManGetList(listname)
- * If list is not null Then
- *     list <- DListFree(list)
+ * version <- ListManGetVersion(listname)
+ * If list or version is not null Then
+ *     Call DListFree(list) and PListFree(version)
  *     ListManFreeList(listname)
  *     Print "freed ..."
  * Else
@@ -290,18 +852,49 @@ static void ListTestCmdFindAt
  *------------------------------------------------------------------------------------------------------------*/
 static void ListTestCmdFree
     (
+    ListTestIo *pIo
     )
 {
-    char listname[8];
+    int listname;
     DList *list;
-    fscanf(gFin, "%s", listname);
+    PList *version;
+    listname = ListTestReadName(pIo);
     list = ListManGetList(listname);
-    if (list) {
+    version = ListManGetVersion(listname);
+    if (list || version) {
         list = DListFree(list); /* Sanity check. list will be NULL. */
+        version = PListFree(version);
         ListManFreeList(listname);
-        fprintf(gFout, "freed %s\n", listname);
+        OutFormat(pIo->mOut, "freed %s\n", InternGetString(listname));
+    } else {
+        OutFormat(pIo->mOut, "error: %s does not exist\n", InternGetString(listname));
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestCmdHash
+ * DESCR: Performs the "hash list" command, which makes the list keep a value index so find, insert, and remove
+ *        do not have to scan it. Persistent lists do not have a value index, so the command fails on them.
+ * PCODE:
+ * Read the listname from pIo.
+ * list <- ListManGetList(listname)
+ * If listname is not a persistent list AND DListIndexValues(list) succeeds Then
+ *     Print "hashed ..."
+ * Else
+ *     Print "failed ..."
+ * End If
+ *------------------------------------------------------------------------------------------------------------*/
+static void ListTestCmdHash
+    (
+    ListTestIo *pIo
+    )
+{
+    int listname;
+    listname = ListTestReadName(pIo);
+    if (!ListManGetVersion(listname) && DListIndexValues(ListManGetList(listname))) {
+        OutFormat(pIo->mOut, "hashed %s\n", InternGetString(listname));
     } else {
-        fprintf(gFout, "error: %s does not exist\n", listname);
+        OutFormat(pIo->mOut, "failed to hash %s\n", InternGetString(listname));
     }
 }
 
@@ -309,9 +902,10 @@ static void ListTestCmdFree
  * FUNCT: ListTestCmdInsert
  * DESCR: Performs the "insert list data" command.
  * PCODE:
- * Read the listname, before, data from gFin.
- * list <- ListManGetList(listname)
- * If DListInsertBefore(list, before, data) succeeds Then
+ * Read the listname, before, data from pIo.
+ * If listname is a persistent list Then done <- PListInsertBefore(version, before, data)
+ * Else done <- DListInsertBefore(list, before, data)
+ * If done Then
  *     Print "inserted ..."
  * Else
  *     Print "failed ..."
@@ -319,16 +913,22 @@ static void ListTestCmdFree
  *------------------------------------------------------------------------------------------------------------*/
 static void ListTestCmdInsert
     (
+    ListTestIo *pIo
     )
 {
-    char listname[8];
+    int listname;
     int before, data;
-    fscanf(gFin, "%s%d%d", listname, &before, &data);
-    DList *list = ListManGetList(listname);
-    if (DListInsertBefore(list, before, data)) {
-        fprintf(gFout, "inserted %d before %d in %s\n", data, before, listname);
+    listname = ListTestReadName(pIo);
+    ListTestReadInt(pIo, &before);
+    ListTestReadInt(pIo, &data);
+    PList *version = ListManGetVersion(listname);
+    bool done;
+    if (version) done = PListInsertBefore(version, before, data) != NULL;
+    else done = DListInsertBefore(ListManGetList(listname), before, data) != NULL;
+    if (done) {
+        OutFormat(pIo->mOut, "inserted %d before %d in %s\n", data, before, InternGetString(listname));
     } else {
-        fprintf(gFout, "failed to insert %d before %d in %s\n", data, before, listname);
+        OutFormat(pIo->mOut, "failed to insert %d before %d in %s\n", data, before, InternGetString(listname));
     }
 }
 
@@ -336,9 +936,10 @@ static void ListTestCmdInsert
  * FUNCT: ListTestCmdInsertAt
  * DESCR: Performs the "insertat list index data" command.
  * PCODE:
- * Read the listname, index, data from gFin.
- * list <- ListManGetList(listname)
- * If DListInsertIndex(list, index, data) succeeds Then
+ * Read the listname, index, data from pIo.
+ * If listname is a persistent list Then done <- PListInsertIndex(version, index, data)
+ * Else done <- DListInsertIndex(list, index, data)
+ * If done Then
  *     Print "inserted ..."
  * Else
  *     Print "failed ..."
@@ -346,16 +947,52 @@ static void ListTestCmdInsert
  *------------------------------------------------------------------------------------------------------------*/
 static void ListTestCmdInsertAt
     (
+    ListTestIo *pIo
     )
 {
-    char listname[8];
+    int listname;
     int index, data;
-    fscanf(gFin, "%s%d%d", listname, &index, &data);
-    DList *list = ListManGetList(listname);
-    if (DListInsertIndex(list, index, data)) {
-        fprintf(gFout, "inserted %d at index %d in %s\n", data, index, listname);
+    listname = ListTestReadName(pIo);
+    ListTestReadInt(pIo, &index);
+    ListTestReadInt(pIo, &data);
+    PList *version = ListManGetVersion(listname);
+    bool done;
+    if (version) done = PListInsertIndex(version, index, data) != NULL;
+    else done = DListInsertIndex(ListManGetList(listname), index, data) != NULL;
+    if (done) {
+        OutFormat(pIo->mOut, "inserted %d at index %d in %s\n", data, index, InternGetString(listname));
+    } else {
+        OutFormat(pIo->mOut, "failed to insert %d at index %d in %s\n", data, index, InternGetString(listname));
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestCmdPCreate
+ * DESCR: Performs the "pcreate list" command, which creates an empty persistent list. See PList.c.
+ * PCODE:
+ * Read the listname from pIo.
+ * new_version <- PListAlloc()
+ * If the new list was created Then
+ *     Call ListManCreateVersion() to add new_version to the list manager database.
+ *     Print listname " created"
+ * Else
+ *     Print "failed to create ..." listname.
+ * EndIf
+ *------------------------------------------------------------------------------------------------------------*/
+static void ListTestCmdPCreate
+    (
+    ListTestIo *pIo
+    )
+{
+    int listname;
+    PList *new_version;
+    listname = ListTestReadName(pIo);
+    new_version = PListAlloc();
+    if (new_version) {
+        ListManCreateVersion(listname, new_version);
+        OutFormat(pIo->mOut, "%s created\n", InternGetString(listname));
     } else {
-        fprintf(gFout, "failed to insert %d at index %d in %s\n", data, index, listname);
+        OutFormat(pIo->mOut, "failed to create %s\n", InternGetString(listname));
     }
 }
 
@@ -365,7 +1002,8 @@ static void ListTestCmdInsertAt
  * PCODE:
  * Read the listname from the input file
  * list <- ListManGetList(listname)
- * If list is not null Then
+ * version <- ListManGetVersion(listname)
+ * If list or version is not null Then
  *     Output the list
  * Else
  *     Print " ... does not exist"
@@ -373,17 +1011,23 @@ static void ListTestCmdInsertAt
  *------------------------------------------------------------------------------------------------------------*/
 static void ListTestCmdPrint
     (
+    ListTestIo *pIo
     )
 {
-    char listname[8];
-    fscanf(gFin, "%s", listname);
+    int listname;
+    listname = ListTestReadName(pIo);
     DList *list = ListManGetList(listname);
-    if (list) {
-        fprintf(gFout, "%s = ", listname);
-        DListDebugPrint(gFout, list);
-        fprintf(gFout, "\n");
+    PList *version = ListManGetVersion(listname);
+    if (version) {
+        OutFormat(pIo->mOut, "%s = ", InternGetString(listname));
+        PListDebugPrint(pIo->mOut, version);
+        OutFormat(pIo->mOut, "\n");
+    } else if (list) {
+        OutFormat(pIo->mOut, "%s = ", InternGetString(listname));
+        DListDebugPrint(pIo->mOut, list);
+        OutFormat(pIo->mOut, "\n");
     } else {
-        fprintf(gFout, "%s does not exist\n", listname);
+        OutFormat(pIo->mOut, "%s does not exist\n", InternGetString(listname));
     }
 }
 
@@ -393,7 +1037,8 @@ static void ListTestCmdPrint
  * PCODE:
  * Read the listname from the input file
  * list <- ListManGetList(listname)
- * If list is not null Then
+ * version <- ListManGetVersion(listname)
+ * If list or version is not null Then
  *     Output the list in reverse order
  * Else
  *     Print " ... does not exist"
@@ -401,17 +1046,23 @@ static void ListTestCmdPrint
  *------------------------------------------------------------------------------------------------------------*/
 static void ListTestCmdPrintRev
     (
+    ListTestIo *pIo
     )
 {
-    char listname[8];
-    fscanf(gFin, "%s", listname);
+    int listname;
+    listname = ListTestReadName(pIo);
     DList *list = ListManGetList(listname);
-    if (list) {
-        fprintf(gFout, "%s = ", listname);
-        DListDebugPrintRev(gFout, list);
-        fprintf(gFout, "\n");
+    PList *version = ListManGetVersion(listname);
+    if (version) {
+        OutFormat(pIo->mOut, "%s = ", InternGetString(listname));
+        PListDebugPrintRev(pIo->mOut, version);
+        OutFormat(pIo->mOut, "\n");
+    } else if (list) {
+        OutFormat(pIo->mOut, "%s = ", InternGetString(listname));
+        DListDebugPrintRev(pIo->mOut, list);
+        OutFormat(pIo->mOut, "\n");
     } else {
-        fprintf(gFout, "%s does not exist\n", listname);
+        OutFormat(pIo->mOut, "%s does not exist\n", InternGetString(listname));
     }
 }
 
@@ -419,9 +1070,10 @@ static void ListTestCmdPrintRev
  * FUNCT: ListTestCmdRemove
  * DESCR Performs the "remove list data" command.
  * PCODE:
- * Read the listname and data from gFin.
- * list <- ListManGetList(listname)
- * If DListRemoveData(list, data) succeeds Then
+ * Read the listname and data from pIo.
+ * If listname is a persistent list Then done <- PListRemoveData(version, data)
+ * Else done <- DListRemoveData(list, data)
+ * If done Then
  *     Print "removed ..."
  * Else
  *     Print "failed ..."
@@ -429,24 +1081,32 @@ static void ListTestCmdPrintRev
  *------------------------------------------------------------------------------------------------------------*/
 static void ListTestCmdRemove
     (
+    ListTestIo *pIo
     )
 {
-    char listname[8];
+    int listname;
     int data;
-    DList *list;
-    fscanf(gFin, "%s%d", listname, &data);
-    list = ListManGetList(listname);
-    if (DListRemoveData(list, data)) fprintf(gFout, "removed %d from %s\n", data, listname);
-    else fprintf(gFout, "failed to remove %d from %s\n", data, listname);
+    PList *version;
+    bool done;
+    listname = ListTestReadName(pIo);
+    ListTestReadInt(pIo, &data);
+    if ((version = ListManGetVersion(listname))) done = PListRemoveData(version, data) != NULL;
+    else done = DListRemoveData(ListManGetList(listname), data) != NULL;
+    if (done) {
+        OutFormat(pIo->mOut, "removed %d from %s\n", data, InternGetString(listname));
+    } else {
+        OutFormat(pIo->mOut, "failed to remove %d from %s\n", data, InternGetString(listname));
+    }
 }
 
 /*--------------------------------------------------------------------------------------------------------------
  * FUNCT: ListTestCmdRemoveAt
  * DESCR Performs the "removeat list data" command.
  * PCODE:
- * Read the listname and index from gFin.
- * list <- ListManGetList(listname)
- * If DListRemoveIndex(list, index) succeeds Then
+ * Read the listname and index from pIo.
+ * If listname is a persistent list Then done <- PListRemoveIndex(version, index)
+ * Else done <- DListRemoveIndex(list, index)
+ * If done Then
  *     Print "removed ..."
  * Else
  *     Print "failed ..."
@@ -454,87 +1114,659 @@ static void ListTestCmdRemove
  *------------------------------------------------------------------------------------------------------------*/
  static void ListTestCmdRemoveAt
     (
+    ListTestIo *pIo
     )
 {
-    char listname[8];
+    int listname;
     int index;
+    PList *version;
+    bool done;
+    listname = ListTestReadName(pIo);
+    ListTestReadInt(pIo, &index);
+    if ((version = ListManGetVersion(listname))) done = PListRemoveIndex(version, index) != NULL;
+    else done = DListRemoveIndex(ListManGetList(listname), index) != NULL;
+    if (done) {
+        OutFormat(pIo->mOut, "removed %d from %s\n", index, InternGetString(listname));
+    } else {
+        OutFormat(pIo->mOut, "failed to remove %d from %s\n", index, InternGetString(listname));
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestCmdSnapshot
+ * DESCR: Performs the "snapshot list name" command, which saves the current version of the persistent list as a
+ *        read-only list called name in O(1) time. Fails if list is not a persistent list.
+ * PCODE:
+ * Read the listname and snapshotname from pIo.
+ * version <- ListManGetVersion(listname)
+ * snapshot <- PListSnapshot(version)
+ * If snapshot is not null Then
+ *     Call ListManCreateVersion() to add snapshot to the list manager database.
+ *     Print "took snapshot ..."
+ * Else
+ *     Print "failed ..."
+ * End If
+ *------------------------------------------------------------------------------------------------------------*/
+static void ListTestCmdSnapshot
+    (
+    ListTestIo *pIo
+    )
+{
+    int listname;
+    int snapshotname;
+    PList *snapshot;
+    listname = ListTestReadName(pIo);
+    snapshotname = ListTestReadName(pIo);
+    snapshot = PListSnapshot(ListManGetVersion(listname));
+    if (snapshot) {
+        ListManCreateVersion(snapshotname, snapshot);
+        OutFormat(pIo->mOut, "took snapshot %s of %s\n", InternGetString(snapshotname), InternGetString(listname));
+    } else {
+        OutFormat(pIo->mOut, "failed to snapshot %s\n", InternGetString(listname));
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestCmdSort
+ * DESCR: Performs the "sort list [merge|radix|parallel [threads]]" command, which sorts the list into ascending
+ *        order with the merge sort of DListSort(), or with the radix sort of DListSortRadix() if the word radix
+ *        follows the list name on the same line, or on several threads with DListSortParallel() if the word
+ *        parallel does. The parallel sort uses the number of threads that follows it, or one per processor if
+ *        there is none. Fails if list is a persistent list or the method is not merge, radix, or parallel.
+ * PCODE:
+ * Read the listname and the method from pIo, and the number of threads if the method is parallel
+ * If the list is not a persistent list and the method is merge, radix, or parallel and sorting succeeds Then
+ *     Print "sorted ..."
+ * Else
+ *     Print "failed ..."
+ * End If
+ *------------------------------------------------------------------------------------------------------------*/
+static void ListTestCmdSort
+    (
+    ListTestIo *pIo
+    )
+{
+    int listname, method, threads;
     DList *list;
-    fscanf(gFin, "%s%d", listname, &index);
+    char *how = "";
+    bool done = false;
+    listname = ListTestReadName(pIo);
+    method = ListTestReadMethod(pIo, &threads);
     list = ListManGetList(listname);
-    if (DListRemoveIndex(list, index)) fprintf(gFout, "removed %d from %s\n", index, listname);
-    else fprintf(gFout, "failed to remove %d from %s\n", index, listname);
+    if (method == METHOD_MERGE) {
+        done = list && DListSort(list);
+    } else if (method == METHOD_RADIX) {
+        how = " by radix sort";
+        done = list && DListSortRadix(list);
+    } else if (method == METHOD_PARALLEL) {
+        how = " in parallel";
+        done = list && DListSortParallel(list, threads);
+    }
+    if (done) {
+        OutFormat(pIo->mOut, "sorted %s%s\n", InternGetString(listname), how);
+    } else {
+        OutFormat(pIo->mOut, "failed to sort %s\n", InternGetString(listname));
+    }
 }
 
 /*--------------------------------------------------------------------------------------------------------------
- * FUNCT: ListTestFileClose
- * DESCR: Closes the file specified by pStream. You close a file the same way whether it was opened for reading
- *        or writing.
+ * FUNCT: ListTestCmdSplice
+ * DESCR: Performs the "splice dst pos src from to" command, which moves the elements at indices from through
+ *        to - 1 of src into dst before index pos. Both lists stay in the list manager database. Fails if either
+ *        list is a persistent list. See DListSplice().
+ * PCODE:
+ * Read dstlistname, pos, srclistname, from, and to from pIo
+ * If neither list is a persistent list and DListSplice(dstlist, pos, srclist, from, to) succeeds Then
+ *     Print "spliced ..."
+ * Else
+ *     Print "failed ..."
+ * End If
  *------------------------------------------------------------------------------------------------------------*/
-static void ListTestFileClose
+static void ListTestCmdSplice
     (
-    FILE *pStream
+    ListTestIo *pIo
     )
 {
-    fclose(pStream);
+    int dstlistname;
+    int srclistname;
+    int pos, from, to;
+    DList *dstlist;
+    DList *srclist;
+    dstlistname = ListTestReadName(pIo);
+    ListTestReadInt(pIo, &pos);
+    srclistname = ListTestReadName(pIo);
+    ListTestReadInt(pIo, &from);
+    ListTestReadInt(pIo, &to);
+    dstlist = ListManGetList(dstlistname);
+    srclist = ListManGetList(srclistname);
+    if (dstlist && srclist && DListSplice(dstlist, pos, srclist, from, to)) {
+        OutFormat(pIo->mOut, "spliced %d to %d of %s into %s at %d\n", from, to, InternGetString(srclistname),
+            InternGetString(dstlistname), pos);
+    } else {
+        OutFormat(pIo->mOut, "failed to splice %d to %d of %s into %s at %d\n", from, to,
+            InternGetString(srclistname), InternGetString(dstlistname), pos);
+    }
 }
 
 /*--------------------------------------------------------------------------------------------------------------
- * FUNCT: ListTestFileOpen
- * DESCR: Opens the file with name specified by pFilename for reading (if mode is "rt") or writing (if mode is
- *        "wt"). Returns the file pointer. If the file open fails, displays an error message to stderr and
- *        terminates the program with a nonzero return code by calling exit().
- * PCODE:
- * Call fopen() passing pFileName and pMode.
- * If the file was opened successfully (return pointer is nonnull) then return the file pointer.
- * Else file could not be opened. Display an error message and terminate the program with exit(-1).
+ * FUNCT: ListTestHash
+ * DESCR: Hashes the command name pStr of length pLen into a slot of gCmdSlot[]. Only the length and the first,
+ *        middle, and last characters are mixed in, which is enough to tell the commands apart once a suitable
+ *        pSeed has been found by ListTestInit().
+ *------------------------------------------------------------------------------------------------------------*/
+static unsigned ListTestHash
+    (
+    char    *pStr,
+    int      pLen,
+    unsigned pSeed
+    )
+{
+    unsigned h = pSeed ^ (unsigned)pLen;
+    h = h * 31 + (unsigned char)pStr[0];
+    h = h * 31 + (unsigned char)pStr[pLen / 2];
+    h = h * 31 + (unsigned char)pStr[pLen - 1];
+    h *= 2654435769u;
+    return (h >> 16) & (CMD_SLOTS - 1);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestInit
+ * DESCR: Builds gCmdSlot[] from gCommands[]. Tries seeds 0, 1, 2, ... until one places every command in a slot
+ *        of its own. If none does, displays an error message and terminates; make CMD_SLOTS larger.
  *------------------------------------------------------------------------------------------------------------*/
-static FILE *ListTestFileOpen
+static void ListTestInit
     (
-    char *pFileName,
-    char *pMode,
-    char *pMsg
     )
 {
-    FILE *fstream = fopen(pFileName, pMode);
-    if (fstream) return fstream;
-    fprintf(stdout, "Cannot open '%s' for %s. Terminating.\n", pFileName, pMsg);
+    int i, num_cmds = sizeof(gCommands) / sizeof(gCommands[0]);
+    for (gCmdSeed = 0; gCmdSeed < CMD_MAX_SEEDS; ++gCmdSeed) {
+        for (i = 0; i < CMD_SLOTS; ++i) gCmdSlot[i] = 0;
+        for (i = 0; i < num_cmds; ++i) {
+            char *name = gCommands[i].mName;
+            unsigned slot = ListTestHash(name, (int)strlen(name), gCmdSeed);
+            if (gCmdSlot[slot]) break;
+            gCmdSlot[slot] = i + 1;
+        }
+        if (i == num_cmds) return;
+    }
+    fprintf(stderr, "Error, cannot build the command table; increase CMD_SLOTS\n");
     exit(-1);
 }
 
 /*--------------------------------------------------------------------------------------------------------------
- * FUNCT: ListTestPerform
- * DESCR: Performs the specified command 'cmd' that was read from the test input file.
+ * FUNCT: ListTestLookup
+ * DESCR: Returns the entry of gCommands[] for the command name pCmd that was read from the test input file. If
+ *        there is no such command, displays a message and returns NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+static ListTestCmd *ListTestLookup
+    (
+    Token *pCmd
+    )
+{
+    int slot = gCmdSlot[ListTestHash(pCmd->mStr, pCmd->mLen, gCmdSeed)];
+    if (slot && TokenEq(pCmd, gCommands[slot - 1].mName)) return &gCommands[slot - 1];
+    fprintf(stdout, "Unknown command '%.*s', ignoring.\n", pCmd->mLen, pCmd->mStr);
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestParallel
+ * DESCR: Performs the commands of the test input file on pThreads threads, writing the same output file that
+ *        performing them one after another would. The commands are gathered in batches of up to BATCH_CMDS.
+ *        A command that is not a barrier names one list, and goes in the group of that list (see gAlias[]),
+ *        so commands on lists that share nothing are in different groups and may run at the same time, while
+ *        the commands on one list run in input order. When a barrier command, or the end of the file, is
+ *        reached, the batch is run by ListTestParallelRun() and then the barrier command is performed alone
+ *        on this thread. The threads are started once, before the first batch, and wait between batches. The
+ *        operands of each command are stepped over with ListTestSkip() as it is gathered; that also interns
+ *        every list name, so the threads only look names up. Whether this runs faster than a serial run is
+ *        untested: the test cases check that the output is the same, but they have only been run on one core.
+ * PCODE:
+ * Allocate the workers, each with a memory writer. If memory cannot be allocated, display a message and exit.
+ * Start pThreads - 1 threads  -- Hint: Call pthread_create() with ListTestParallelWorker()
+ * While there is another command in the input Do
+ *     Step over its operands, remembering where they start and the lists they name
+ *     If the command is a barrier Then
+ *         Run the batch, then move gScan back to the operands and perform the command with gIo
+ *         Join the trees of the lists it names if it makes them share storage
+ *     Else
+ *         Add it to the batch, in the group of its list, starting a new group if the list has none
+ *         Run the batch if it is full
+ *     End If
+ * End While
+ * Run the batch, tell the threads to return and join them, and deallocate the workers and the alias forest.
  *------------------------------------------------------------------------------------------------------------*/
-static void ListTestPerform
+static void ListTestParallel
     (
-    char *pCmd
+    int pThreads
     )
 {
-    if      (streq(pCmd, "append"))    ListTestCmdAppend();
-    else if (streq(pCmd, "copy"))      ListTestCmdCopy();
-    else if (streq(pCmd, "create"))    ListTestCmdCreate();
-    else if (streq(pCmd, "free"))      ListTestCmdFree();
-    else if (streq(pCmd, "find"))      ListTestCmdFind();
-    else if (streq(pCmd, "findat"))    ListTestCmdFindAt();
-    else if (streq(pCmd, "insert"))    ListTestCmdInsert();
-    else if (streq(pCmd, "insertat"))  ListTestCmdInsertAt();
-    else if (streq(pCmd, "print"))     ListTestCmdPrint();
-    else if (streq(pCmd, "printr"))    ListTestCmdPrintRev();
-    else if (streq(pCmd, "remove"))    ListTestCmdRemove();
-    else if (streq(pCmd, "removeat"))  ListTestCmdRemoveAt();
-    else fprintf(stdout, "Unknown command '%s', ignoring.\n", pCmd);
+    Token cmd;
+    ListTestCmd *command;
+    char *operands;
+    int names[2], name_count, node, group, i;
+    if (!(gWorkers = (ListTestWorker *)calloc(pThreads, sizeof(ListTestWorker)))) {
+        fprintf(stderr, "Error, cannot allocate %d threads\n", pThreads);
+        exit(-1);
+    }
+    for (i = 0; i < pThreads; ++i) {
+        gWorkers[i].mIo.mIn = &gWorkers[i].mCursor;
+        gWorkers[i].mId = i;
+        if (!(gWorkers[i].mIo.mOut = OutOpenMem())) {
+            fprintf(stderr, "Error, cannot allocate %d threads\n", pThreads);
+            exit(-1);
+        }
+    }
+    gParallelBatch = 0;
+    gParallelQuit = false;
+    for (gParallelStarted = 0; gParallelStarted < pThreads - 1; ++gParallelStarted) {
+        if (pthread_create(&gParallelThreads[gParallelStarted], NULL, ListTestParallelWorker,
+            &gWorkers[gParallelStarted + 1]) != 0) break;
+    }
+    while (ScanNextToken(gScan, &cmd)) {
+        if (!(command = ListTestLookup(&cmd))) continue;
+        operands = gScan->mPos;
+        name_count = ListTestSkip(gScan, command->mOperands, names, NULL);
+        if (command->mFlags & CMD_BARRIER) {
+            ListTestParallelRun(pThreads);
+            gScan->mPos = operands;
+            command->mHandler(&gIo);
+            if (command->mFlags & CMD_LINKS) {
+                for (i = 1; i < name_count; ++i) ListTestAliasJoin(names[0] + 1, names[i] + 1);
+            }
+            if (command->mFlags & CMD_PERSISTENT) {
+                for (i = 0; i < name_count; ++i) ListTestAliasJoin(names[i] + 1, 0);
+            }
+            continue;
+        }
+        node = ListTestAliasFind(name_count ? names[0] + 1 : 0);
+        if ((group = gAliasGroup[node]) < 0) {
+            group = gAliasGroup[node] = gGroupCount++;
+            gGroups[group].mFirst = gJobCount;
+            gGroups[group].mKey = node;
+        } else {
+            gJobs[gGroups[group].mLast].mNext = gJobCount;
+        }
+        gGroups[group].mLast = gJobCount;
+        gJobs[gJobCount].mCmd = command;
+        gJobs[gJobCount].mOperands = operands;
+        gJobs[gJobCount].mNext = -1;
+        if (++gJobCount == BATCH_CMDS) ListTestParallelRun(pThreads);
+    }
+    ListTestParallelRun(pThreads);
+    pthread_mutex_lock(&gParallelLock);
+    gParallelQuit = true;
+    pthread_cond_broadcast(&gParallelWake);
+    pthread_mutex_unlock(&gParallelLock);
+    for (i = 0; i < gParallelStarted; ++i) pthread_join(gParallelThreads[i], NULL);
+    for (i = 0; i < pThreads; ++i) gWorkers[i].mIo.mOut = OutClose(gWorkers[i].mIo.mOut);
+    free(gWorkers);
+    free(gAlias);
+    free(gAliasGroup);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestParallelBatch
+ * DESCR: Runs the share of the current batch of thread pWorker: takes groups from gGroups[] until there are
+ *        none left, and performs the commands of each in order, reading the operands of each through a copy of
+ *        gScan and recording where its output is in the writer of the thread.
+ *------------------------------------------------------------------------------------------------------------*/
+static void ListTestParallelBatch
+    (
+    ListTestWorker *pWorker
+    )
+{
+    Out *out = pWorker->mIo.mOut;
+    ListTestJob *job;
+    int group, next;
+    while ((group = __atomic_fetch_add(&gNextGroup, 1, __ATOMIC_RELAXED)) < gGroupCount) {
+        for (next = gGroups[group].mFirst; next >= 0; next = job->mNext) {
+            job = &gJobs[next];
+            pWorker->mCursor = *gScan;
+            pWorker->mCursor.mPos = job->mOperands;
+            job->mWorker = pWorker->mId;
+            job->mBegin = out->mPos - out->mBuf;
+            job->mCmd->mHandler(&pWorker->mIo);
+            job->mEnd = out->mPos - out->mBuf;
+        }
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestParallelRun
+ * DESCR: Runs the batch of commands in gJobs[] on the threads started by ListTestParallel() and on this one,
+ *        each taking the next group that no thread has taken until there are none left (see
+ *        ListTestParallelBatch()). Once every thread is done, copies the output of each command, in input
+ *        order, from the writer of the thread that ran it to gOut, and empties the batch. If fewer threads
+ *        could be started than pThreads - 1, the others run their share.
+ * PCODE:
+ * If the batch is empty Then return
+ * Hand the batch to the threads  -- set gParallelBusy, add one to gParallelBatch, and signal gParallelWake
+ * Run the share of this thread, then wait on gParallelDone until gParallelBusy is 0
+ * Copy the output of each command to gOut, rewind the writers, and empty the batch
+ *------------------------------------------------------------------------------------------------------------*/
+static void ListTestParallelRun
+    (
+    int pThreads
+    )
+{
+    int i;
+    Out *out;
+    if (!gJobCount) return;
+    gNextGroup = 0;
+    pthread_mutex_lock(&gParallelLock);
+    gParallelBusy = gParallelStarted;
+    ++gParallelBatch;
+    pthread_cond_broadcast(&gParallelWake);
+    pthread_mutex_unlock(&gParallelLock);
+    ListTestParallelBatch(&gWorkers[0]);
+    pthread_mutex_lock(&gParallelLock);
+    while (gParallelBusy) pthread_cond_wait(&gParallelDone, &gParallelLock);
+    pthread_mutex_unlock(&gParallelLock);
+    for (i = 0; i < gJobCount; ++i) {
+        out = gWorkers[gJobs[i].mWorker].mIo.mOut;
+        OutMem(gOut, out->mBuf + gJobs[i].mBegin, gJobs[i].mEnd - gJobs[i].mBegin);
+    }
+    for (i = 0; i < pThreads; ++i) OutRewind(gWorkers[i].mIo.mOut);
+    for (i = 0; i < gGroupCount; ++i) gAliasGroup[gGroups[i].mKey] = -1;
+    gJobCount = gGroupCount = 0;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestParallelWorker
+ * DESCR: The body of each thread of a parallel run but this one, given its ListTestWorker in pWorker. Waits on
+ *        gParallelWake for each batch that ListTestParallelRun() hands out, runs its share of it (see
+ *        ListTestParallelBatch()), and says it is done through gParallelBusy, until gParallelQuit is set.
+ *------------------------------------------------------------------------------------------------------------*/
+static void *ListTestParallelWorker
+    (
+    void *pWorker
+    )
+{
+    int batch = 0;
+    pthread_mutex_lock(&gParallelLock);
+    for (;;) {
+        while (batch == gParallelBatch && !gParallelQuit) pthread_cond_wait(&gParallelWake, &gParallelLock);
+        if (batch == gParallelBatch) break;
+        batch = gParallelBatch;
+        pthread_mutex_unlock(&gParallelLock);
+        ListTestParallelBatch((ListTestWorker *)pWorker);
+        pthread_mutex_lock(&gParallelLock);
+        if (--gParallelBusy == 0) pthread_cond_signal(&gParallelDone);
+    }
+    pthread_mutex_unlock(&gParallelLock);
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestPipeline
+ * DESCR: Performs the commands of the test input file in three stages on three threads, connected by rings
+ *        (see Ring.c). ListTestPipelineReader() reads the input and hands each command, with its operands
+ *        already converted to ints and name ids, to this thread through gPipeIn. This thread performs the
+ *        commands, writing their output to the memory writers of gPipeOut[], and hands each writer to
+ *        ListTestPipelineWriter() through gPipeFull once PIPE_CHUNK characters are in it. That thread writes it
+ *        to the output file and hands it back through gPipeFree. So the input is read and the output written
+ *        while the lists are being changed, and since each stage keeps the order it was given, the output file
+ *        is the same as performing the commands one after another would write. If memory cannot be allocated
+ *        or a thread cannot be started, displays an error message and terminates. Untested for speed-up: it has
+ *        only been checked to write the same output, on a machine with one core, where the three stages take
+ *        turns rather than overlap.
+ * PCODE:
+ * Allocate the rings and the writers, put every writer but the first on gPipeFree, and start the other stages
+ * While the reader hands over another command Do
+ *     Perform it, reading its operands from gPipeIn and writing to the current writer
+ *     If the writer holds PIPE_CHUNK characters Then hand it to the writing stage and take a free one
+ * End While
+ * Hand the last writer and then -1 to the writing stage, wait for both stages to finish, and deallocate
+ *------------------------------------------------------------------------------------------------------------*/
+static void ListTestPipeline
+    (
+    )
+{
+    pthread_t reader, writer;
+    int command, buffer = 0, i;
+    gPipeIn = RingAlloc(PIPE_RING);
+    gPipeFull = RingAlloc(PIPE_BUFFERS + 1);
+    gPipeFree = RingAlloc(PIPE_BUFFERS);
+    for (i = 0; i < PIPE_BUFFERS; ++i) gPipeOut[i] = OutOpenMem();
+    for (i = 0; gPipeIn && gPipeFull && gPipeFree && i < PIPE_BUFFERS && gPipeOut[i]; ++i) continue;
+    if (i < PIPE_BUFFERS) {
+        fprintf(stderr, "Error, cannot allocate the pipeline\n");
+        exit(-1);
+    }
+    for (i = 1; i < PIPE_BUFFERS; ++i) RingPush(gPipeFree, i);
+    gIo.mRing = gPipeIn;
+    gIo.mOut = gPipeOut[buffer];
+    if (pthread_create(&reader, NULL, ListTestPipelineReader, NULL) != 0 ||
+        pthread_create(&writer, NULL, ListTestPipelineWriter, NULL) != 0) {
+        fprintf(stderr, "Error, cannot start the pipeline threads\n");
+        exit(-1);
+    }
+    while ((command = RingPop(gPipeIn)) >= 0) {
+        gCommands[command].mHandler(&gIo);
+        if (gIo.mOut->mPos - gIo.mOut->mBuf >= PIPE_CHUNK) {
+            RingPush(gPipeFull, buffer);
+            buffer = RingPop(gPipeFree);
+            gIo.mOut = gPipeOut[buffer];
+        }
+    }
+    RingPush(gPipeFull, buffer);
+    RingPush(gPipeFull, -1);
+    pthread_join(reader, NULL);
+    pthread_join(writer, NULL);
+    gIo.mRing = NULL;
+    gIo.mOut = gOut;
+    for (i = 0; i < PIPE_BUFFERS; ++i) gPipeOut[i] = OutClose(gPipeOut[i]);
+    gPipeIn = RingFree(gPipeIn);
+    gPipeFull = RingFree(gPipeFull);
+    gPipeFree = RingFree(gPipeFree);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestPipelineReader
+ * DESCR: The body of the reading stage of a pipelined run, see ListTestPipeline(). Reads each command of the
+ *        input and pushes its index in gCommands[] and then its operands onto gPipeIn, with ListTestSkip(). An
+ *        unknown command is reported and dropped. Pushes -1 at the end of the input.
+ *------------------------------------------------------------------------------------------------------------*/
+static void *ListTestPipelineReader
+    (
+    void *pUnused
+    )
+{
+    Token cmd;
+    ListTestCmd *command;
+    int names[2];
+    while (ScanNextToken(gScan, &cmd)) {
+        if (!(command = ListTestLookup(&cmd))) continue;
+        RingPush(gPipeIn, (int)(command - gCommands));
+        ListTestSkip(gScan, command->mOperands, names, gPipeIn);
+    }
+    RingPush(gPipeIn, -1);
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestPipelineWriter
+ * DESCR: The body of the writing stage of a pipelined run, see ListTestPipeline(). Pops the index of each full
+ *        writer of gPipeOut[] from gPipeFull, copies what is in it to gOut, empties it, and pushes it back onto
+ *        gPipeFree, until it pops -1. Then flushes gOut.
+ *------------------------------------------------------------------------------------------------------------*/
+static void *ListTestPipelineWriter
+    (
+    void *pUnused
+    )
+{
+    Out *out;
+    int buffer;
+    while ((buffer = RingPop(gPipeFull)) >= 0) {
+        out = gPipeOut[buffer];
+        OutMem(gOut, out->mBuf, out->mPos - out->mBuf);
+        OutRewind(out);
+        RingPush(gPipeFree, buffer);
+    }
+    OutFlush(gOut);
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestReadInt
+ * DESCR: Reads an int operand of a command into *pInt, from pIo->mRing if the command is being performed by a
+ *        pipelined run, or else from pIo->mIn with ScanNextInt(). Returns false, and stores 0, if there is no
+ *        int in the input; in a pipelined run the reading stage has done that already, and true is returned.
+ *------------------------------------------------------------------------------------------------------------*/
+static bool ListTestReadInt
+    (
+    ListTestIo *pIo,
+    int        *pInt
+    )
+{
+    if (!pIo->mRing) return ScanNextInt(pIo->mIn, pInt);
+    *pInt = RingPop(pIo->mRing);
+    return true;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestReadMethod
+ * DESCR: Reads the optional method of the "sort" command, and its thread count if it is parallel, from pIo the
+ *        way ListTestReadInt() reads an int (see ListTestScanMethod()). Returns one of the METHOD_ macros.
+ *------------------------------------------------------------------------------------------------------------*/
+static int ListTestReadMethod
+    (
+    ListTestIo *pIo,
+    int        *pThreads
+    )
+{
+    int method;
+    if (!pIo->mRing) return ListTestScanMethod(pIo->mIn, pThreads);
+    method = RingPop(pIo->mRing);
+    *pThreads = method == METHOD_PARALLEL ? RingPop(pIo->mRing) : 0;
+    return method;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestReadName
+ * DESCR: Reads a list name operand of a command from pIo the way ListTestReadInt() reads an int, and returns
+ *        its name id (see ListTestScanName()).
+ *------------------------------------------------------------------------------------------------------------*/
+static int ListTestReadName
+    (
+    ListTestIo *pIo
+    )
+{
+    return pIo->mRing ? RingPop(pIo->mRing) : ListTestScanName(pIo->mIn);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestScanMethod
+ * DESCR: Reads the optional method of the "sort" command from pScan: merge, radix, or parallel followed by a
+ *        thread count, which is stored in *pThreads (0 if there is none, and for the other methods). Only a
+ *        word on the same line as the list name is a method; if there is none, the method is merge. Returns
+ *        METHOD_MERGE, METHOD_RADIX, METHOD_PARALLEL, or METHOD_UNKNOWN if the word is not a method.
+ *------------------------------------------------------------------------------------------------------------*/
+static int ListTestScanMethod
+    (
+    Scan *pScan,
+    int  *pThreads
+    )
+{
+    Token method;
+    *pThreads = 0;
+    if (!ScanNextTokenOnLine(pScan, &method) || TokenEq(&method, "merge")) return METHOD_MERGE;
+    if (TokenEq(&method, "radix")) return METHOD_RADIX;
+    if (!TokenEq(&method, "parallel")) return METHOD_UNKNOWN;
+    ScanNextInt(pScan, pThreads);
+    return METHOD_PARALLEL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestScanName
+ * DESCR: Reads a list name from pScan and returns its name id (see Intern.c). A name at the end of the file is
+ *        read as the empty string.
+ *------------------------------------------------------------------------------------------------------------*/
+static int ListTestScanName
+    (
+    Scan *pScan
+    )
+{
+    Token name;
+    if (!ScanNextToken(pScan, &name)) return InternString("", 0);
+    return InternString(name.mStr, name.mLen);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestSkip
+ * DESCR: Reads the operands of a command from pScan as its handler would, without performing the command. Each
+ *        letter of pOperands is one operand: 'n' a list name, 'i' an int, 'v' a count followed by that many
+ *        ints, and 's' the optional method of "sort" and, after "parallel", its thread count. If pRing is not
+ *        NULL, pushes each operand onto it as it is read: a list name as its name id, and the method of "sort"
+ *        as one of the METHOD_ macros, followed by the thread count if it is METHOD_PARALLEL. Stores the name
+ *        ids of the first two list names in pNames[] and returns how many it stored.
+ *------------------------------------------------------------------------------------------------------------*/
+static int ListTestSkip
+    (
+    Scan *pScan,
+    char *pOperands,
+    int  *pNames,
+    Ring *pRing
+    )
+{
+    int name_count = 0, name, value, count, method;
+    for (; *pOperands; ++pOperands) {
+        switch (*pOperands) {
+            case 'n':
+                name = ListTestScanName(pScan);
+                if (name_count < 2) pNames[name_count++] = name;
+                if (pRing) RingPush(pRing, name);
+                break;
+            case 'v':
+                ScanNextInt(pScan, &count);
+                if (pRing) RingPush(pRing, count);
+                while (count-- > 0) {
+                    ScanNextInt(pScan, &value);
+                    if (pRing) RingPush(pRing, value);
+                }
+                break;
+            case 's':
+                method = ListTestScanMethod(pScan, &value);
+                if (pRing) RingPush(pRing, method);
+                if (pRing && method == METHOD_PARALLEL) RingPush(pRing, value);
+                break;
+            default:
+                ScanNextInt(pScan, &value);
+                if (pRing) RingPush(pRing, value);
+                break;
+        }
+    }
+    return name_count;
 }
 
 /*--------------------------------------------------------------------------------------------------------------
  * FUNCT: ListTest
  * DESCR: Tests the linked list implementation by reading and performing various commands from a testing input
- *        file.
+ *        file. If pPipeline is true, they are performed by the stages of ListTestPipeline(); otherwise, if
+ *        pThreads is more than one, on that many threads by ListTestParallel(), or else one after another.
  *------------------------------------------------------------------------------------------------------------*/
 static void ListTest
     (
+    int  pThreads,
+    bool pPipeline
     )
 {
-    char cmd[9];
+    Token cmd;
+    ListTestCmd *command;
     ListManInit();
-    while (fscanf(gFin, "%s", cmd) != EOF) ListTestPerform(cmd);
+    ListTestInit();
+    gIo.mIn = gScan;
+    gIo.mOut = gOut;
+    if (pPipeline) {
+        ListTestPipeline();
+        return;
+    }
+    if (pThreads > 1) {
+        ListTestParallel(pThreads);
+        return;
+    }
+    while (ScanNextToken(gScan, &cmd)) {
+        if ((command = ListTestLookup(&cmd))) command->mHandler(&gIo);
+    }
 }
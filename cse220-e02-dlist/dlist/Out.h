@@ -0,0 +1,120 @@
+/***************************************************************************************************************
+ * FILE: Out.h
+ *
+ * DESCRIPTION
+ * Declaration of the buffered output writer used for the test output file. See the comments in Out.c for more
+ * information.
+ *
+ * AUTHOR INFORMATION
+ * agent [AGT]
+ *
+ * Email: agent@local
+ *
+ * MODIFICATION HISTORY:
+ * -------------------------------------------------------------------------------------------------------------
+ * 17 Oct 2026 [AGT] Initial revision.
+ * 17 Oct 2026 [AGT] Added memory writers, OutOpenMem() and OutRewind().
+ **************************************************************************************************************/
+#ifndef __OUT_H__
+#define __OUT_H__
+
+#include <stddef.h>  /* For size_t */
+
+/*==============================================================================================================
+ * Preprocessor macro definitions.
+ *============================================================================================================*/
+#define OUT_INT_CHARS 11  /* Most characters OutItoa() writes for one int: a sign and 10 digits. */
+
+/*==============================================================================================================
+ * Typedefs.
+ *============================================================================================================*/
+/*--------------------------------------------------------------------------------------------------------------
+ * A writer either flushes its buffer to a file or, if it was opened with OutOpenMem(), keeps everything written
+ * to it in the buffer, which grows as needed. The characters written to a memory writer are mBuf[0] up to, but
+ * not including, mPos.
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct {
+    int    mFd;    /* File descriptor the buffer is flushed to, or -1 for a memory writer. */
+    char  *mBuf;   /* Start of the buffer.                                                  */
+    char  *mPos;   /* Where the next character will be stored.                              */
+    char  *mEnd;   /* One past the last character of the buffer.                            */
+} Out;
+
+/*==============================================================================================================
+ * Global function declarations. See function comments in Out.c
+ *============================================================================================================*/
+extern void OutChar
+    (
+    Out  *pOut,
+    char  pChar
+    );
+
+extern Out *OutClose
+    (
+    Out *pOut
+    );
+
+extern void OutCommit
+    (
+    Out  *pOut,
+    char *pPos
+    );
+
+extern void OutFlush
+    (
+    Out *pOut
+    );
+
+extern void OutFormat
+    (
+    Out  *pOut,
+    char *pFmt,
+    ...
+    );
+
+extern void OutInt
+    (
+    Out *pOut,
+    int  pInt
+    );
+
+extern char *OutItoa
+    (
+    char *pDst,
+    int   pInt
+    );
+
+extern void OutMem
+    (
+    Out    *pOut,
+    char   *pMem,
+    size_t  pLen
+    );
+
+extern Out *OutOpen
+    (
+    char *pFileName
+    );
+
+extern Out *OutOpenMem
+    (
+    );
+
+extern char *OutReserve
+    (
+    Out    *pOut,
+    size_t  pLen
+    );
+
+extern void OutRewind
+    (
+    Out *pOut
+    );
+
+extern void OutStr
+    (
+    Out  *pOut,
+    char *pStr
+    );
+
+#endif
@@ -0,0 +1,682 @@
+/***************************************************************************************************************
+ * FILE: PList.c
+ *
+ * DESCRIPTION
+ * Implementation of the persistent list. Each version of a list is an AVL tree of its elements ordered by
+ * index. A change makes a new version by path copying: only the nodes on the path from the root to the changed
+ * element are copied, and the new version shares every other subtree with the old one. So a change costs
+ * O(log n) time and O(log n) new nodes, and a snapshot, which is a second handle to the same root, costs O(1).
+ *
+ * The nodes are reference counted. A node whose count is 1 is reachable from only one version, the one being
+ * changed, so it is changed in place rather than copied. This is what makes a list that has never been
+ * snapshotted cost no more to change than an ordinary balanced tree. Apart from the reference counts, no node
+ * that another version can reach is ever written, so reading an old version never has to wait for a writer.
+ *
+ * AUTHOR INFORMATION
+ * agent [AGT]
+ *
+ * Email: agent@local
+ *
+ * MODIFICATION HISTORY:
+ * -------------------------------------------------------------------------------------------------------------
+ * 17 Oct 2026 [AGT] Initial revision.
+ **************************************************************************************************************/
+#include <assert.h>  /* For assert() */
+#include <stdio.h>   /* For fprintf(), NULL */
+#include <stdlib.h>  /* For exit(), free(), malloc() */
+#include "Out.h"     /* For Out, OutCommit(), OutItoa(), OutReserve(), OutStr() */
+#include "PList.h"
+#include "Pool.h"    /* For Pool, PoolAlloc(), PoolGetBlock(), PoolPutBlock() */
+
+/*==============================================================================================================
+ * Preprocessor macro definitions.
+ *============================================================================================================*/
+#define PListHeight(node) ((node) ? (node)->mHeight : 0)
+#define PListSize(node)   ((node) ? (node)->mSize : 0)
+
+/*==============================================================================================================
+ * Static function declarations.
+ *============================================================================================================*/
+static PListNode *PListBalance
+    (
+    PListNode *pNode
+    );
+
+static PListNode *PListNodeAlloc
+    (
+    PListNode *pLeft,
+    PListNode *pRight,
+    int        pData
+    );
+
+static PListNode *PListNodeFind
+    (
+    PListNode *pNode,
+    int        pData,
+    int       *pIndex
+    );
+
+static PListNode *PListNodeInsert
+    (
+    PListNode *pNode,
+    int        pIndex,
+    int        pData
+    );
+
+static PListNode *PListNodeOwn
+    (
+    PListNode *pNode
+    );
+
+static void PListNodePrint
+    (
+    Out       *pOut,
+    PListNode *pNode,
+    bool       pRev
+    );
+
+static void PListNodeRelease
+    (
+    PListNode *pNode
+    );
+
+static PListNode *PListNodeRemove
+    (
+    PListNode *pNode,
+    int        pIndex
+    );
+
+static PListNode *PListNodeRemoveMin
+    (
+    PListNode *pNode,
+    int       *pData
+    );
+
+static PListNode *PListNodeRetain
+    (
+    PListNode *pNode
+    );
+
+static PListNode *PListNodeTake
+    (
+    PListNode *pNode,
+    PListNode *pChild
+    );
+
+static PListNode *PListRotateLeft
+    (
+    PListNode *pNode
+    );
+
+static PListNode *PListRotateRight
+    (
+    PListNode *pNode
+    );
+
+static void PListUpdate
+    (
+    PListNode *pNode
+    );
+
+/*==============================================================================================================
+ * Static global variable definitions.
+ *============================================================================================================*/
+static Pool *gNodePool;  /* Every version's nodes come from here, since versions share nodes. */
+
+/*==============================================================================================================
+ * Function definitions.
+ *
+ * The static PListNodeXXX() functions take over one reference to the node they are given and return one
+ * reference to the root of the resulting subtree, so a parent simply stores the result in its child pointer.
+ *============================================================================================================*/
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PListAlloc
+ * DESCR: Allocates a handle to a new, empty, writable list. Returns NULL if malloc() fails.
+ *------------------------------------------------------------------------------------------------------------*/
+PList *PListAlloc
+    (
+    )
+{
+    PList *new_list = (PList *)malloc(sizeof(PList));
+    if (new_list) {
+        new_list->mRoot = NULL;
+        new_list->mReadOnly = false;
+    }
+    return new_list;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PListAppend
+ * DESCR: Appends pData to the end of pList. Returns NULL if pList is read-only. Assertion error if pList is
+ *        NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+PList *PListAppend
+    (
+    PList *pList,
+    int    pData
+    )
+{
+    assert(pList);
+    if (pList->mReadOnly) return NULL;
+    pList->mRoot = PListNodeInsert(pList->mRoot, PListSize(pList->mRoot), pData);
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PListBalance
+ * DESCR: Recomputes the size and height of pNode, which must be reachable only from the version being changed,
+ *        and rotates it if its subtrees differ in height by more than one. A child that is rotated is copied
+ *        first if another version shares it. Returns the new root of the subtree.
+ *------------------------------------------------------------------------------------------------------------*/
+static PListNode *PListBalance
+    (
+    PListNode *pNode
+    )
+{
+    int balance;
+    PListUpdate(pNode);
+    balance = PListHeight(pNode->mLeft) - PListHeight(pNode->mRight);
+    if (balance > 1) {
+        pNode->mLeft = PListNodeOwn(pNode->mLeft);
+        if (PListHeight(pNode->mLeft->mLeft) < PListHeight(pNode->mLeft->mRight)) {
+            pNode->mLeft->mRight = PListNodeOwn(pNode->mLeft->mRight);
+            pNode->mLeft = PListRotateLeft(pNode->mLeft);
+        }
+        return PListRotateRight(pNode);
+    }
+    if (balance < -1) {
+        pNode->mRight = PListNodeOwn(pNode->mRight);
+        if (PListHeight(pNode->mRight->mRight) < PListHeight(pNode->mRight->mLeft)) {
+            pNode->mRight->mLeft = PListNodeOwn(pNode->mRight->mLeft);
+            pNode->mRight = PListRotateRight(pNode->mRight);
+        }
+        return PListRotateLeft(pNode);
+    }
+    return pNode;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PListCopy
+ * DESCR: Returns a new writable handle to the version pSrcList is on. The two handles share every node until one
+ *        of them is changed, so the copy takes O(1) time. Returns NULL if pSrcList is NULL or malloc() fails.
+ *------------------------------------------------------------------------------------------------------------*/
+PList *PListCopy
+    (
+    PList *pSrcList
+    )
+{
+    PList *new_list;
+    if (!pSrcList || !(new_list = PListAlloc())) return NULL;
+    new_list->mRoot = PListNodeRetain(pSrcList->mRoot);
+    return new_list;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PListDebugPrint
+ * DESCR: Prints the contents of the list pList to pOut in the same format as DListDebugPrint(). Prints "List is
+ *        NULL" if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+void PListDebugPrint
+    (
+    Out   *pOut,
+    PList *pList
+    )
+{
+    if (!pList) {
+        OutStr(pOut, "List is NULL.\n");
+        return;
+    }
+    OutStr(pOut, "[ ");
+    PListNodePrint(pOut, pList->mRoot, false);
+    OutStr(pOut, "]");
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PListDebugPrintRev
+ * DESCR: Prints the contents of the list pList in reverse order to pOut. Prints "List is NULL" if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+void PListDebugPrintRev
+    (
+    Out   *pOut,
+    PList *pList
+    )
+{
+    if (!pList) {
+        OutStr(pOut, "List is NULL.\n");
+        return;
+    }
+    OutStr(pOut, "[ ");
+    PListNodePrint(pOut, pList->mRoot, true);
+    OutStr(pOut, "]");
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PListFindData
+ * DESCR: Returns a pointer to the node holding the first element of pList equal to pData, or NULL if pData is
+ *        not in pList. Assertion error if pList is NULL. O(n).
+ *------------------------------------------------------------------------------------------------------------*/
+PListNode *PListFindData
+    (
+    PList *pList,
+    int    pData
+    )
+{
+    int index = 0;
+    assert(pList);
+    return PListNodeFind(pList->mRoot, pData, &index);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PListFindIndex
+ * DESCR: Returns a pointer to the node holding the element at index pIndex of pList. Fails if pIndex < 0 or
+ *        pIndex >= the size of pList and returns NULL. Assertion error if pList is NULL. O(log n).
+ *------------------------------------------------------------------------------------------------------------*/
+PListNode *PListFindIndex
+    (
+    PList *pList,
+    int    pIndex
+    )
+{
+    PListNode *traverse;
+    assert(pList);
+    if (pIndex < 0 || pIndex >= PListSize(pList->mRoot)) return NULL;
+    traverse = pList->mRoot;
+    while (pIndex != PListSize(traverse->mLeft)) {
+        if (pIndex < PListSize(traverse->mLeft)) {
+            traverse = traverse->mLeft;
+        } else {
+            pIndex -= PListSize(traverse->mLeft) + 1;
+            traverse = traverse->mRight;
+        }
+    }
+    return traverse;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PListFree
+ * DESCR: Deallocates the handle pList. The nodes of its version are released unless another handle still
+ *        shares them. Returns NULL. Does nothing and returns NULL if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+PList *PListFree
+    (
+    PList *pList
+    )
+{
+    if (!pList) return NULL;
+    PListNodeRelease(pList->mRoot);
+    free(pList);
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PListGetIndex
+ * DESCR: Searches pList for an element equal to pData. Returns the index of the first one if it is found, or -1
+ *        if it is not. Assertion error if pList is NULL. O(n).
+ *------------------------------------------------------------------------------------------------------------*/
+int PListGetIndex
+    (
+    PList *pList,
+    int    pData
+    )
+{
+    int index = 0;
+    assert(pList);
+    return PListNodeFind(pList->mRoot, pData, &index) ? index : -1;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PListGetSize
+ * DESCR: Returns the number of elements in pList. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+int PListGetSize
+    (
+    PList *pList
+    )
+{
+    assert(pList);
+    return PListSize(pList->mRoot);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PListInsertBefore
+ * DESCR: Inserts pData before the first element of pList equal to pBefore. Returns NULL if pBefore is not in
+ *        pList or pList is read-only. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+PList *PListInsertBefore
+    (
+    PList *pList,
+    int    pBefore,
+    int    pData
+    )
+{
+    int index;
+    assert(pList);
+    if (pList->mReadOnly || (index = PListGetIndex(pList, pBefore)) < 0) return NULL;
+    pList->mRoot = PListNodeInsert(pList->mRoot, index, pData);
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PListInsertIndex
+ * DESCR: Inserts pData before the element at index pIndex of pList. Like DListInsertIndex(), fails and returns
+ *        NULL if pIndex < 0 or pIndex >= the size of pList, and also if pList is read-only. Assertion error if
+ *        pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+PList *PListInsertIndex
+    (
+    PList *pList,
+    int    pIndex,
+    int    pData
+    )
+{
+    assert(pList);
+    if (pList->mReadOnly || pIndex < 0 || pIndex >= PListSize(pList->mRoot)) return NULL;
+    pList->mRoot = PListNodeInsert(pList->mRoot, pIndex, pData);
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PListNodeAlloc
+ * DESCR: Returns a new node holding pData with the subtrees pLeft and pRight, whose references it takes over.
+ *        If the node cannot be allocated, displays an error message and terminates the program, because a
+ *        version that is half copied cannot be backed out of.
+ *------------------------------------------------------------------------------------------------------------*/
+static PListNode *PListNodeAlloc
+    (
+    PListNode *pLeft,
+    PListNode *pRight,
+    int        pData
+    )
+{
+    PListNode *new_node = NULL;
+    if (gNodePool || (gNodePool = PoolAlloc(sizeof(PListNode)))) new_node = (PListNode *)PoolGetBlock(gNodePool);
+    if (!new_node) {
+        fprintf(stderr, "Error, cannot allocate a persistent list node\n");
+        exit(-1);
+    }
+    new_node->mLeft = pLeft;
+    new_node->mRight = pRight;
+    new_node->mData = pData;
+    new_node->mRefs = 1;
+    PListUpdate(new_node);
+    return new_node;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PListNodeFind
+ * DESCR: Searches the subtree pNode in order for an element equal to pData. Adds the number of elements passed
+ *        over to *pIndex and returns the node holding the element, or NULL if it is not in the subtree.
+ *------------------------------------------------------------------------------------------------------------*/
+static PListNode *PListNodeFind
+    (
+    PListNode *pNode,
+    int        pData,
+    int       *pIndex
+    )
+{
+    PListNode *found;
+    for (; pNode; pNode = pNode->mRight) {
+        if ((found = PListNodeFind(pNode->mLeft, pData, pIndex))) return found;
+        if (pNode->mData == pData) return pNode;
+        ++*pIndex;
+    }
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PListNodeInsert
+ * DESCR: Inserts pData before the element at index pIndex of the subtree pNode, or at the end if pIndex is the
+ *        size of the subtree. The nodes on the path to the new element are copied if they are shared.
+ *------------------------------------------------------------------------------------------------------------*/
+static PListNode *PListNodeInsert
+    (
+    PListNode *pNode,
+    int        pIndex,
+    int        pData
+    )
+{
+    int left_size;
+    if (!pNode) return PListNodeAlloc(NULL, NULL, pData);
+    pNode = PListNodeOwn(pNode);
+    left_size = PListSize(pNode->mLeft);
+    if (pIndex <= left_size) {
+        pNode->mLeft = PListNodeInsert(pNode->mLeft, pIndex, pData);
+    } else {
+        pNode->mRight = PListNodeInsert(pNode->mRight, pIndex - left_size - 1, pData);
+    }
+    return PListBalance(pNode);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PListNodeOwn
+ * DESCR: Returns a node that can be changed in place to stand for pNode. That is pNode itself if nothing else
+ *        refers to it, or else a copy of it that shares its subtrees.
+ *------------------------------------------------------------------------------------------------------------*/
+static PListNode *PListNodeOwn
+    (
+    PListNode *pNode
+    )
+{
+    PListNode *copy;
+    if (pNode->mRefs == 1) return pNode;
+    copy = PListNodeAlloc(PListNodeRetain(pNode->mLeft), PListNodeRetain(pNode->mRight), pNode->mData);
+    pNode->mRefs--;
+    return copy;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PListNodePrint
+ * DESCR: Prints the elements of the subtree pNode to pOut, in reverse order if pRev is true, each followed by a
+ *        space.
+ *------------------------------------------------------------------------------------------------------------*/
+static void PListNodePrint
+    (
+    Out       *pOut,
+    PListNode *pNode,
+    bool       pRev
+    )
+{
+    char *pos;
+    for (; pNode; pNode = pRev ? pNode->mLeft : pNode->mRight) {
+        PListNodePrint(pOut, pRev ? pNode->mRight : pNode->mLeft, pRev);
+        pos = OutItoa(OutReserve(pOut, OUT_INT_CHARS + 1), pNode->mData);
+        *pos++ = ' ';
+        OutCommit(pOut, pos);
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PListNodeRelease
+ * DESCR: Drops one reference to pNode. When the last one is dropped the node goes back to the pool and its
+ *        subtrees are released in turn. Does nothing if pNode is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+static void PListNodeRelease
+    (
+    PListNode *pNode
+    )
+{
+    PListNode *right;
+    while (pNode && --pNode->mRefs == 0) {
+        PListNodeRelease(pNode->mLeft);
+        right = pNode->mRight;
+        PoolPutBlock(gNodePool, pNode);
+        pNode = right;
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PListNodeRemove
+ * DESCR: Removes the element at index pIndex of the subtree pNode, which must be in range. The nodes on the
+ *        path to the element are copied if they are shared.
+ *------------------------------------------------------------------------------------------------------------*/
+static PListNode *PListNodeRemove
+    (
+    PListNode *pNode,
+    int        pIndex
+    )
+{
+    int left_size = PListSize(pNode->mLeft);
+    if (pIndex == left_size) {
+        if (!pNode->mLeft) return PListNodeTake(pNode, pNode->mRight);
+        if (!pNode->mRight) return PListNodeTake(pNode, pNode->mLeft);
+    }
+    pNode = PListNodeOwn(pNode);
+    if (pIndex < left_size) {
+        pNode->mLeft = PListNodeRemove(pNode->mLeft, pIndex);
+    } else if (pIndex > left_size) {
+        pNode->mRight = PListNodeRemove(pNode->mRight, pIndex - left_size - 1);
+    } else {
+        pNode->mRight = PListNodeRemoveMin(pNode->mRight, &pNode->mData);
+    }
+    return PListBalance(pNode);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PListNodeRemoveMin
+ * DESCR: Removes the first element of the subtree pNode, which must not be empty, and stores it in *pData.
+ *------------------------------------------------------------------------------------------------------------*/
+static PListNode *PListNodeRemoveMin
+    (
+    PListNode *pNode,
+    int       *pData
+    )
+{
+    if (!pNode->mLeft) {
+        *pData = pNode->mData;
+        return PListNodeTake(pNode, pNode->mRight);
+    }
+    pNode = PListNodeOwn(pNode);
+    pNode->mLeft = PListNodeRemoveMin(pNode->mLeft, pData);
+    return PListBalance(pNode);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PListNodeRetain
+ * DESCR: Adds a reference to pNode and returns it. Does nothing if pNode is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+static PListNode *PListNodeRetain
+    (
+    PListNode *pNode
+    )
+{
+    if (pNode) pNode->mRefs++;
+    return pNode;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PListNodeTake
+ * DESCR: Called when pNode, whose other subtree is empty, is removed from a version. Returns a reference to its
+ *        subtree pChild and drops the reference to pNode, so pNode survives only if another version has it.
+ *------------------------------------------------------------------------------------------------------------*/
+static PListNode *PListNodeTake
+    (
+    PListNode *pNode,
+    PListNode *pChild
+    )
+{
+    PListNodeRetain(pChild);
+    PListNodeRelease(pNode);
+    return pChild;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PListRemoveData
+ * DESCR: Removes the first element of pList equal to pData. Returns NULL if pData is not in pList or pList is
+ *        read-only. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+PList *PListRemoveData
+    (
+    PList *pList,
+    int    pData
+    )
+{
+    int index;
+    assert(pList);
+    if (pList->mReadOnly || (index = PListGetIndex(pList, pData)) < 0) return NULL;
+    pList->mRoot = PListNodeRemove(pList->mRoot, index);
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PListRemoveIndex
+ * DESCR: Removes the element at index pIndex of pList. Returns NULL if pIndex < 0, pIndex >= the size of pList,
+ *        or pList is read-only. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+PList *PListRemoveIndex
+    (
+    PList *pList,
+    int    pIndex
+    )
+{
+    assert(pList);
+    if (pList->mReadOnly || pIndex < 0 || pIndex >= PListSize(pList->mRoot)) return NULL;
+    pList->mRoot = PListNodeRemove(pList->mRoot, pIndex);
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PListRotateLeft
+ * DESCR: Rotates the subtree pNode to the left and returns its new root, the old right child of pNode. pNode
+ *        and its right child must both be reachable only from the version being changed.
+ *------------------------------------------------------------------------------------------------------------*/
+static PListNode *PListRotateLeft
+    (
+    PListNode *pNode
+    )
+{
+    PListNode *right = pNode->mRight;
+    pNode->mRight = right->mLeft;
+    right->mLeft = pNode;
+    PListUpdate(pNode);
+    PListUpdate(right);
+    return right;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PListRotateRight
+ * DESCR: Rotates the subtree pNode to the right and returns its new root, the old left child of pNode. pNode
+ *        and its left child must both be reachable only from the version being changed.
+ *------------------------------------------------------------------------------------------------------------*/
+static PListNode *PListRotateRight
+    (
+    PListNode *pNode
+    )
+{
+    PListNode *left = pNode->mLeft;
+    pNode->mLeft = left->mRight;
+    left->mRight = pNode;
+    PListUpdate(pNode);
+    PListUpdate(left);
+    return left;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PListSnapshot
+ * DESCR: Returns a new read-only handle to the version pSrcList is on, in O(1) time. Later changes made through
+ *        pSrcList do not show through the snapshot. Returns NULL if pSrcList is NULL or malloc() fails.
+ *------------------------------------------------------------------------------------------------------------*/
+PList *PListSnapshot
+    (
+    PList *pSrcList
+    )
+{
+    PList *snapshot = PListCopy(pSrcList);
+    if (snapshot) snapshot->mReadOnly = true;
+    return snapshot;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PListUpdate
+ * DESCR: Recomputes the mSize and mHeight data members of pNode from those of its children.
+ *------------------------------------------------------------------------------------------------------------*/
+static void PListUpdate
+    (
+    PListNode *pNode
+    )
+{
+    int left_height = PListHeight(pNode->mLeft);
+    int right_height = PListHeight(pNode->mRight);
+    pNode->mSize = PListSize(pNode->mLeft) + PListSize(pNode->mRight) + 1;
+    pNode->mHeight = (left_height > right_height ? left_height : right_height) + 1;
+}
@@ -0,0 +1,140 @@
+/***************************************************************************************************************
+ * FILE: PList.h
+ *
+ * DESCRIPTION
+ * Declaration of the persistent list, a list whose versions are never changed once they have been made. See
+ * the comments in PList.c for more information.
+ *
+ * AUTHOR INFORMATION
+ * agent [AGT]
+ *
+ * Email: agent@local
+ *
+ * MODIFICATION HISTORY:
+ * -------------------------------------------------------------------------------------------------------------
+ * 17 Oct 2026 [AGT] Initial revision.
+ **************************************************************************************************************/
+#ifndef __PLIST_H__
+#define __PLIST_H__
+
+#include "Out.h"    /* For Out */
+#include "Types.h"  /* For bool */
+
+/*==============================================================================================================
+ * Typedefs.
+ *============================================================================================================*/
+/*--------------------------------------------------------------------------------------------------------------
+ * The elements of a version are kept in an AVL tree ordered by index, so an in-order walk of the tree visits
+ * them from the head of the list to the tail. mSize is the number of elements in the subtree, which is what
+ * lets an index be found without walking the list. A node may be part of several versions at once; mRefs
+ * counts the parent nodes and PList handles that point to it.
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct PListNode_ {
+    struct PListNode_ *mLeft;    /* Elements before this one in the subtree.         */
+    struct PListNode_ *mRight;   /* Elements after this one in the subtree.          */
+    int                mData;    /* The element.                                     */
+    int                mSize;    /* Number of elements in the subtree.               */
+    int                mHeight;  /* Height of the subtree; a leaf has height 1.      */
+    int                mRefs;    /* Number of nodes and handles pointing to this one. */
+} PListNode;
+
+/*--------------------------------------------------------------------------------------------------------------
+ * A PList is a handle to one version of a persistent list. Changing a list through a handle makes a new
+ * version and moves the handle to it; every other handle keeps seeing the version it had. A handle made by
+ * PListSnapshot() is read-only and the functions that change a list fail on it.
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct {
+    PListNode *mRoot;      /* Root of the tree of the version, NULL if the version is empty. */
+    bool       mReadOnly;  /* True if the handle was made by PListSnapshot().                */
+} PList;
+
+/*==============================================================================================================
+ * Global function declarations. See function comments in PList.c
+ *============================================================================================================*/
+extern PList *PListAlloc
+    (
+    );
+
+extern PList *PListAppend
+    (
+    PList *pList,
+    int    pData
+    );
+
+extern PList *PListCopy
+    (
+    PList *pSrcList
+    );
+
+extern void PListDebugPrint
+    (
+    Out   *pOut,
+    PList *pList
+    );
+
+extern void PListDebugPrintRev
+    (
+    Out   *pOut,
+    PList *pList
+    );
+
+extern PListNode *PListFindData
+    (
+    PList *pList,
+    int    pData
+    );
+
+extern PListNode *PListFindIndex
+    (
+    PList *pList,
+    int    pIndex
+    );
+
+extern PList *PListFree
+    (
+    PList *pList
+    );
+
+extern int PListGetIndex
+    (
+    PList *pList,
+    int    pData
+    );
+
+extern int PListGetSize
+    (
+    PList *pList
+    );
+
+extern PList *PListInsertBefore
+    (
+    PList *pList,
+    int    pBefore,
+    int    pData
+    );
+
+extern PList *PListInsertIndex
+    (
+    PList *pList,
+    int    pIndex,
+    int    pData
+    );
+
+extern PList *PListRemoveData
+    (
+    PList *pList,
+    int    pData
+    );
+
+extern PList *PListRemoveIndex
+    (
+    PList *pList,
+    int    pIndex
+    );
+
+extern PList *PListSnapshot
+    (
+    PList *pSrcList
+    );
+
+#endif
@@ -0,0 +1,258 @@
+/***************************************************************************************************************
+ * FILE: Pool.c
+ *
+ * DESCRIPTION
+ * Implementation of a fixed-size block pool. Rather than calling malloc() once per list node, the node code
+ * asks the pool for a block. The pool carves blocks out of large slabs, so consecutive requests get blocks
+ * that sit next to each other in memory, and a block that is handed back with PoolPutBlock() goes on an
+ * intrusive free list to be reused by the next PoolGetBlock(). PoolFree() releases every slab at once.
+ *
+ * Slabs start small and double in size up to POOL_SLAB_MAX_BLOCKS, so a pool holding a handful of nodes does
+ * not pay for thousands of them.
+ *
+ * AUTHOR INFORMATION
+ * agent [AGT]
+ *
+ * Email: agent@local
+ *
+ * MODIFICATION HISTORY:
+ * -------------------------------------------------------------------------------------------------------------
+ * 17 Oct 2026 [AGT] Initial revision.
+ * 17 Oct 2026 [AGT] Pools can be merged, see PoolMerge().
+ * 17 Oct 2026 [AGT] PoolRoot() points every pool it passes straight at the root, so chains of merges stay short.
+ **************************************************************************************************************/
+#include <assert.h>  /* For assert() */
+#include <stdlib.h>  /* For free(), malloc(), NULL */
+#include "Pool.h"
+#include "Types.h"   /* For bool, false, true */
+
+/*==============================================================================================================
+ * Preprocessor macro definitions.
+ *============================================================================================================*/
+#define POOL_ALIGN           16    /* The slab header is padded to a multiple of this many bytes.         */
+#define POOL_SLAB_MIN_BLOCKS 16    /* Number of blocks in the first slab of a pool.                       */
+#define POOL_SLAB_MAX_BLOCKS 4096  /* Slabs stop doubling in size once they reach this many blocks.       */
+
+#define PoolRoundUp(n) ((((n) + POOL_ALIGN - 1) / POOL_ALIGN) * POOL_ALIGN)
+
+/*==============================================================================================================
+ * Static function declarations.
+ *============================================================================================================*/
+static bool PoolGrow
+    (
+    Pool *pPool
+    );
+
+static Pool *PoolRoot
+    (
+    Pool *pPool
+    );
+
+/*==============================================================================================================
+ * Function definitions.
+ *============================================================================================================*/
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PoolAlloc
+ * DESCR: Allocates a new, empty pool that hands out blocks of pBlockSize bytes. No slab is allocated until the
+ *        first call to PoolGetBlock(). Returns NULL if malloc() fails.
+ *------------------------------------------------------------------------------------------------------------*/
+Pool *PoolAlloc
+    (
+    size_t pBlockSize
+    )
+{
+    Pool *new_pool = (Pool *)malloc(sizeof(Pool));
+    if (new_pool) {
+        if (pBlockSize < sizeof(PoolBlock)) pBlockSize = sizeof(PoolBlock);
+        new_pool->mBlockSize = (pBlockSize + sizeof(void *) - 1) / sizeof(void *) * sizeof(void *);
+        new_pool->mSlabBlocks = POOL_SLAB_MIN_BLOCKS;
+        new_pool->mSlabs = NULL;
+        new_pool->mLastSlab = NULL;
+        new_pool->mFree = NULL;
+        new_pool->mFreeTail = NULL;
+        new_pool->mBump = NULL;
+        new_pool->mBumpEnd = NULL;
+        new_pool->mRefs = 1;
+        new_pool->mMergedInto = NULL;
+    }
+    return new_pool;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PoolFree
+ * DESCR: Releases every slab owned by pPool and then pPool itself. Every block handed out by the pool becomes
+ *        invalid, whether or not it was given back with PoolPutBlock(). The cost is proportional to the number
+ *        of slabs, not the number of blocks. If pools were merged into pPool, it is only released once they
+ *        have been freed too; if pPool was merged into another pool, it gives up its share of that pool.
+ *        Returns NULL. Does nothing if pPool is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+Pool *PoolFree
+    (
+    Pool *pPool
+    )
+{
+    PoolSlab *slab;
+    Pool *merged_into;
+    if (!pPool || --pPool->mRefs > 0) return NULL;
+    merged_into = pPool->mMergedInto;
+    slab = pPool->mSlabs;
+    while (slab) {
+        PoolSlab *next_slab = slab->mNext;
+        free(slab);
+        slab = next_slab;
+    }
+    free(pPool);
+    return PoolFree(merged_into);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PoolGetBlock
+ * DESCR: Returns a block of pPool->mBlockSize bytes. Blocks on the free list are reused first; otherwise the
+ *        next unused block of the newest slab is handed out, and a new slab is allocated when that one is used
+ *        up. Returns NULL if malloc() fails. Assertion error if pPool is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+void *PoolGetBlock
+    (
+    Pool *pPool
+    )
+{
+    void *block;
+    assert(pPool);
+    pPool = PoolRoot(pPool);
+    if (pPool->mFree) {
+        block = pPool->mFree;
+        pPool->mFree = pPool->mFree->mNext;
+        return block;
+    }
+    if (pPool->mBump == pPool->mBumpEnd && !PoolGrow(pPool)) return NULL;
+    block = pPool->mBump;
+    pPool->mBump += pPool->mBlockSize;
+    return block;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PoolGrow
+ * DESCR: Allocates a new slab, makes it the newest slab of pPool, and doubles the size of the next slab until
+ *        it reaches POOL_SLAB_MAX_BLOCKS. Returns false if malloc() fails.
+ *------------------------------------------------------------------------------------------------------------*/
+static bool PoolGrow
+    (
+    Pool *pPool
+    )
+{
+    size_t header = PoolRoundUp(sizeof(PoolSlab));
+    PoolSlab *slab = (PoolSlab *)malloc(header + pPool->mSlabBlocks * pPool->mBlockSize);
+    if (!slab) return false;
+    if (!pPool->mSlabs) pPool->mLastSlab = slab;
+    slab->mNext = pPool->mSlabs;
+    pPool->mSlabs = slab;
+    pPool->mBump = (char *)slab + header;
+    pPool->mBumpEnd = pPool->mBump + pPool->mSlabBlocks * pPool->mBlockSize;
+    if (pPool->mSlabBlocks < POOL_SLAB_MAX_BLOCKS) pPool->mSlabBlocks *= 2;
+    return true;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PoolIsShared
+ * DESCR: Returns true if the blocks of pPool may also be in use by another owner, i.e., if pPool has been merged
+ *        with a pool that has not been freed yet. Assertion error if pPool is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+bool PoolIsShared
+    (
+    Pool *pPool
+    )
+{
+    assert(pPool);
+    return PoolRoot(pPool)->mRefs > 1;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PoolMerge
+ * DESCR: Merges pFrom into pInto, two pools of the same block size, so blocks handed out by either one may be
+ *        given back to either one and live until both have been freed. pFrom hands its slabs and free blocks
+ *        over to pInto and from then on forwards to it; the never-used blocks at the end of its newest slab are
+ *        given up. Takes O(1) time apart from finding the roots (see PoolRoot()). Does nothing if the pools have
+ *        already been merged. Assertion error if either pool is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+void PoolMerge
+    (
+    Pool *pInto,
+    Pool *pFrom
+    )
+{
+    assert(pInto && pFrom);
+    pInto = PoolRoot(pInto);
+    pFrom = PoolRoot(pFrom);
+    if (pInto == pFrom) return;
+    assert(pInto->mBlockSize == pFrom->mBlockSize);
+    if (pFrom->mSlabs) {
+        pFrom->mLastSlab->mNext = pInto->mSlabs;
+        if (!pInto->mSlabs) pInto->mLastSlab = pFrom->mLastSlab;
+        pInto->mSlabs = pFrom->mSlabs;
+    }
+    if (pFrom->mFree) {
+        pFrom->mFreeTail->mNext = pInto->mFree;
+        if (!pInto->mFree) pInto->mFreeTail = pFrom->mFreeTail;
+        pInto->mFree = pFrom->mFree;
+    }
+    pFrom->mSlabs = NULL;
+    pFrom->mFree = NULL;
+    pFrom->mBump = NULL;
+    pFrom->mBumpEnd = NULL;
+    pFrom->mMergedInto = pInto;
+    pInto->mRefs++;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PoolPutBlock
+ * DESCR: Gives pBlock back to pPool so the next call to PoolGetBlock() can reuse it. pBlock must have been
+ *        returned by PoolGetBlock() on the same pool. Does nothing if pBlock is NULL. Assertion error if pPool
+ *        is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+void PoolPutBlock
+    (
+    Pool *pPool,
+    void *pBlock
+    )
+{
+    PoolBlock *block = (PoolBlock *)pBlock;
+    assert(pPool);
+    if (!block) return;
+    pPool = PoolRoot(pPool);
+    if (!pPool->mFree) pPool->mFreeTail = block;
+    block->mNext = pPool->mFree;
+    pPool->mFree = block;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PoolRoot
+ * DESCR: Returns the pool that pPool has been merged into, following the chain of merges, or pPool itself if it
+ *        has not been merged into another pool. Every pool passed on the way is made to forward straight to
+ *        the root (path compression), so the next lookup through any of them takes one step however many
+ *        merges were chained. A pool holds a reference on the pool it forwards to, so each one that is moved
+ *        takes a reference on the root and drops the one on its old target, which frees that target if it has
+ *        been freed by its owner and nothing else forwards to it.
+ * PCODE:
+ * root <- pPool, then follow mMergedInto from root until it is null
+ * For each pool on the chain from pPool, up to but not including the one that forwards to root
+ *     Point it at root instead and increment the references of root
+ * Drop the reference each of those pools held on the pool after it on the chain  -- Hint: Call PoolFree()
+ *------------------------------------------------------------------------------------------------------------*/
+static Pool *PoolRoot
+    (
+    Pool *pPool
+    )
+{
+    Pool *root = pPool, *pool = pPool, *next;
+    while (root->mMergedInto) root = root->mMergedInto;
+    while (pool->mMergedInto && pool->mMergedInto != root) {
+        next = pool->mMergedInto;
+        pool->mMergedInto = root;
+        root->mRefs++;
+        if (pool != pPool) PoolFree(pool);
+        pool = next;
+    }
+    if (pool != pPool) PoolFree(pool);
+    return root;
+}
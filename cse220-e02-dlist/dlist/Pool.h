@@ -0,0 +1,97 @@
+/***************************************************************************************************************
+ * FILE: Pool.h
+ *
+ * DESCRIPTION
+ * Declaration of a fixed-size block pool (slab allocator). See the comments in Pool.c for more information.
+ *
+ * AUTHOR INFORMATION
+ * agent [AGT]
+ *
+ * Email: agent@local
+ *
+ * MODIFICATION HISTORY:
+ * -------------------------------------------------------------------------------------------------------------
+ * 17 Oct 2026 [AGT] Initial revision.
+ * 17 Oct 2026 [AGT] Added PoolIsShared() and PoolMerge().
+ * 17 Oct 2026 [AGT] mMergedInto may skip pools on a chain of merges, see PoolRoot().
+ **************************************************************************************************************/
+#ifndef __POOL_H__
+#define __POOL_H__
+
+#include <stddef.h>  /* For size_t */
+#include "Types.h"   /* For bool */
+
+/*==============================================================================================================
+ * Typedefs.
+ *============================================================================================================*/
+/*--------------------------------------------------------------------------------------------------------------
+ * A slab is one malloc()'d chunk of memory. The PoolSlab header sits at the front of the chunk and the blocks
+ * follow it. The slabs of a pool are kept on a singly-linked list so they can all be released at once.
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct PoolSlab_ {
+    struct PoolSlab_ *mNext;  /* Next slab owned by the same pool. */
+} PoolSlab;
+
+/*--------------------------------------------------------------------------------------------------------------
+ * A block that has been returned to the pool is reused to hold the free list link, so the free list costs
+ * no memory beyond the blocks themselves.
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct PoolBlock_ {
+    struct PoolBlock_ *mNext;  /* Next free block. */
+} PoolBlock;
+
+/*--------------------------------------------------------------------------------------------------------------
+ * A pool that has been merged into another by PoolMerge() gives its slabs and free blocks to that pool and
+ * forwards every later request to it through mMergedInto. mRefs counts the owners of the pool, which are the
+ * caller of PoolAlloc() and each pool whose mMergedInto points at this one, so a pool lives until every pool
+ * merged into it has been freed too. Lookups shorten chains of merges, so mMergedInto may skip pools.
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct Pool_ {
+    size_t        mBlockSize;   /* Size of each block in bytes, rounded up for alignment.    */
+    size_t        mSlabBlocks;  /* Number of blocks to put in the next slab that is carved.  */
+    PoolSlab     *mSlabs;       /* List of slabs owned by this pool, newest first.           */
+    PoolSlab     *mLastSlab;    /* Oldest slab of mSlabs, so the list can be joined in O(1). */
+    PoolBlock    *mFree;        /* Blocks returned by PoolPutBlock(), ready to be reused.    */
+    PoolBlock    *mFreeTail;    /* Last block of mFree when mFree is not NULL.               */
+    char         *mBump;        /* Next never-used block in the newest slab.                 */
+    char         *mBumpEnd;     /* One past the last block in the newest slab.               */
+    int           mRefs;        /* Number of owners, see above.                              */
+    struct Pool_ *mMergedInto;  /* Pool this one was merged into, or NULL.                   */
+} Pool;
+
+/*==============================================================================================================
+ * Global function declarations. See function comments in Pool.c
+ *============================================================================================================*/
+extern Pool *PoolAlloc
+    (
+    size_t pBlockSize
+    );
+
+extern Pool *PoolFree
+    (
+    Pool *pPool
+    );
+
+extern void *PoolGetBlock
+    (
+    Pool *pPool
+    );
+
+extern bool PoolIsShared
+    (
+    Pool *pPool
+    );
+
+extern void PoolMerge
+    (
+    Pool *pInto,
+    Pool *pFrom
+    );
+
+extern void PoolPutBlock
+    (
+    Pool *pPool,
+    void *pBlock
+    );
+
+#endif
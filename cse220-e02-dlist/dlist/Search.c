@@ -0,0 +1,219 @@
+/***************************************************************************************************************
+ * FILE: Search.c
+ *
+ * DESCRIPTION
+ * Finds the first occurrence of a value in an array of ints, comparing several ints per instruction. The
+ * unrolled list layout (DListUnrolled.c) stores the elements of a node contiguously, so DListFindData() and
+ * DListGetIndex() search each node with SearchInt() rather than comparing one element at a time.
+ *
+ * There are three versions of the search. SearchIntAvx2() compares 8 ints per instruction and SearchIntSse2()
+ * compares 4; each handles 16 ints per loop iteration and finishes the last few ints one at a time.
+ * SearchIntScalar() is the plain loop. The first call to SearchInt() asks the CPU which instruction sets it
+ * supports and makes gSearchInt point to the best version, so later calls go straight to it. The vector
+ * versions are only compiled by GCC (or a compiler that claims to be GCC) for x86; everywhere else, or when
+ * SEARCH_SCALAR is defined, SearchInt() is the scalar loop.
+ *
+ * AUTHOR INFORMATION
+ * agent [AGT]
+ *
+ * Email: agent@local
+ *
+ * MODIFICATION HISTORY:
+ * -------------------------------------------------------------------------------------------------------------
+ * 17 Oct 2026 [AGT] Initial revision.
+ * 17 Oct 2026 [AGT] gSearchInt is read and written atomically, so SearchInt() may be called from several threads.
+ **************************************************************************************************************/
+#include "Search.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(SEARCH_SCALAR)
+#define SEARCH_X86
+#include <immintrin.h>  /* For the SSE2 and AVX2 intrinsics */
+#endif
+
+/*==============================================================================================================
+ * Static function declarations.
+ *============================================================================================================*/
+#ifdef SEARCH_X86
+static int SearchIntAvx2
+    (
+    int *pData,
+    int  pCount,
+    int  pValue
+    ) __attribute__((target("avx2")));
+
+static int SearchIntResolve
+    (
+    int *pData,
+    int  pCount,
+    int  pValue
+    );
+#endif
+
+static int SearchIntScalar
+    (
+    int *pData,
+    int  pCount,
+    int  pValue
+    );
+
+#ifdef SEARCH_X86
+static int SearchIntSse2
+    (
+    int *pData,
+    int  pCount,
+    int  pValue
+    ) __attribute__((target("sse2")));
+#endif
+
+/*==============================================================================================================
+ * Static global variable definitions.
+ *============================================================================================================*/
+/*--------------------------------------------------------------------------------------------------------------
+ * The version of the search SearchInt() calls. Until the first call it is SearchIntResolve(), which picks the
+ * version for this CPU and stores it here. Threads that make their first calls at the same time all pick the
+ * same version, so it is only read and written atomically, with no lock.
+ *------------------------------------------------------------------------------------------------------------*/
+#ifdef SEARCH_X86
+static int (*gSearchInt)(int *, int, int) = SearchIntResolve;
+#else
+static int (*gSearchInt)(int *, int, int) = SearchIntScalar;
+#endif
+
+/*==============================================================================================================
+ * Function definitions.
+ *============================================================================================================*/
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SearchInt
+ * DESCR: Returns the index of the first of the pCount ints starting at pData that is equal to pValue, or -1 if
+ *        none is. pData need not be aligned.
+ *------------------------------------------------------------------------------------------------------------*/
+int SearchInt
+    (
+    int *pData,
+    int  pCount,
+    int  pValue
+    )
+{
+    return __atomic_load_n(&gSearchInt, __ATOMIC_RELAXED)(pData, pCount, pValue);
+}
+
+#ifdef SEARCH_X86
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SearchIntAvx2
+ * DESCR: SearchInt() for CPUs with AVX2. Compares two 8-int vectors with pValue per iteration and only looks at
+ *        which int matched once some int did.
+ *------------------------------------------------------------------------------------------------------------*/
+static int SearchIntAvx2
+    (
+    int *pData,
+    int  pCount,
+    int  pValue
+    )
+{
+    __m256i key = _mm256_set1_epi32(pValue);
+    __m256i eq0, eq1;
+    unsigned mask;
+    int i = 0;
+    for (; i + 16 <= pCount; i += 16) {
+        eq0 = _mm256_cmpeq_epi32(_mm256_loadu_si256((__m256i *)(pData + i)), key);
+        eq1 = _mm256_cmpeq_epi32(_mm256_loadu_si256((__m256i *)(pData + i + 8)), key);
+        if (!_mm256_testz_si256(_mm256_or_si256(eq0, eq1), _mm256_or_si256(eq0, eq1))) {
+            mask = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(eq0)) |
+                (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(eq1)) << 8;
+            return i + __builtin_ctz(mask);
+        }
+    }
+    if (i + 8 <= pCount) {
+        eq0 = _mm256_cmpeq_epi32(_mm256_loadu_si256((__m256i *)(pData + i)), key);
+        mask = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(eq0));
+        if (mask) return i + __builtin_ctz(mask);
+        i += 8;
+    }
+    for (; i < pCount; ++i) {
+        if (pData[i] == pValue) return i;
+    }
+    return -1;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SearchIntResolve
+ * DESCR: Picks the best version of the search this CPU supports, stores it in gSearchInt so that later calls of
+ *        SearchInt() go straight to it, and calls it.
+ *------------------------------------------------------------------------------------------------------------*/
+static int SearchIntResolve
+    (
+    int *pData,
+    int  pCount,
+    int  pValue
+    )
+{
+    int (*search)(int *, int, int);
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) search = SearchIntAvx2;
+    else if (__builtin_cpu_supports("sse2")) search = SearchIntSse2;
+    else search = SearchIntScalar;
+    __atomic_store_n(&gSearchInt, search, __ATOMIC_RELAXED);
+    return search(pData, pCount, pValue);
+}
+#endif
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SearchIntScalar
+ * DESCR: SearchInt() one int at a time, for CPUs without SSE2 and compilers without the intrinsics.
+ *------------------------------------------------------------------------------------------------------------*/
+static int SearchIntScalar
+    (
+    int *pData,
+    int  pCount,
+    int  pValue
+    )
+{
+    int i;
+    for (i = 0; i < pCount; ++i) {
+        if (pData[i] == pValue) return i;
+    }
+    return -1;
+}
+
+#ifdef SEARCH_X86
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SearchIntSse2
+ * DESCR: SearchInt() for CPUs with SSE2 (every x86-64 CPU). Compares four 4-int vectors with pValue per
+ *        iteration and only looks at which int matched once some int did.
+ *------------------------------------------------------------------------------------------------------------*/
+static int SearchIntSse2
+    (
+    int *pData,
+    int  pCount,
+    int  pValue
+    )
+{
+    __m128i key = _mm_set1_epi32(pValue);
+    __m128i eq0, eq1, eq2, eq3;
+    unsigned mask;
+    int i = 0;
+    for (; i + 16 <= pCount; i += 16) {
+        eq0 = _mm_cmpeq_epi32(_mm_loadu_si128((__m128i *)(pData + i)), key);
+        eq1 = _mm_cmpeq_epi32(_mm_loadu_si128((__m128i *)(pData + i + 4)), key);
+        eq2 = _mm_cmpeq_epi32(_mm_loadu_si128((__m128i *)(pData + i + 8)), key);
+        eq3 = _mm_cmpeq_epi32(_mm_loadu_si128((__m128i *)(pData + i + 12)), key);
+        if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(eq0, eq1), _mm_or_si128(eq2, eq3)))) {
+            mask = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(eq0)) |
+                (unsigned)_mm_movemask_ps(_mm_castsi128_ps(eq1)) << 4 |
+                (unsigned)_mm_movemask_ps(_mm_castsi128_ps(eq2)) << 8 |
+                (unsigned)_mm_movemask_ps(_mm_castsi128_ps(eq3)) << 12;
+            return i + __builtin_ctz(mask);
+        }
+    }
+    for (; i + 4 <= pCount; i += 4) {
+        eq0 = _mm_cmpeq_epi32(_mm_loadu_si128((__m128i *)(pData + i)), key);
+        mask = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(eq0));
+        if (mask) return i + __builtin_ctz(mask);
+    }
+    for (; i < pCount; ++i) {
+        if (pData[i] == pValue) return i;
+    }
+    return -1;
+}
+#endif
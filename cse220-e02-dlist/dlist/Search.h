@@ -0,0 +1,29 @@
+/***************************************************************************************************************
+ * FILE: Search.h
+ *
+ * DESCRIPTION
+ * Declaration of the vectorized search of an array of ints. See the comments in Search.c for more information.
+ *
+ * AUTHOR INFORMATION
+ * agent [AGT]
+ *
+ * Email: agent@local
+ *
+ * MODIFICATION HISTORY:
+ * -------------------------------------------------------------------------------------------------------------
+ * 17 Oct 2026 [AGT] Initial revision.
+ **************************************************************************************************************/
+#ifndef __SEARCH_H__
+#define __SEARCH_H__
+
+/*==============================================================================================================
+ * Global function declarations. See function comments in Search.c
+ *============================================================================================================*/
+extern int SearchInt
+    (
+    int *pData,
+    int  pCount,
+    int  pValue
+    );
+
+#endif
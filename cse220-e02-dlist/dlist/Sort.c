@@ -0,0 +1,436 @@
+/***************************************************************************************************************
+ * FILE: Sort.c
+ *
+ * DESCRIPTION
+ * Sorts an array of ints into ascending order with a least significant digit radix sort. The list sorts that
+ * do not compare elements (DListSortRadix() and SListSortRadix()) copy the elements of the list into an array,
+ * sort it with SortRadixInt(), and store the elements back into the nodes in order.
+ *
+ * Each int is sorted as SORT_PASSES digits of SORT_RADIX_BITS bits, least significant first. Every pass is a
+ * stable counting sort from one array into the other, so after the last pass the ints are ordered by all of
+ * their digits. Flipping the sign bit of each key makes negative ints sort before positive ones. The counts
+ * for every digit are taken in one read of the array before the first pass, and a pass whose digit is the
+ * same for every int is skipped, so lists of small or nearby values take fewer passes. Sorting takes O(n)
+ * time and one temporary array of n ints.
+ *
+ * SortParallelInt() sorts a large array on several threads. The array is cut into one run per thread and the
+ * runs are radix sorted at the same time. The output is then cut into one part per thread, and the bounds of
+ * each part in every run are found by a binary search on the value at the bound (see SortSplit()), so each
+ * part can be merged from the runs with a k-way merge without waiting for any other part. The threads are
+ * started once per sort and work through the three phases (sort the runs, merge the parts, copy the parts
+ * back) together, taking the tasks of a phase from a shared counter and waiting for each other at a barrier
+ * between phases (see SortWorker()). Since ints that compare equal cannot be told apart, the result is the
+ * same as that of SortRadixInt() whatever the number of threads.
+ *
+ * AUTHOR INFORMATION
+ * agent [AGT]
+ *
+ * Email: agent@local
+ *
+ * MODIFICATION HISTORY:
+ * -------------------------------------------------------------------------------------------------------------
+ * 17 Oct 2026 [AGT] Initial revision.
+ * 17 Oct 2026 [AGT] Added SortParallelInt().
+ * 17 Oct 2026 [AGT] SortParallelInt() starts its threads once and separates the phases with a barrier, rather
+ *                   than starting and joining threads for every phase.
+ **************************************************************************************************************/
+#define _POSIX_C_SOURCE 200112L  /* For pthread_create(), sysconf(), etc. when compiling with -ansi */
+
+#include <limits.h>   /* For CHAR_BIT, UINT_MAX */
+#include <pthread.h>  /* For pthread_cond_wait(), pthread_create(), pthread_join(), pthread_mutex_lock(), etc. */
+#include <stdlib.h>   /* For free(), malloc() */
+#include <string.h>   /* For memcpy(), memset() */
+#include <unistd.h>   /* For sysconf() */
+#include "Sort.h"
+#include "Types.h"    /* For bool, false, true */
+
+/*==============================================================================================================
+ * Preprocessor macro definitions.
+ *============================================================================================================*/
+#define SORT_RADIX_BITS 8                                           /* Bits per digit.             */
+#define SORT_RADIX      (1 << SORT_RADIX_BITS)                      /* Number of values of a digit. */
+#define SORT_PASSES     (sizeof(int) * CHAR_BIT / SORT_RADIX_BITS)  /* Number of digits in an int. */
+
+#define SORT_MAX_THREADS      64    /* Most threads SortParallelInt() will use.             */
+#define SORT_PARALLEL_MIN_RUN 4096  /* Fewest ints per thread worth starting a thread for. */
+#define SORT_PHASES           3     /* Sort the runs, merge the parts, copy the parts back.  */
+
+#define SortKey(n) ((unsigned)(n) ^ (1u << (sizeof(int) * CHAR_BIT - 1)))
+
+/*==============================================================================================================
+ * Typedefs.
+ *============================================================================================================*/
+/*--------------------------------------------------------------------------------------------------------------
+ * A SortJob is the state shared by the threads of SortParallelInt(). Run r of mData is the ints from
+ * mBounds[r] up to mBounds[r + 1], and part p of the output is the ints from p * mCount / mRuns up to
+ * (p + 1) * mCount / mRuns, so there are as many parts as runs, and each phase has one task per run.
+ * mNext[f] is the next task of phase f to be taken. mArrived and mPhase make the barrier the threads wait at
+ * between phases (see SortWait()). Every field after mLock is only read and written with mLock held.
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct {
+    int            *mData;                          /* The ints being sorted.                        */
+    int            *mMerged;                        /* Where the parts are merged to.                */
+    size_t          mCount;                         /* Number of ints in mData.                      */
+    int             mRuns;                          /* Number of runs and of parts.                  */
+    size_t          mBounds[SORT_MAX_THREADS + 1];  /* Start of each run, and mCount after the last. */
+    pthread_mutex_t mLock;                          /* Guards the fields below.                      */
+    pthread_cond_t  mPhaseDone;                     /* Signalled when all threads reach the barrier. */
+    bool            mFailed;                        /* Set when a run cannot be sorted.              */
+    int             mNext[SORT_PHASES];             /* Next task to be taken in each phase.          */
+    int             mThreads;                       /* Number of threads working on the job.         */
+    int             mArrived;                       /* Threads waiting at the barrier.               */
+    int             mPhase;                         /* Number of barriers passed.                    */
+} SortJob;
+
+/*==============================================================================================================
+ * Static function declarations.
+ *============================================================================================================*/
+static void SortCopyPart
+    (
+    SortJob *pJob,
+    int      pPart
+    );
+
+static size_t SortCountAtMost
+    (
+    int     *pRun,
+    size_t   pCount,
+    unsigned pKey
+    );
+
+static void SortMergePart
+    (
+    SortJob *pJob,
+    int      pPart
+    );
+
+static void SortRun
+    (
+    SortJob *pJob,
+    int      pRun
+    );
+
+static void SortSplit
+    (
+    SortJob *pJob,
+    size_t   pRank,
+    size_t  *pSplit
+    );
+
+static bool SortWait
+    (
+    SortJob *pJob
+    );
+
+static void *SortWorker
+    (
+    void *pJob
+    );
+
+/*==============================================================================================================
+ * Static global variable definitions.
+ *============================================================================================================*/
+/*--------------------------------------------------------------------------------------------------------------
+ * The task of each phase of SortParallelInt(), in order. Task t of a phase works on run or part t.
+ *------------------------------------------------------------------------------------------------------------*/
+static void (*const gSortPhases[SORT_PHASES])(SortJob *, int) = { SortRun, SortMergePart, SortCopyPart };
+
+/*==============================================================================================================
+ * Function definitions.
+ *============================================================================================================*/
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SortCopyPart
+ * DESCR: Copies part pPart of the merged ints of pJob back into pJob->mData.
+ *------------------------------------------------------------------------------------------------------------*/
+static void SortCopyPart
+    (
+    SortJob *pJob,
+    int      pPart
+    )
+{
+    size_t from = pPart * pJob->mCount / pJob->mRuns, to = (pPart + 1) * pJob->mCount / pJob->mRuns;
+    memcpy(&pJob->mData[from], &pJob->mMerged[from], (to - from) * sizeof(int));
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SortCountAtMost
+ * DESCR: Returns the number of ints of the sorted run pRun of pCount ints whose key is no greater than pKey,
+ *        found by a binary search. SortKey() orders the keys the same way as the ints.
+ *------------------------------------------------------------------------------------------------------------*/
+static size_t SortCountAtMost
+    (
+    int     *pRun,
+    size_t   pCount,
+    unsigned pKey
+    )
+{
+    size_t low = 0, high = pCount, mid;
+    while (low < high) {
+        mid = low + (high - low) / 2;
+        if (SortKey(pRun[mid]) <= pKey) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SortMergePart
+ * DESCR: Merges part pPart of the output of pJob from the sorted runs into pJob->mMerged. The bounds of the
+ *        part in each run are found by SortSplit(), and the runs are merged through a binary heap of the runs
+ *        ordered by their next int, so each int takes O(log k) time for k runs.
+ *------------------------------------------------------------------------------------------------------------*/
+static void SortMergePart
+    (
+    SortJob *pJob,
+    int      pPart
+    )
+{
+    size_t next[SORT_MAX_THREADS], end[SORT_MAX_THREADS], out;
+    int heap[SORT_MAX_THREADS], size = 0, i, child, run;
+    out = pPart * pJob->mCount / pJob->mRuns;
+    SortSplit(pJob, out, next);
+    SortSplit(pJob, (pPart + 1) * pJob->mCount / pJob->mRuns, end);
+    for (run = 0; run < pJob->mRuns; ++run) {
+        next[run] += pJob->mBounds[run];
+        end[run] += pJob->mBounds[run];
+        if (next[run] == end[run]) continue;
+        for (i = size++; i > 0 && pJob->mData[next[heap[(i - 1) / 2]]] > pJob->mData[next[run]]; i = (i - 1) / 2) {
+            heap[i] = heap[(i - 1) / 2];
+        }
+        heap[i] = run;
+    }
+    while (size > 0) {
+        run = heap[0];
+        pJob->mMerged[out++] = pJob->mData[next[run]++];
+        if (next[run] == end[run]) run = heap[--size];
+        for (i = 0; (child = 2 * i + 1) < size; i = child) {
+            if (child + 1 < size && pJob->mData[next[heap[child + 1]]] < pJob->mData[next[heap[child]]]) ++child;
+            if (pJob->mData[next[heap[child]]] >= pJob->mData[next[run]]) break;
+            heap[i] = heap[child];
+        }
+        heap[i] = run;
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SortParallelInt
+ * DESCR: Sorts the pCount ints of pData into ascending order using up to pThreads threads, or one per online
+ *        processor if pThreads is less than 1. Fewer threads are used when pCount is too small for each to
+ *        have SORT_PARALLEL_MIN_RUN ints, and with one thread this is SortRadixInt(). The result is the same
+ *        for any number of threads. Returns false if a temporary array cannot be allocated, in which case
+ *        pData holds the same ints but may not be in order.
+ * PCODE:
+ * Choose the number of threads k. If k is 1 Then Return SortRadixInt(pData, pCount)
+ * Cut pData into k runs of nearly equal size and allocate the merge array
+ * Start k - 1 threads, and tell the barrier how many were started  -- Hint: Call pthread_create()
+ * Work on the job on this thread too, and wait for the others to finish  -- SortWorker(), pthread_join()
+ *------------------------------------------------------------------------------------------------------------*/
+bool SortParallelInt
+    (
+    int   *pData,
+    size_t pCount,
+    int    pThreads
+    )
+{
+    pthread_t threads[SORT_MAX_THREADS];
+    SortJob job;
+    int run, phase, started;
+    if (pThreads < 1) pThreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (pThreads > SORT_MAX_THREADS) pThreads = SORT_MAX_THREADS;
+    if ((size_t)pThreads > pCount / SORT_PARALLEL_MIN_RUN) pThreads = (int)(pCount / SORT_PARALLEL_MIN_RUN);
+    if (pThreads <= 1) return SortRadixInt(pData, pCount);
+    if (!(job.mMerged = (int *)malloc(pCount * sizeof(int)))) return false;
+    job.mData = pData;
+    job.mCount = pCount;
+    job.mRuns = pThreads;
+    for (run = 0; run <= pThreads; ++run) job.mBounds[run] = run * pCount / pThreads;
+    pthread_mutex_init(&job.mLock, NULL);
+    pthread_cond_init(&job.mPhaseDone, NULL);
+    job.mFailed = false;
+    for (phase = 0; phase < SORT_PHASES; ++phase) job.mNext[phase] = 0;
+    job.mThreads = pThreads;
+    job.mArrived = 0;
+    job.mPhase = 0;
+    for (started = 0; started < pThreads - 1; ++started) {
+        if (pthread_create(&threads[started], NULL, SortWorker, &job) != 0) break;
+    }
+    pthread_mutex_lock(&job.mLock);
+    job.mThreads = started + 1;
+    pthread_mutex_unlock(&job.mLock);
+    SortWorker(&job);
+    for (run = 0; run < started; ++run) pthread_join(threads[run], NULL);
+    pthread_cond_destroy(&job.mPhaseDone);
+    pthread_mutex_destroy(&job.mLock);
+    free(job.mMerged);
+    return !job.mFailed;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SortRadixInt
+ * DESCR: Sorts the pCount ints of pData into ascending order. Returns false, leaving pData unchanged, if the
+ *        temporary array cannot be allocated.
+ *------------------------------------------------------------------------------------------------------------*/
+bool SortRadixInt
+    (
+    int   *pData,
+    size_t pCount
+    )
+{
+    size_t counts[SORT_PASSES][SORT_RADIX];
+    size_t i, sum, count;
+    int *temp, *from, *to, *swap;
+    unsigned pass, shift, digit;
+    if (pCount < 2) return true;
+    if (!(temp = (int *)malloc(pCount * sizeof(int)))) return false;
+    memset(counts, 0, sizeof(counts));
+    for (i = 0; i < pCount; ++i) {
+        unsigned key = SortKey(pData[i]);
+        for (pass = 0; pass < SORT_PASSES; ++pass) {
+            ++counts[pass][(key >> (pass * SORT_RADIX_BITS)) & (SORT_RADIX - 1)];
+        }
+    }
+    from = pData;
+    to = temp;
+    for (pass = 0; pass < SORT_PASSES; ++pass) {
+        shift = pass * SORT_RADIX_BITS;
+        if (counts[pass][(SortKey(from[0]) >> shift) & (SORT_RADIX - 1)] == pCount) continue;
+        for (sum = 0, digit = 0; digit < SORT_RADIX; ++digit) {
+            count = counts[pass][digit];
+            counts[pass][digit] = sum;
+            sum += count;
+        }
+        for (i = 0; i < pCount; ++i) {
+            to[counts[pass][(SortKey(from[i]) >> shift) & (SORT_RADIX - 1)]++] = from[i];
+        }
+        swap = from;
+        from = to;
+        to = swap;
+    }
+    if (from != pData) memcpy(pData, from, pCount * sizeof(int));
+    free(temp);
+    return true;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SortRun
+ * DESCR: Sorts run pRun of pJob->mData with SortRadixInt(), setting pJob->mFailed if it fails.
+ *------------------------------------------------------------------------------------------------------------*/
+static void SortRun
+    (
+    SortJob *pJob,
+    int      pRun
+    )
+{
+    size_t from = pJob->mBounds[pRun];
+    if (!SortRadixInt(&pJob->mData[from], pJob->mBounds[pRun + 1] - from)) {
+        pthread_mutex_lock(&pJob->mLock);
+        pJob->mFailed = true;
+        pthread_mutex_unlock(&pJob->mLock);
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SortSplit
+ * DESCR: Stores in pSplit[r], for each sorted run r of pJob, the number of ints of run r that come before
+ *        position pRank of the merged output. The ints before pRank are the pRank smallest, so the key v of
+ *        the int at pRank is found by a binary search over the keys for the smallest v with more than pRank
+ *        ints no greater than v. Each run gives all of its ints less than v, and the rest of the pRank are
+ *        taken from the ints equal to v, the first runs first.
+ *------------------------------------------------------------------------------------------------------------*/
+static void SortSplit
+    (
+    SortJob *pJob,
+    size_t   pRank,
+    size_t  *pSplit
+    )
+{
+    unsigned low = 0, high = UINT_MAX, mid;
+    size_t below, equal, take;
+    int run;
+    if (pRank >= pJob->mCount) {
+        for (run = 0; run < pJob->mRuns; ++run) pSplit[run] = pJob->mBounds[run + 1] - pJob->mBounds[run];
+        return;
+    }
+    while (low < high) {
+        mid = low + (high - low) / 2;
+        for (below = 0, run = 0; run < pJob->mRuns && below <= pRank; ++run) {
+            below += SortCountAtMost(&pJob->mData[pJob->mBounds[run]], pJob->mBounds[run + 1] - pJob->mBounds[run],
+                mid);
+        }
+        if (below > pRank) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+    for (below = 0, run = 0; run < pJob->mRuns; ++run) {
+        pSplit[run] = low == 0 ? 0 : SortCountAtMost(&pJob->mData[pJob->mBounds[run]],
+            pJob->mBounds[run + 1] - pJob->mBounds[run], low - 1);
+        below += pSplit[run];
+    }
+    for (run = 0; run < pJob->mRuns && below < pRank; ++run) {
+        equal = SortCountAtMost(&pJob->mData[pJob->mBounds[run]], pJob->mBounds[run + 1] - pJob->mBounds[run], low)
+            - pSplit[run];
+        take = equal < pRank - below ? equal : pRank - below;
+        pSplit[run] += take;
+        below += take;
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SortWait
+ * DESCR: The barrier between the phases of pJob. Waits until every thread working on pJob has called it, then
+ *        returns false if a run could not be sorted, in which case the threads stop, or true otherwise. The
+ *        last thread to arrive resets the barrier for the next phase and wakes the others; mPhase tells a
+ *        waiting thread that it was woken for that reason rather than spuriously.
+ *------------------------------------------------------------------------------------------------------------*/
+static bool SortWait
+    (
+    SortJob *pJob
+    )
+{
+    int phase;
+    bool ok;
+    pthread_mutex_lock(&pJob->mLock);
+    phase = pJob->mPhase;
+    if (++pJob->mArrived == pJob->mThreads) {
+        pJob->mArrived = 0;
+        ++pJob->mPhase;
+        pthread_cond_broadcast(&pJob->mPhaseDone);
+    } else {
+        while (phase == pJob->mPhase) pthread_cond_wait(&pJob->mPhaseDone, &pJob->mLock);
+    }
+    ok = !pJob->mFailed;
+    pthread_mutex_unlock(&pJob->mLock);
+    return ok;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SortWorker
+ * DESCR: Works on the SortJob pJob, one phase after the other: takes the next task of the phase and does it
+ *        until every task of the phase has been taken, then waits at the barrier for the other threads to
+ *        finish theirs (see SortWait()). Stops after the first phase if a run could not be sorted.
+ *------------------------------------------------------------------------------------------------------------*/
+static void *SortWorker
+    (
+    void *pJob
+    )
+{
+    SortJob *job = (SortJob *)pJob;
+    int phase, task;
+    for (phase = 0; phase < SORT_PHASES; ++phase) {
+        for (;;) {
+            pthread_mutex_lock(&job->mLock);
+            task = job->mNext[phase]++;
+            pthread_mutex_unlock(&job->mLock);
+            if (task >= job->mRuns) break;
+            gSortPhases[phase](job, task);
+        }
+        if (phase < SORT_PHASES - 1 && !SortWait(job)) break;
+    }
+    return NULL;
+}
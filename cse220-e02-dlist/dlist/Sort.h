@@ -0,0 +1,39 @@
+/***************************************************************************************************************
+ * FILE: Sort.h
+ *
+ * DESCRIPTION
+ * Declaration of the radix sorts of an array of ints. See the comments in Sort.c for more information.
+ *
+ * AUTHOR INFORMATION
+ * agent [AGT]
+ *
+ * Email: agent@local
+ *
+ * MODIFICATION HISTORY:
+ * -------------------------------------------------------------------------------------------------------------
+ * 17 Oct 2026 [AGT] Initial revision.
+ * 17 Oct 2026 [AGT] Added SortParallelInt().
+ **************************************************************************************************************/
+#ifndef __SORT_H__
+#define __SORT_H__
+
+#include <stddef.h>  /* For size_t */
+#include "Types.h"   /* For bool */
+
+/*==============================================================================================================
+ * Global function declarations. See function comments in Sort.c
+ *============================================================================================================*/
+extern bool SortParallelInt
+    (
+    int   *pData,
+    size_t pCount,
+    int    pThreads
+    );
+
+extern bool SortRadixInt
+    (
+    int   *pData,
+    size_t pCount
+    );
+
+#endif
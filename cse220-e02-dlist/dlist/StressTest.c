@@ -0,0 +1,340 @@
+/***************************************************************************************************************
+ * FILE: StressTest.c
+ *
+ * DESCRIPTION
+ * Stress test driver for the code that is shared by several threads: the concurrent list of CDList.c and the
+ * list database of ListMan.c. It reads commands from a test input file and writes a passed or failed line for
+ * each to the output file, the way ListTest.c does for the list commands. Kept apart from ListTest.c so the
+ * command table of the test driver only holds list commands.
+ *
+ * AUTHOR INFORMATION
+ * agent [AGT]
+ *
+ * Email: agent@local
+ *
+ * MODIFICATION HISTORY:
+ * -------------------------------------------------------------------------------------------------------------
+ * 17 Oct 2026 [AGT] Initial revision, the "stress" and "regstress" commands moved here from ListTest.c.
+ **************************************************************************************************************/
+#define _POSIX_C_SOURCE 200112L  /* For pthread_create(), pthread_join(), etc. when compiling with -ansi */
+
+#include <pthread.h>  /* For pthread_create(), pthread_join(), pthread_t */
+#include <stdio.h>    /* For fprintf(), sprintf(), NULL */
+#include <stdlib.h>   /* For exit() */
+#include <string.h>   /* For strlen() */
+#include "CDList.h"   /* For CDList, CDListCheck(), CDListInsertIndex(), CDListRemoveIndex(), etc. */
+#include "DList.h"    /* For DList, DListAlloc(), DListFree() */
+#include "Intern.h"   /* For InternString() */
+#include "ListMan.h"  /* For ListManCreateList(), ListManFreeList(), ListManGetList(), ListManInit() */
+#include "Out.h"      /* For Out, OutClose(), OutFormat(), OutOpen() */
+#include "Scan.h"     /* For Scan, Token, ScanNextInt(), ScanNextToken(), TokenEq(), etc. */
+
+/*==============================================================================================================
+ * Preprocessor macro definitions.
+ *============================================================================================================*/
+#define STRESS_SIZE    64   /* Number of elements the "stress" list starts and ends with.                     */
+#define STRESS_MAX     64   /* Most threads "stress" and "regstress" will start.                               */
+#define REGISTRY_LISTS 256  /* Number of lists "regstress" looks up.                                           */
+#define REGISTRY_CHURN 512  /* Number of names the writing thread of "regstress" creates and frees lists for. */
+
+/*==============================================================================================================
+ * Typedefs.
+ *============================================================================================================*/
+/*--------------------------------------------------------------------------------------------------------------
+ * What each thread of the "regstress" command is given. The reading threads look up the lists named in mNames,
+ * which stay in the database, and the one writing thread (mWriter is true) creates and frees lists named in
+ * mChurn, which share the shards of the database with them. A thread only writes mFailed of its own
+ * StressTestRegistry, which is read after it has been joined.
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct {
+    int      *mNames;   /* Name ids of the REGISTRY_LISTS lists that stay in the database.    */
+    DList   **mLists;   /* mLists[i] is the list named mNames[i].                             */
+    int      *mChurn;   /* Name ids of the REGISTRY_CHURN lists the writer creates and frees. */
+    unsigned  mSeed;    /* Seed of the thread's random choices.                               */
+    int       mRounds;  /* Number of lookups, or of creates and frees, the thread does.       */
+    bool      mWriter;  /* True for the writing thread.                                       */
+    bool      mFailed;  /* Set by a reading thread if a lookup returned the wrong list.       */
+} StressTestRegistry;
+
+/*--------------------------------------------------------------------------------------------------------------
+ * What each thread of the "stress" command is given. mChecker is true for the one thread that checks the list
+ * rather than changing it. A thread only writes mFailed of its own StressTestList, which is read after it has
+ * been joined.
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct {
+    CDList  *mList;     /* The list every thread works on.                       */
+    unsigned mSeed;     /* Seed of the thread's random indices.                  */
+    int      mRounds;   /* Number of rounds the thread does.                     */
+    bool     mChecker;  /* True if the thread checks the list instead.           */
+    bool     mFailed;   /* Set by the thread if an operation or a check failed.  */
+} StressTestList;
+
+/*==============================================================================================================
+ * Static function declarations.
+ *============================================================================================================*/
+static void StressTest
+    (
+    );
+
+static void StressTestCmdRegStress
+    (
+    );
+
+static void StressTestCmdStress
+    (
+    );
+
+static void *StressTestRegistryWorker
+    (
+    void *pStress
+    );
+
+static void *StressTestStressWorker
+    (
+    void *pStress
+    );
+
+/*==============================================================================================================
+ * Global variable definitions.
+ *============================================================================================================*/
+static Scan *gScan;
+static Out  *gOut;
+
+/*==============================================================================================================
+ * Function definitions.
+ *============================================================================================================*/
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: main
+ * DESCR: Starting point of execution. Opens the input and output files and calls StressTest() to perform the
+ *        testing. On return, closes the input and output files and terminates.
+ *------------------------------------------------------------------------------------------------------------*/
+int main
+    (
+    int   pArgc,
+    char *pArgv[]
+    )
+{
+    if (pArgc < 3) {
+        fprintf(stderr, "Usage: StressTest inputfile outputfile\n");
+        exit(-1);
+    }
+    if (!(gScan = ScanOpen(pArgv[1]))) {
+        fprintf(stdout, "Cannot open '%s' for reading. Terminating.\n", pArgv[1]);
+        exit(-1);
+    }
+    if (!(gOut = OutOpen(pArgv[2]))) {
+        fprintf(stdout, "Cannot open '%s' for writing. Terminating.\n", pArgv[2]);
+        exit(-1);
+    }
+    StressTest();
+    gScan = ScanClose(gScan);
+    gOut = OutClose(gOut);
+    return 0;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: StressTest
+ * DESCR: Reads and performs the commands of the test input file one after another. Each command starts its own
+ *        threads and joins them before the next one is read.
+ *------------------------------------------------------------------------------------------------------------*/
+static void StressTest
+    (
+    )
+{
+    Token cmd;
+    ListManInit();
+    while (ScanNextToken(gScan, &cmd)) {
+        if (TokenEq(&cmd, "regstress")) {
+            StressTestCmdRegStress();
+        } else if (TokenEq(&cmd, "stress")) {
+            StressTestCmdStress();
+        } else {
+            fprintf(stdout, "Unknown command '%.*s', ignoring.\n", cmd.mLen, cmd.mStr);
+        }
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: StressTestCmdRegStress
+ * DESCR: Performs the "regstress readers rounds" command, which tests the list database of ListMan.c under
+ *        contention. REGISTRY_LISTS lists are put in the database, and then readers threads each look up rounds
+ *        of them at random while one more thread does rounds creates and frees of REGISTRY_CHURN other lists,
+ *        which grow the shards and move entries around in them (see StressTestRegistryWorker()). Passes if
+ *        every lookup returns the list that was put in the database, and the lists are gone once they are
+ *        freed. The choices come from a fixed seed per thread, so the output does not depend on how the threads
+ *        are scheduled. Fails if readers is not from 1 to STRESS_MAX or rounds < 0.
+ *------------------------------------------------------------------------------------------------------------*/
+static void StressTestCmdRegStress
+    (
+    )
+{
+    StressTestRegistry stress[STRESS_MAX + 1];
+    pthread_t threads[STRESS_MAX + 1];
+    int names[REGISTRY_LISTS], churn[REGISTRY_CHURN];
+    DList *lists[REGISTRY_LISTS], *list;
+    char name[32];
+    int reader_count = 0, rounds = 0, started, i;
+    bool passed = false;
+    ScanNextInt(gScan, &reader_count);
+    ScanNextInt(gScan, &rounds);
+    if (reader_count >= 1 && reader_count <= STRESS_MAX && rounds >= 0) {
+        for (passed = true, i = 0; i < REGISTRY_LISTS; ++i) {
+            sprintf(name, "#registry%d", i);
+            names[i] = InternString(name, (int)strlen(name));
+            ListManCreateList(names[i], lists[i] = DListAlloc());
+            passed = passed && lists[i];
+        }
+        for (i = 0; i < REGISTRY_CHURN; ++i) {
+            sprintf(name, "#churn%d", i);
+            churn[i] = InternString(name, (int)strlen(name));
+        }
+        for (started = 0; passed && started <= reader_count; ++started) {
+            stress[started].mNames = names;
+            stress[started].mLists = lists;
+            stress[started].mChurn = churn;
+            stress[started].mSeed = (unsigned)started + 1;
+            stress[started].mRounds = rounds;
+            stress[started].mWriter = started == reader_count;
+            stress[started].mFailed = false;
+            if (pthread_create(&threads[started], NULL, StressTestRegistryWorker, &stress[started]) != 0) break;
+        }
+        for (i = 0; i < started; ++i) {
+            pthread_join(threads[i], NULL);
+            passed = passed && !stress[i].mFailed;
+        }
+        passed = passed && started > reader_count;
+        for (i = 0; i < REGISTRY_LISTS; ++i) {
+            passed = passed && ListManGetList(names[i]) == lists[i];
+            DListFree(lists[i]);
+            ListManFreeList(names[i]);
+            passed = passed && !ListManGetList(names[i]);
+        }
+        for (i = 0; i < REGISTRY_CHURN; ++i) {
+            if ((list = ListManGetList(churn[i]))) {
+                DListFree(list);
+                ListManFreeList(churn[i]);
+            }
+        }
+    }
+    OutFormat(gOut, "regstress with %d readers and %d rounds %s\n", reader_count, rounds,
+        passed ? "passed" : "failed");
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: StressTestCmdStress
+ * DESCR: Performs the "stress threads rounds" command, which tests the concurrent list of CDList.c under
+ *        contention. A list of STRESS_SIZE elements is changed by threads threads at once, each doing rounds
+ *        rounds of an insertat and then a removeat at random indices below STRESS_SIZE, while one more thread
+ *        checks the links of the list over and over (see CDListCheck()). No thread ever has removed more
+ *        elements than it inserted, so every insertat and removeat must succeed and every check must count at
+ *        least STRESS_SIZE elements. When the threads are done the list must have exactly STRESS_SIZE elements,
+ *        counted both by walking it and by its size. The indices come from a fixed seed per thread, so the
+ *        output does not depend on how the threads are scheduled. Fails if threads is not from 1 to STRESS_MAX
+ *        or rounds < 0.
+ * PCODE:
+ * Read the number of threads and the number of rounds from gScan
+ * Make a list of STRESS_SIZE elements
+ * Start the threads and the checker  -- Hint: Call pthread_create() with StressTestStressWorker()
+ * Join every thread. If any failed Then the test failed
+ * If CDListCheck() or CDListGetSize() is not STRESS_SIZE Then the test failed
+ * Print "stress ... passed" or "stress ... failed"
+ *------------------------------------------------------------------------------------------------------------*/
+static void StressTestCmdStress
+    (
+    )
+{
+    StressTestList stress[STRESS_MAX + 1];
+    pthread_t threads[STRESS_MAX + 1];
+    CDList *list;
+    int thread_count = 0, rounds = 0, started, i;
+    bool passed = false;
+    ScanNextInt(gScan, &thread_count);
+    ScanNextInt(gScan, &rounds);
+    if (thread_count >= 1 && thread_count <= STRESS_MAX && rounds >= 0 && (list = CDListAlloc())) {
+        for (passed = true, i = 0; passed && i < STRESS_SIZE; ++i) passed = CDListAppend(list, i) != NULL;
+        for (started = 0; passed && started <= thread_count; ++started) {
+            stress[started].mList = list;
+            stress[started].mSeed = (unsigned)started + 1;
+            stress[started].mRounds = rounds;
+            stress[started].mChecker = started == thread_count;
+            stress[started].mFailed = false;
+            if (pthread_create(&threads[started], NULL, StressTestStressWorker, &stress[started]) != 0) break;
+        }
+        for (i = 0; i < started; ++i) {
+            pthread_join(threads[i], NULL);
+            passed = passed && !stress[i].mFailed;
+        }
+        passed = passed && started > thread_count;
+        passed = passed && CDListCheck(list) == STRESS_SIZE && CDListGetSize(list) == STRESS_SIZE;
+        CDListFree(list);
+    }
+    OutFormat(gOut, "stress with %d threads and %d rounds %s\n", thread_count, rounds,
+        passed ? "passed" : "failed");
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: StressTestRegistryWorker
+ * DESCR: The body of each thread of the "regstress" command, given its StressTestRegistry in pStress. A reading
+ *        thread does mRounds lookups of lists chosen at random from mNames, setting mFailed if one returns
+ *        anything but the list in mLists. The writing thread does mRounds times: choose a name from mChurn at
+ *        random, and free its list if it has one, or else create one. The random choices come from a linear
+ *        congruential generator seeded with mSeed.
+ *------------------------------------------------------------------------------------------------------------*/
+static void *StressTestRegistryWorker
+    (
+    void *pStress
+    )
+{
+    StressTestRegistry *stress = (StressTestRegistry *)pStress;
+    unsigned seed = stress->mSeed;
+    DList *list;
+    int round, choice;
+    for (round = 0; round < stress->mRounds; ++round) {
+        seed = seed * 1103515245u + 12345u;
+        if (stress->mWriter) {
+            choice = stress->mChurn[(seed >> 16) % REGISTRY_CHURN];
+            if ((list = ListManGetList(choice))) {
+                ListManFreeList(choice);
+                DListFree(list);
+            } else {
+                ListManCreateList(choice, DListAlloc());
+            }
+        } else {
+            choice = (int)((seed >> 16) % REGISTRY_LISTS);
+            if (ListManGetList(stress->mNames[choice]) != stress->mLists[choice]) stress->mFailed = true;
+        }
+    }
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: StressTestStressWorker
+ * DESCR: The body of each thread of the "stress" command, given its StressTestList in pStress. A changing
+ *        thread does mRounds rounds of inserting an element at a random index and then removing the element at
+ *        another random index, both below STRESS_SIZE. The checker does one check of the whole list for every
+ *        16 rounds. Sets mFailed if an insert or a remove fails or a check finds a broken link or fewer than
+ *        STRESS_SIZE elements. The random indices come from a linear congruential generator seeded with mSeed.
+ *------------------------------------------------------------------------------------------------------------*/
+static void *StressTestStressWorker
+    (
+    void *pStress
+    )
+{
+    StressTestList *stress = (StressTestList *)pStress;
+    unsigned seed = stress->mSeed;
+    int round;
+    if (stress->mChecker) {
+        for (round = 0; round < stress->mRounds; round += 16) {
+            if (CDListCheck(stress->mList) < STRESS_SIZE) stress->mFailed = true;
+        }
+        return NULL;
+    }
+    for (round = 0; round < stress->mRounds; ++round) {
+        seed = seed * 1103515245u + 12345u;
+        if (!CDListInsertIndex(stress->mList, (int)((seed >> 16) % STRESS_SIZE), (int)seed)) stress->mFailed = true;
+        seed = seed * 1103515245u + 12345u;
+        if (!CDListRemoveIndex(stress->mList, (int)((seed >> 16) % STRESS_SIZE))) stress->mFailed = true;
+    }
+    return NULL;
+}
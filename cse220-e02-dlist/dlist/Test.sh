@@ -0,0 +1,197 @@
+#!/bin/bash
+#***************************************************************************************************************
+# FILE: Test.sh
+# 
+# DESCRIPTION
+# Tests the doubly-linked list code.
+# 
+# AUTHOR INFORMATION
+# Kevin R. Burger [KRB]
+# 
+# Mailing Address:
+# Computer Science & Engineering
+# School of Computing, Informatics, and Decision Systems Engineering
+# Arizona State University
+# Tempe, AZ 85287-8809
+# 
+# Email: burgerk@asu
+# Web:   http://kevin.floorsoup.com
+# 
+# MODIFICATION HISTORY:
+# -------------------------------------------------------------------------------------------------------------
+# 17 Oct 2026 [AGT] Initial revision, adapted from the slist Test.sh.
+# 17 Oct 2026 [AGT] Added test case 6, a longer mix of commands that splits and merges unrolled nodes.
+# 17 Oct 2026 [AGT] Added test case 7, searches and edits of a list that spans several unrolled nodes.
+# 17 Oct 2026 [AGT] Added test case 8, positional commands that stay close to each other.
+# 17 Oct 2026 [AGT] Added test case 9, copies of lists that are then changed.
+# 17 Oct 2026 [AGT] Added test case 10, persistent lists and their snapshots.
+# 17 Oct 2026 [AGT] Added test case 11, the appendn and appendrange commands.
+# 17 Oct 2026 [AGT] Added test case 12, splicing and concatenating lists.
+# 17 Oct 2026 [AGT] Added test case 13, sorting lists by merge sort and by radix sort.
+# 17 Oct 2026 [AGT] Added test case 14, sorting lists on several threads.
+# 17 Oct 2026 [AGT] Added test case 15, the concurrent list under contention.
+# 17 Oct 2026 [AGT] Added test case 16, the list database looked up while lists are created and freed.
+# 17 Oct 2026 [AGT] Each test case is also performed on four threads, and added test case 17, commands on many
+#                   lists performed on several threads.
+# 17 Oct 2026 [AGT] Each test case is also performed pipelined.
+# 17 Oct 2026 [AGT] Added test case 18, integers that do not fit in an int.
+# 17 Oct 2026 [AGT] Added test case 19, lists concatenated in a chain and then freed in any order.
+# 17 Oct 2026 [AGT] Test cases 15 and 16 are now stress test cases 1 and 2, performed by StressTest. Test cases
+#                   17, 18, and 19 are renumbered 15, 16, and 17.
+# 17 Oct 2026 [AGT] Added test case 18, lists created and copied over lists that exist, and copies of lists
+#                   that do not.
+#***************************************************************************************************************
+
+#----- Dos2Unix ------------------------------------------------------------------------------------------------
+# Converts a text file stored in MSDOS/Windows format to Unix format. In MSDOS/Windows, each line of a
+# text file is terminated with a carriage return (CR)/linefeed (LF) sequence. In Unix, each line of a 
+# text file is simply terminated with a LF. The dos2unix command simply replaces each occurrence of CR/LF
+# with LF.
+#
+# BTW, this is necessary because I edit my files on my PC using a Windows text editor. Then I transfer the
+# files up to General using WinSCP, and I do my building, debugging, and testing on General. If I were simply
+# using VI on General, then this function would not be necessary.
+#---------------------------------------------------------------------------------------------------------------
+Dos2Unix() {
+	dos2unix < $_file > $_file.new
+	rm $_file
+	mv $_file.new $_file
+}
+
+#----- Test ----------------------------------------------------------------------------------------------------
+# Perform the test case corresponding to the value of variable _tc.
+#---------------------------------------------------------------------------------------------------------------
+Test() {
+	echo -n Performing Test Case $_tc...
+
+	# Set _correct to the name of the file containing the correct output from the test case. Set _diff to the
+	# text filename that will be generated by the diff command. Set _in to the name of text file containing the
+	# input data for the test case. Set _out to the name of the output file that will be generated by perform-
+	# ing the test case. Set _pout to the name of the output file that will be generated by performing the test
+	# case again on four threads, and _lout to the one generated by performing it again pipelined.
+	_correct=test$_tc.correct
+	_diff=test$_tc.diff
+	_in=test$_tc.in
+	_out=test$_tc.out
+	_pout=test$_tc.pout
+	_lout=test$_tc.lout
+
+	# Convert the test case input file to Unix format.
+	_file=$_in
+	Dos2Unix
+
+	# Convert the test case 'correct' file to Unix format.
+	_file=$_correct
+	Dos2Unix
+
+	# Perform the test.
+	$_binary $_in $_out
+
+	# Convert the test case output file to Unix format, just in case.
+	_file=$_out
+	Dos2Unix
+
+	# Perform the diff command on the test case output file and the test case 'correct' file. If there are
+	# any differences then the .diff file will be nonempty, but if there are no differences, then the .diff
+	# file will not exist. The 'test -s' command tests to see if the .diff file exists. If it does, then
+	# the test case failed. If the .diff file does not exist, then the test case passed.
+	diff $_out $_correct > $_diff
+
+	# Perform the test again on four threads (see ListTestParallel() in ListTest.c). The output must be the same.
+	$_binary $_in $_pout 4
+	_file=$_pout
+	Dos2Unix
+	diff $_pout $_correct >> $_diff
+
+	# And once more pipelined (see ListTestPipeline() in ListTest.c).
+	$_binary $_in $_lout pipeline
+	_file=$_lout
+	Dos2Unix
+	diff $_lout $_correct >> $_diff
+
+	if test -s $_diff; then
+		echo "FAILED. See" $_out"," $_pout "and" $_lout "for output."
+	else
+		rm -f $_diff
+		rm -f $_out
+		rm -f $_pout
+		rm -f $_lout
+		echo "PASSED"
+	fi
+}
+
+#----- StressTest ----------------------------------------------------------------------------------------------
+# Perform the stress test case corresponding to the value of variable _tc. Stress test cases are named
+# stress1.in, stress2.in, ..., and are performed once, by the stress test driver (see StressTest.c).
+#---------------------------------------------------------------------------------------------------------------
+StressTest() {
+	echo -n Performing Stress Test Case $_tc...
+
+	_correct=stress$_tc.correct
+	_diff=stress$_tc.diff
+	_in=stress$_tc.in
+	_out=stress$_tc.out
+
+	_file=$_in
+	Dos2Unix
+	_file=$_correct
+	Dos2Unix
+
+	$_stressbinary $_in $_out
+	_file=$_out
+	Dos2Unix
+	diff $_out $_correct > $_diff
+
+	if test -s $_diff; then
+		echo "FAILED. See" $_out "for output."
+	else
+		rm -f $_diff
+		rm -f $_out
+		echo "PASSED"
+	fi
+}
+
+# _binary is the name of the executable program (i.e., in Unix lingo this is called a binary).
+_binary=./ListTest
+_stressbinary=./StressTest
+
+# Store the current working directory in _currdir. We are going to cd to the testing directory and
+# when we are done testing, we will cd back to the current directory.
+_currdir=`pwd`
+
+# This is the directory containing the test cases.
+_testdir=testcases
+
+# Copy the binary to the test cases directory.
+cp $_binary $_testdir
+cp $_stressbinary $_testdir
+
+# cd to the test cases directory.
+cd $_testdir
+
+# Let _tc take on the values 1, 2, 3, 4, 5. The test case files are named test1.in, test2.in,
+# ..., test5.in. For each value of _tc, call the Test function.
+for _tc in `seq 1 18`; do
+	Test
+done
+
+# And each stress test case.
+for _tc in `seq 1 2`; do
+	StressTest
+done
+
+# cd back to the original working directory.
+cd $_curdir
+
+# Delete all variables.
+_binary=
+_curdir=
+_correct=
+_file=
+_in=
+_lout=
+_out=
+_pout=
+_stressbinary=
+_tc=
+_testdir=
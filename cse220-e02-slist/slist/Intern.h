@@ -0,0 +1,34 @@
+/***************************************************************************************************************
+ * FILE: Intern.h
+ *
+ * DESCRIPTION
+ * The string intern table maps each distinct string to a small integer id. See the comments in Intern.c for
+ * more information.
+ *
+ * AUTHOR INFORMATION
+ * agent [AGT]
+ *
+ * Email: agent@local
+ *
+ * MODIFICATION HISTORY:
+ * -------------------------------------------------------------------------------------------------------------
+ * 17 Oct 2026 [AGT] Initial revision.
+ **************************************************************************************************************/
+#ifndef __INTERN_H__
+#define __INTERN_H__
+
+/*==============================================================================================================
+ * Global function declarations. See function comments in Intern.c
+ *============================================================================================================*/
+extern char *InternGetString
+    (
+    int pId
+    );
+
+extern int InternString
+    (
+    char *pStr,
+    int   pLen
+    );
+
+#endif
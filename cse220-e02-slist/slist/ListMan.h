@@ -20,6 +20,7 @@
  * MODIFICATION HISTORY:
  * -------------------------------------------------------------------------------------------------------------
  * 29 Feb 2012 [KRB] Initial revision.
+ * 17 Oct 2026 [AGT] Lists are identified by interned name ids. See Intern.h.
  **************************************************************************************************************/
 #ifndef __LISTMAN_H__
 #define __LISTMAN_H__
@@ -31,18 +32,18 @@
  *============================================================================================================*/
 extern void ListManCreateList
     (
-    char  *pListName,
+    int    pNameId,
     SList *pNewList
     );
 
 extern void ListManFreeList
     (
-    char *pListname
+    int pNameId
     );
 
 extern SList *ListManGetList
     (
-    char *pListName
+    int pNameId
     );
 
 extern void ListManInit
@@ -19,70 +19,347 @@
  * MODIFICATION HISTORY:
  * -------------------------------------------------------------------------------------------------------------
  * 29 Feb 2012 [KRB] Initial revision.
+ * 17 Oct 2026 [AGT] Words are read by ListTestReadWord(), so list names and commands can be any length. List
+ *                   names are interned and passed to the list manager as name ids.
+ * 17 Oct 2026 [AGT] The input file is mapped into memory and split into tokens by the scanner in Scan.c
+ *                   rather than read with fscanf().
+ * 17 Oct 2026 [AGT] Commands are registered in gCommands[] and dispatched through a perfect hash of the command
+ *                   name rather than an if-else chain of string compares.
+ * 17 Oct 2026 [AGT] Results are written through the buffered writer in Out.c rather than with fprintf().
+ * 17 Oct 2026 [AGT] Added the "appendn" and "appendrange" commands.
+ * 17 Oct 2026 [AGT] Added the "sort" command.
+ * 17 Oct 2026 [AGT] Added "sort list parallel [threads]".
+ * 17 Oct 2026 [AGT] Added the "queuestress" and "stackstress" commands, which test SListLockFree.c.
+ * 17 Oct 2026 [AGT] Added the "regstress" command, which tests ListMan.c on several threads.
+ * 17 Oct 2026 [AGT] Added parallel runs: given a thread count after the file names, ListTest runs commands on
+ *                   different lists on several threads, and writes their output in input order.
+ * 17 Oct 2026 [AGT] Added pipelined runs: given the word pipeline after the file names, ListTest reads the input,
+ *                   performs the commands, and writes the output on three threads at once.
+ * 17 Oct 2026 [AGT] Moved the "queuestress", "stackstress", and "regstress" commands to StressTest.c, so
+ *                   gCommands[] only holds list commands.
+ * 17 Oct 2026 [AGT] A parallel run starts its threads once and hands them each batch, rather than starting
+ *                   threads for every batch. "sort" is a barrier, since it may start threads of its own.
+ * 17 Oct 2026 [AGT] Noted that parallel and pipelined runs are untested for speed-up.
  **************************************************************************************************************/
-#include <stdio.h>    /* For FILE, fprintf(), fscanf(), NULL */
-#include <stdlib.h>   /* For exit() */
+#define _POSIX_C_SOURCE 200112L  /* For pthread_create(), pthread_join(), etc. when compiling with -ansi */
+
+#include <pthread.h>        /* For pthread_cond_wait(), pthread_create(), pthread_mutex_lock(), etc. */
+#include <stdio.h>          /* For fprintf(), NULL */
+#include <stdlib.h>         /* For atoi(), calloc(), exit(), free(), realloc() */
+#include <string.h>         /* For strlen() */
+#include "Intern.h"         /* For InternGetString(), InternString() */
 #include "ListMan.h"
+#include "Out.h"            /* For Out, OutClose(), OutFormat(), OutOpen() */
+#include "Ring.h"           /* For Ring, RingAlloc(), RingFree(), RingPop(), RingPush() */
 #include "SList.h"
-#include "String.h"
+#include "Scan.h"           /* For Scan, Token, ScanNextInt(), ScanNextToken(), ScanNextTokenOnLine(), etc. */
+#include "String.h"         /* For streq() */
+
+/*==============================================================================================================
+ * Preprocessor macro definitions.
+ *============================================================================================================*/
+#define CMD_SLOTS      64       /* Size of the command hash table. Must be a power of 2 >= the number of commands. */
+#define CMD_MAX_SEEDS  4096     /* ListTestInit() gives up if none of this many seeds gives a perfect hash.        */
+#define APPEND_CHUNK   4096     /* "appendn" and "appendrange" append this many values at a time.                  */
+#define BATCH_CMDS     4096     /* Most commands a parallel run gathers before running them.                       */
+#define PARALLEL_MAX   64       /* Most threads a parallel run will use.                                           */
+#define CMD_BARRIER    1        /* The command runs alone, after the commands before it and before those after it. */
+#define PIPE_RING      65536    /* Most commands and operands read by a pipelined run and not yet performed.       */
+#define PIPE_BUFFERS   4        /* Number of writers a pipelined run passes between its last two stages.           */
+#define PIPE_CHUNK     65536    /* A writer is passed on once it holds this many characters.                       */
+
+#define METHOD_MERGE    0  /* The methods of "sort", see ListTestScanMethod(). */
+#define METHOD_RADIX    1
+#define METHOD_PARALLEL 2
+#define METHOD_UNKNOWN  3
+
+/*==============================================================================================================
+ * Typedefs.
+ *============================================================================================================*/
+/*--------------------------------------------------------------------------------------------------------------
+ * What a command handler reads its operands from and writes its results to. gIo, which a serial run uses for
+ * every command and a parallel run for its barrier commands, reads gScan and writes gOut. Each thread of a
+ * parallel run has one of its own, which reads a copy of gScan positioned at the operands of the command it
+ * is running and writes a memory writer (see OutOpenMem()). In a pipelined run, gIo reads the operands from
+ * gPipeIn, already converted by the reading stage, and writes the memory writers of gPipeOut[].
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct {
+    Scan *mIn;                    /* Scanner the operands are read from if mRing is NULL.                    */
+    Ring *mRing;                  /* Ring the operands are read from in a pipelined run, or NULL.            */
+    Out  *mOut;                   /* Writer the results go to.                                               */
+    int   mValues[APPEND_CHUNK];  /* Values read by "appendn" or made by "appendrange", waiting to be appended. */
+} ListTestIo;
+
+/*--------------------------------------------------------------------------------------------------------------
+ * An entry of the command table. mOperands spells out the operands that follow the command name, one letter
+ * each, so a parallel run can step over them and find the list the command names, and a pipelined run can
+ * read them ahead of the command (see ListTestSkip()).
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct {
+    char  *mName;                    /* Name of the command as it appears in the test input file.  */
+    char  *mOperands;                /* The operands, see ListTestSkip().                          */
+    int    mFlags;                   /* CMD_BARRIER or 0.                                          */
+    void (*mHandler)(ListTestIo *);  /* Function that reads the operands and performs the command. */
+} ListTestCmd;
+
+/*--------------------------------------------------------------------------------------------------------------
+ * A command gathered by a parallel run. The commands of a batch are put into groups, one for each list they
+ * name. The commands of a group are linked through mNext in input order and one thread runs them in that
+ * order. mBegin and mEnd locate the output of the command in the memory writer of that thread.
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct {
+    ListTestCmd *mCmd;       /* The command.                                              */
+    char        *mOperands;  /* Where its operands start in the input.                    */
+    int          mNext;      /* Index in gJobs[] of the next command of its group, or -1. */
+    int          mWorker;    /* Index in gWorkers[] of the thread that ran it.            */
+    size_t       mBegin;     /* Offset of its output in the writer of that thread.        */
+    size_t       mEnd;       /* Offset of the end of its output.                          */
+} ListTestJob;
+
+typedef struct {
+    int mFirst;  /* Index in gJobs[] of the first command of the group. */
+    int mLast;   /* Index in gJobs[] of the last command of the group.  */
+    int mName;   /* Name id of the list its commands name.              */
+} ListTestGroup;
+
+/*--------------------------------------------------------------------------------------------------------------
+ * A thread of a parallel run. gWorkers[0] is the main thread.
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct {
+    ListTestIo mIo;      /* What the thread's commands read and write. mIo.mIn points to mCursor. */
+    Scan       mCursor;  /* Copy of gScan positioned at the operands of the command being run.   */
+    int        mId;      /* Index of the thread in gWorkers[].                                   */
+} ListTestWorker;
 
 /*==============================================================================================================
  * Static function declarations.
  *============================================================================================================*/
 static void ListTest
     (
+    int  pThreads,
+    bool pPipeline
+    );
+
+static bool ListTestAppendN
+    (
+    int        pListName,
+    const int *pData,
+    int        pCount
     );
 
 static void ListTestCmdAppend
     (
+    ListTestIo *pIo
+    );
+
+static void ListTestCmdAppendN
+    (
+    ListTestIo *pIo
+    );
+
+static void ListTestCmdAppendRange
+    (
+    ListTestIo *pIo
     );
 
 static void ListTestCmdCreate
     (
+    ListTestIo *pIo
     );
 
 static void ListTestCmdFind
     (
+    ListTestIo *pIo
     );
 
 static void ListTestCmdFree
     (
+    ListTestIo *pIo
     );
 
 static void ListTestCmdInsert
     (
+    ListTestIo *pIo
     );
 
 static void ListTestCmdPrint
     (
+    ListTestIo *pIo
     );
 
 static void ListTestCmdRemove
     (
+    ListTestIo *pIo
+    );
+
+static void ListTestCmdSort
+    (
+    ListTestIo *pIo
+    );
+
+static unsigned ListTestHash
+    (
+    char    *pStr,
+    int      pLen,
+    unsigned pSeed
+    );
+
+static void ListTestInit
+    (
+    );
+
+static int *ListTestListGroup
+    (
+    int pName
+    );
+
+static ListTestCmd *ListTestLookup
+    (
+    Token *pCmd
+    );
+
+static void ListTestParallel
+    (
+    int pThreads
+    );
+
+static void ListTestParallelBatch
+    (
+    ListTestWorker *pWorker
+    );
+
+static void ListTestParallelRun
+    (
+    int pThreads
+    );
+
+static void *ListTestParallelWorker
+    (
+    void *pWorker
+    );
+
+static void ListTestPipeline
+    (
+    );
+
+static void *ListTestPipelineReader
+    (
+    void *pUnused
+    );
+
+static void *ListTestPipelineWriter
+    (
+    void *pUnused
     );
 
-static void ListTestFileClose
+static bool ListTestReadInt
     (
-    FILE *pStream
+    ListTestIo *pIo,
+    int        *pInt
     );
 
-static FILE *ListTestFileOpen
+static int ListTestReadMethod
     (
-    char *pFileName, 
-    char *pMode, 
-    char *pMsg
+    ListTestIo *pIo,
+    int        *pThreads
     );
 
-static void ListTestPerform
+static int ListTestReadName
     (
-    char *pCmd
+    ListTestIo *pIo
+    );
+
+static int ListTestScanMethod
+    (
+    Scan *pScan,
+    int  *pThreads
+    );
+
+static int ListTestScanName
+    (
+    Scan *pScan
+    );
+
+static int ListTestSkip
+    (
+    Scan *pScan,
+    char *pOperands,
+    Ring *pRing
     );
 
 /*==============================================================================================================
  * Global variable definitions.
  *============================================================================================================*/
-static FILE *gFin;
-static FILE *gFout;
+static Scan *gScan;
+static Out  *gOut;
+static ListTestIo gIo;
+
+/*--------------------------------------------------------------------------------------------------------------
+ * The command table. To add a command, write its ListTestCmdXXX() handler and add one line here; nothing else
+ * needs to change. ListTestInit() builds gCmdSlot[] from this table. A command that creates or frees a list,
+ * or uses threads of its own (as "sort list parallel" does), is a barrier in a parallel run; any other command
+ * names one list, first.
+ *------------------------------------------------------------------------------------------------------------*/
+static ListTestCmd gCommands[] = {
+    { "append",      "ni",   0,           ListTestCmdAppend      },
+    { "appendn",     "nv",   0,           ListTestCmdAppendN     },
+    { "appendrange", "niii", 0,           ListTestCmdAppendRange },
+    { "create",      "n",    CMD_BARRIER, ListTestCmdCreate      },
+    { "find",        "ni",   0,           ListTestCmdFind        },
+    { "free",        "n",    CMD_BARRIER, ListTestCmdFree        },
+    { "insert",      "nii",  0,           ListTestCmdInsert      },
+    { "print",       "n",    0,           ListTestCmdPrint       },
+    { "remove",      "ni",   0,           ListTestCmdRemove      },
+    { "sort",        "ns",   CMD_BARRIER, ListTestCmdSort        }
+};
+
+/*--------------------------------------------------------------------------------------------------------------
+ * gCmdSlot[ListTestHash(name, len, gCmdSeed)] is 1 + the index in gCommands[] of the command with that name, or
+ * 0 if no command hashes there. ListTestInit() picks gCmdSeed so no two commands share a slot, so looking up a
+ * command costs one hash and at most one string compare.
+ *------------------------------------------------------------------------------------------------------------*/
+static int      gCmdSlot[CMD_SLOTS];
+static unsigned gCmdSeed;
+
+/*--------------------------------------------------------------------------------------------------------------
+ * The state of a parallel run, see ListTestParallel(). gJobs[] and gGroups[] hold the batch being gathered.
+ * Every list has its own nodes (see SList.h), so commands on different lists can run at the same time.
+ * gListGroup[id] is the index in gGroups[] of the group of the list with name id id, or -1 if it has none yet.
+ *------------------------------------------------------------------------------------------------------------*/
+static ListTestJob     gJobs[BATCH_CMDS];
+static ListTestGroup   gGroups[BATCH_CMDS];
+static int             gJobCount;
+static int             gGroupCount;
+static int             gNextGroup;  /* Index in gGroups[] of the next group a thread will take. */
+static ListTestWorker *gWorkers;
+static int            *gListGroup;
+static int             gListSlots;  /* Number of elements of gListGroup[]. */
+
+/*--------------------------------------------------------------------------------------------------------------
+ * The threads of a parallel run, which are started once by ListTestParallel() and wait between batches. To hand
+ * them a batch, ListTestParallelRun() sets gParallelBusy to the number of threads and adds one to
+ * gParallelBatch; each thread runs its share and takes one off gParallelBusy, and the last one signals
+ * gParallelDone. gParallelQuit tells them to return. All of these are guarded by gParallelLock.
+ *------------------------------------------------------------------------------------------------------------*/
+static pthread_mutex_t gParallelLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  gParallelWake = PTHREAD_COND_INITIALIZER;  /* Signaled when a batch is ready or on quit. */
+static pthread_cond_t  gParallelDone = PTHREAD_COND_INITIALIZER;  /* Signaled when gParallelBusy reaches 0.    */
+static pthread_t       gParallelThreads[PARALLEL_MAX];
+static int             gParallelStarted;  /* Number of threads started, not counting this one.               */
+static int             gParallelBatch;    /* Number of batches handed to the threads so far.                 */
+static int             gParallelBusy;     /* Number of threads still running the current batch.              */
+static bool            gParallelQuit;     /* True once the threads are to return.                            */
+
+/*--------------------------------------------------------------------------------------------------------------
+ * The rings between the stages of a pipelined run, see ListTestPipeline(). gPipeIn carries the commands and
+ * their operands from the reading stage to the executing stage. gPipeFull carries the index in gPipeOut[] of
+ * each writer the executing stage has filled to the writing stage, and gPipeFree carries it back once the
+ * writing stage has written it out.
+ *------------------------------------------------------------------------------------------------------------*/
+static Ring *gPipeIn;
+static Ring *gPipeFull;
+static Ring *gPipeFree;
+static Out  *gPipeOut[PIPE_BUFFERS];
 
 /*==============================================================================================================
  * Function definitions.
@@ -91,7 +368,8 @@ static FILE *gFout;
 /*--------------------------------------------------------------------------------------------------------------
  * FUNCT: main
  * DESCR: Starting point of execution. Opens the input and output files and calls ListTest() to perform the
- *        testing. On return, closes the input and output files and terminates.
+ *        testing, on the number of threads given after the file names, or one, or pipelined if the word pipeline
+ *        is given instead. On return, closes the input and output files and terminates.
  *------------------------------------------------------------------------------------------------------------*/
 int main
     (
@@ -99,24 +377,47 @@ int main
     char *pArgv[]
     )
 {
-    if (pArgc < 3) {
-        fprintf(stderr, "Usage: ListTest inputfile outputfile\n");
+    bool pipeline = pArgc > 3 && streq(pArgv[3], "pipeline");
+    int threads = pArgc > 3 && !pipeline ? atoi(pArgv[3]) : 1;
+    if (pArgc < 3 || threads < 1 || threads > PARALLEL_MAX) {
+        fprintf(stderr, "Usage: ListTest inputfile outputfile [threads | pipeline]\n");
+        exit(-1);
+    }
+    if (!(gScan = ScanOpen(pArgv[1]))) {
+        fprintf(stdout, "Cannot open '%s' for reading. Terminating.\n", pArgv[1]);
+        exit(-1);
+    }
+    if (!(gOut = OutOpen(pArgv[2]))) {
+        fprintf(stdout, "Cannot open '%s' for writing. Terminating.\n", pArgv[2]);
         exit(-1);
     }
-    gFin = ListTestFileOpen(pArgv[1], "rt", "reading");
-    gFout = ListTestFileOpen(pArgv[2], "wt", "writing");
-    ListTest();
-    ListTestFileClose(gFin);
-    ListTestFileClose(gFout);
+    ListTest(threads, pipeline);
+    gScan = ScanClose(gScan);
+    gOut = OutClose(gOut);
     return 0;
 }
 
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestAppendN
+ * DESCR: Appends the pCount values of pData to the list named by pListName with SListAppendN(). Returns true if
+ *        every value was appended.
+ *------------------------------------------------------------------------------------------------------------*/
+static bool ListTestAppendN
+    (
+    int        pListName,
+    const int *pData,
+    int        pCount
+    )
+{
+    return SListAppendN(ListManGetList(pListName), pData, (size_t)pCount) != NULL;
+}
+
 /*--------------------------------------------------------------------------------------------------------------
  * FUNCT: ListTestCmdAppend
  * DESCR: Performs the "append list data" command. Prints the list after appending so it can be inspected to
  *        determine if the SListAppend() function worked correctly.
  * PCODE:
- * Read the 'listname' and 'data' value from gFin.
+ * Read the 'listname' and 'data' value from pIo.
  * Call ListManGetList() to get the list ptr from the list manager database.
  * Call SListAppend() to append 'data' to the list.
  * If the append succeeded then print "appended " data " to " listname.
@@ -124,22 +425,108 @@ int main
  *------------------------------------------------------------------------------------------------------------*/
 static void ListTestCmdAppend
     (
+    ListTestIo *pIo
     )
 {
-    char listname[8];
+    int listname;
     int data;
       SList *list;
-    fscanf(gFin, "%s%d", listname, &data);
+    listname = ListTestReadName(pIo);
+    ListTestReadInt(pIo, &data);
     list = ListManGetList(listname);
-    if (SListAppend(list, data)) fprintf(gFout, "appended %d to %s\n", data, listname);
-    else fprintf(gFout, "failed to append %d to %s\n", data, listname);
+    if (SListAppend(list, data)) OutFormat(pIo->mOut, "appended %d to %s\n", data, InternGetString(listname));
+    else OutFormat(pIo->mOut, "failed to append %d to %s\n", data, InternGetString(listname));
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestCmdAppendN
+ * DESCR: Performs the "appendn list count v1 v2 ..." command, which appends count values to the list with
+ *        SListAppendN() and prints one line for all of them. The values are read and appended APPEND_CHUNK at a
+ *        time, so count may be larger than pIo->mValues[].
+ * PCODE:
+ * Read the listname and count from pIo.
+ * While fewer than count values have been read Do
+ *     Read the next chunk of up to APPEND_CHUNK values into pIo->mValues[]
+ *     If every chunk so far was appended Then Call ListTestAppendN() to append this one
+ * End While
+ * If every chunk was appended Then
+ *     Print "appended ..."
+ * Else
+ *     Print "failed ..."
+ * End If
+ *------------------------------------------------------------------------------------------------------------*/
+static void ListTestCmdAppendN
+    (
+    ListTestIo *pIo
+    )
+{
+    int listname;
+    int count, chunk, i, read;
+    bool done = true;
+    listname = ListTestReadName(pIo);
+    ListTestReadInt(pIo, &count);
+    for (read = 0; read < count; read += chunk) {
+        chunk = count - read < APPEND_CHUNK ? count - read : APPEND_CHUNK;
+        for (i = 0; i < chunk; ++i) ListTestReadInt(pIo, &pIo->mValues[i]);
+        if (done) done = ListTestAppendN(listname, pIo->mValues, chunk);
+    }
+    if (done && count >= 0) OutFormat(pIo->mOut, "appended %d values to %s\n", count, InternGetString(listname));
+    else OutFormat(pIo->mOut, "failed to append %d values to %s\n", count, InternGetString(listname));
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestCmdAppendRange
+ * DESCR: Performs the "appendrange list start end step" command, which appends start, start + step, start +
+ *        2 * step, ... up to but not including end, and prints one line for all of them. A negative step counts
+ *        down. Fails if step is 0.
+ * PCODE:
+ * Read the listname, start, end, and step from pIo.
+ * For value <- start, start + step, ... while value has not reached end Do
+ *     Store value in pIo->mValues[]; when pIo->mValues[] is full, Call ListTestAppendN() to append it and empty it
+ * End For
+ * Call ListTestAppendN() to append what is left in pIo->mValues[].
+ * If step is not 0 and every append succeeded Then
+ *     Print "appended ..."
+ * Else
+ *     Print "failed ..."
+ * End If
+ *------------------------------------------------------------------------------------------------------------*/
+static void ListTestCmdAppendRange
+    (
+    ListTestIo *pIo
+    )
+{
+    int listname;
+    int start, end, step, count = 0, chunk = 0;
+    long value;
+    bool done;
+    listname = ListTestReadName(pIo);
+    ListTestReadInt(pIo, &start);
+    ListTestReadInt(pIo, &end);
+    ListTestReadInt(pIo, &step);
+    done = step != 0;
+    for (value = start; done && (step > 0 ? value < end : value > end); value += step) {
+        pIo->mValues[chunk++] = (int)value;
+        if (chunk == APPEND_CHUNK) {
+            done = ListTestAppendN(listname, pIo->mValues, chunk);
+            count += chunk;
+            chunk = 0;
+        }
+    }
+    if (done && chunk) done = ListTestAppendN(listname, pIo->mValues, chunk);
+    count += chunk;
+    if (done) {
+        OutFormat(pIo->mOut, "appended %d values to %s\n", count, InternGetString(listname));
+    } else {
+        OutFormat(pIo->mOut, "failed to append range %d %d %d to %s\n", start, end, step, InternGetString(listname));
+    }
 }
 
 /*--------------------------------------------------------------------------------------------------------------
  * FUNCT: ListTestCmdCreate
  * DESCR: Performs the "create list" command.
  * PCODE:
- * Read the 'listname' from gFin.
+ * Read the 'listname' from pIo.
  * Call SListAlloc() to create the new list.
  * If the new list was created then
  *   Call ListManCreateList() to add the new list to the list manager database.
@@ -150,16 +537,17 @@ static void ListTestCmdAppend
  *------------------------------------------------------------------------------------------------------------*/
 static void ListTestCmdCreate
     (
+    ListTestIo *pIo
     )
 {
-    char listname[8];
-    fscanf(gFin, "%s", listname);
+    int listname;
+    listname = ListTestReadName(pIo);
        SList *new_list = SListAlloc();
     if (new_list) {
         ListManCreateList(listname, new_list);
-        fprintf(gFout, "%s created\n", listname);
+        OutFormat(pIo->mOut, "%s created\n", InternGetString(listname));
     } else {
-        fprintf(gFout, "failed to create %s\n", listname);
+        OutFormat(pIo->mOut, "failed to create %s\n", InternGetString(listname));
     }
 }
 
@@ -167,7 +555,7 @@ static void ListTestCmdCreate
  * FUNCT: ListTestCmdFind
  * DESCR: Performs the "find list data" command.
  * PCODE:
- * Read the 'listname' and 'data' value from gFin.
+ * Read the 'listname' and 'data' value from pIo.
  * Call ListManGetList() to get the list ptr from the list manager database.
  * Call SListFind() to search for 'data'.
  * If 'data' was found then print "found " data " in " listname.
@@ -175,24 +563,26 @@ static void ListTestCmdCreate
  *------------------------------------------------------------------------------------------------------------*/
 static void ListTestCmdFind
     (
+    ListTestIo *pIo
     )
 {
-    char listname[8];
+    int listname;
     int data;
        SList *list;
     SListNode *found_node;
-    fscanf(gFin, "%s%d", listname, &data);
+    listname = ListTestReadName(pIo);
+    ListTestReadInt(pIo, &data);
     list = ListManGetList(listname);
     found_node = SListFind(list, data);
-    if (found_node) fprintf(gFout, "found %d in %s\n", data, listname);
-    else fprintf(gFout, "failed to find %d in %s\n", data, listname);
+    if (found_node) OutFormat(pIo->mOut, "found %d in %s\n", data, InternGetString(listname));
+    else OutFormat(pIo->mOut, "failed to find %d in %s\n", data, InternGetString(listname));
 }
 
 /*--------------------------------------------------------------------------------------------------------------
  * FUNCT: ListTestCmdFree
  * DESCR: Performs the "free list" command.
  * PCODE:
- * Read the 'listname' from gFin.
+ * Read the 'listname' from pIo.
  * Call ListmanGetList() to get the list ptr from the list manager database.
  * If the list exists
  *   Call SListFree() to free the list.
@@ -205,18 +595,19 @@ static void ListTestCmdFind
  *------------------------------------------------------------------------------------------------------------*/
 static void ListTestCmdFree
     (
+    ListTestIo *pIo
     )
 {
-    char listname[8];
+    int listname;
        SList *list;
-    fscanf(gFin, "%s", listname);
+    listname = ListTestReadName(pIo);
     list = ListManGetList(listname);
     if (list) {
         list = SListFree(list); /* Sanity check. list will be NULL. */
         ListManFreeList(listname);
-        fprintf(gFout, "freed %s\n", listname);
+        OutFormat(pIo->mOut, "freed %s\n", InternGetString(listname));
     } else {
-        fprintf(gFout, "error: %s does not exist\n", listname);
+        OutFormat(pIo->mOut, "error: %s does not exist\n", InternGetString(listname));
     }
 }
 
@@ -224,7 +615,7 @@ static void ListTestCmdFree
  * FUNCT: ListTestCmdInsert
  * DESCR: Performs the "insert list data" command.
  * PCODE:
- * Read the 'listname', the 'index', and the 'data' value from gFin.
+ * Read the 'listname', the 'index', and the 'data' value from pIo.
  * Call ListManGetList() to get the list ptr from the list manager database.
  * Call SListInsert() to insert a new node containing 'data' at 'index'.
  * If succeeded then print "inserted " data " at " index " of " listname.
@@ -232,15 +623,21 @@ static void ListTestCmdFree
  *------------------------------------------------------------------------------------------------------------*/
 static void ListTestCmdInsert
     (
+    ListTestIo *pIo
     )
 {
-    char listname[8];
+    int listname;
     int data, index;
        SList *list;
-    fscanf(gFin, "%s%d%d", listname, &index, &data);
+    listname = ListTestReadName(pIo);
+    ListTestReadInt(pIo, &index);
+    ListTestReadInt(pIo, &data);
     list = ListManGetList(listname);
-    if (SListInsert(list, index, data)) fprintf(gFout, "inserted %d at %d in %s\n", data, index, listname);
-    else fprintf(gFout, "failed to insert %d  %d in %s\n", data, index, listname);
+    if (SListInsert(list, index, data)) {
+        OutFormat(pIo->mOut, "inserted %d at %d in %s\n", data, index, InternGetString(listname));
+    } else {
+        OutFormat(pIo->mOut, "failed to insert %d  %d in %s\n", data, index, InternGetString(listname));
+    }
 }
 
 /*--------------------------------------------------------------------------------------------------------------
@@ -254,17 +651,18 @@ static void ListTestCmdInsert
  *------------------------------------------------------------------------------------------------------------*/
 static void ListTestCmdPrint
     (
+    ListTestIo *pIo
     )
 {
-    char listname[8];
-    fscanf(gFin, "%s", listname);
+    int listname;
+    listname = ListTestReadName(pIo);
        SList *list = ListManGetList(listname);
     if (list) {
-        fprintf(gFout, "%s = ", listname);
-        SListDebugPrint(gFout, list);
-        fprintf(gFout, "\n");
+        OutFormat(pIo->mOut, "%s = ", InternGetString(listname));
+        SListDebugPrint(pIo->mOut, list);
+        OutFormat(pIo->mOut, "\n");
     } else {
-        fprintf(gFout, "%s does not exist\n", listname);
+        OutFormat(pIo->mOut, "%s does not exist\n", InternGetString(listname));
     }
 }
 
@@ -272,7 +670,7 @@ static void ListTestCmdPrint
  * FUNCT: ListTestCmdRemove
  * DESCR Performs the "remove list data" command.
  * PCODE:
- * Read the 'listname' and 'data' value from gFin.
+ * Read the 'listname' and 'data' value from pIo.
  * Call ListManGetList() to get the list ptr from the list manager database.
  * Call SListRemoveData()
  * If the remove succeeded then print "removed " data " from " listname.
@@ -280,82 +678,594 @@ static void ListTestCmdPrint
  *------------------------------------------------------------------------------------------------------------*/
 static void ListTestCmdRemove
     (
+    ListTestIo *pIo
     )
 {
-    char listname[8];
+    int listname;
     int data;
        SList *list;
-    fscanf(gFin, "%s%d", listname, &data);
+    listname = ListTestReadName(pIo);
+    ListTestReadInt(pIo, &data);
+    list = ListManGetList(listname);
+    if (SListRemove(list, data)) OutFormat(pIo->mOut, "removed %d from %s\n", data, InternGetString(listname));
+    else OutFormat(pIo->mOut, "failed to remove %d from %s\n", data, InternGetString(listname));
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestCmdSort
+ * DESCR: Performs the "sort list [merge|radix|parallel [threads]]" command, which sorts the list into ascending
+ *        order with the merge sort of SListSort(), or with the radix sort of SListSortRadix() if the word radix
+ *        follows the list name on the same line, or on several threads with SListSortParallel() if the word
+ *        parallel does. The parallel sort uses the number of threads that follows it, or one per processor if
+ *        there is none. Fails if the method is not merge, radix, or parallel.
+ * PCODE:
+ * Read the listname and the method from pIo, and the number of threads if the method is parallel
+ * If the method is merge, radix, or parallel and sorting succeeds Then
+ *     Print "sorted ..."
+ * Else
+ *     Print "failed ..."
+ * End If
+ *------------------------------------------------------------------------------------------------------------*/
+static void ListTestCmdSort
+    (
+    ListTestIo *pIo
+    )
+{
+    int listname, method, threads;
+    SList *list;
+    char *how = "";
+    bool done = false;
+    listname = ListTestReadName(pIo);
+    method = ListTestReadMethod(pIo, &threads);
     list = ListManGetList(listname);
-    if (SListRemove(list, data)) fprintf(gFout, "removed %d from %s\n", data, listname);
-    else fprintf(gFout, "failed to remove %d from %s\n", data, listname);
+    if (method == METHOD_MERGE) {
+        done = SListSort(list) != NULL;
+    } else if (method == METHOD_RADIX) {
+        how = " by radix sort";
+        done = SListSortRadix(list) != NULL;
+    } else if (method == METHOD_PARALLEL) {
+        how = " in parallel";
+        done = SListSortParallel(list, threads) != NULL;
+    }
+    if (done) {
+        OutFormat(pIo->mOut, "sorted %s%s\n", InternGetString(listname), how);
+    } else {
+        OutFormat(pIo->mOut, "failed to sort %s\n", InternGetString(listname));
+    }
 }
 
 /*--------------------------------------------------------------------------------------------------------------
- * FUNCT: ListTestFileClose
- * DESCR: Closes the file specified by pStream. You close a file the same way whether it was opened for reading
- *        or writing.
+ * FUNCT: ListTestHash
+ * DESCR: Hashes the command name pStr of length pLen into a slot of gCmdSlot[]. Only the length and the first,
+ *        middle, and last characters are mixed in, which is enough to tell the commands apart once a suitable
+ *        pSeed has been found by ListTestInit().
  *------------------------------------------------------------------------------------------------------------*/
-static void ListTestFileClose
+static unsigned ListTestHash
     (
-    FILE *pStream
+    char    *pStr,
+    int      pLen,
+    unsigned pSeed
     )
 {
-    fclose(pStream);
+    unsigned h = pSeed ^ (unsigned)pLen;
+    h = h * 31 + (unsigned char)pStr[0];
+    h = h * 31 + (unsigned char)pStr[pLen / 2];
+    h = h * 31 + (unsigned char)pStr[pLen - 1];
+    h *= 2654435769u;
+    return (h >> 16) & (CMD_SLOTS - 1);
 }
 
 /*--------------------------------------------------------------------------------------------------------------
- * FUNCT: ListTestFileOpen
- * DESCR: Opens the file with name specified by pFilename for reading (if mode is "rt") or writing (if mode is
- *        "wt"). Returns the file pointer. If the file open fails, displays an error message to stderr and
- *        terminates the program with a nonzero return code by calling exit().
- * PCODE:
- * Call fopen() passing pFileName and pMode.
- * If the file was opened successfully (return pointer is nonnull) then return the file pointer.
- * Else file could not be opened. Display an error message and terminate the program with exit(-1).
+ * FUNCT: ListTestInit
+ * DESCR: Builds gCmdSlot[] from gCommands[]. Tries seeds 0, 1, 2, ... until one places every command in a slot
+ *        of its own. If none does, displays an error message and terminates; make CMD_SLOTS larger.
  *------------------------------------------------------------------------------------------------------------*/
-static FILE *ListTestFileOpen
+static void ListTestInit
     (
-    char *pFileName,
-    char *pMode,
-    char *pMsg
     )
 {
-    FILE *fstream = fopen(pFileName, pMode);
-    if (fstream) return fstream;
-    fprintf(stdout, "Cannot open '%s' for %s. Terminating.\n", pFileName, pMsg);
+    int i, num_cmds = sizeof(gCommands) / sizeof(gCommands[0]);
+    for (gCmdSeed = 0; gCmdSeed < CMD_MAX_SEEDS; ++gCmdSeed) {
+        for (i = 0; i < CMD_SLOTS; ++i) gCmdSlot[i] = 0;
+        for (i = 0; i < num_cmds; ++i) {
+            char *name = gCommands[i].mName;
+            unsigned slot = ListTestHash(name, (int)strlen(name), gCmdSeed);
+            if (gCmdSlot[slot]) break;
+            gCmdSlot[slot] = i + 1;
+        }
+        if (i == num_cmds) return;
+    }
+    fprintf(stderr, "Error, cannot build the command table; increase CMD_SLOTS\n");
     exit(-1);
 }
 
 /*--------------------------------------------------------------------------------------------------------------
- * FUNCT: ListTestPerform
- * DESCR: Performs the specified command 'cmd' that was read from the test input file.
+ * FUNCT: ListTestListGroup
+ * DESCR: Returns a pointer to the element of gListGroup[] for the list with name id pName, growing gListGroup[]
+ *        first if pName is past its end. The new lists have no group. If memory cannot be allocated, displays
+ *        an error message and terminates.
+ *------------------------------------------------------------------------------------------------------------*/
+static int *ListTestListGroup
+    (
+    int pName
+    )
+{
+    int slots = gListSlots ? gListSlots : 64;
+    if (pName >= gListSlots) {
+        while (slots <= pName) slots *= 2;
+        if (!(gListGroup = (int *)realloc(gListGroup, slots * sizeof(int)))) {
+            fprintf(stderr, "Error, cannot grow the list groups to %d lists\n", slots);
+            exit(-1);
+        }
+        while (gListSlots < slots) gListGroup[gListSlots++] = -1;
+    }
+    return &gListGroup[pName];
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestLookup
+ * DESCR: Returns the entry of gCommands[] for the command name pCmd that was read from the test input file. If
+ *        there is no such command, displays a message and returns NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+static ListTestCmd *ListTestLookup
+    (
+    Token *pCmd
+    )
+{
+    int slot = gCmdSlot[ListTestHash(pCmd->mStr, pCmd->mLen, gCmdSeed)];
+    if (slot && TokenEq(pCmd, gCommands[slot - 1].mName)) return &gCommands[slot - 1];
+    fprintf(stdout, "Unknown command '%.*s', ignoring.\n", pCmd->mLen, pCmd->mStr);
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestParallel
+ * DESCR: Performs the commands of the test input file on pThreads threads, writing the same output file that
+ *        performing them one after another would. The commands are gathered in batches of up to BATCH_CMDS.
+ *        A command that is not a barrier names one list, and goes in the group of that list, so commands on
+ *        different lists are in different groups and may run at the same time, while the commands on one list
+ *        run in input order. When a barrier command, or the end of the file, is reached, the batch is run by
+ *        ListTestParallelRun() and then the barrier command is performed alone on this thread. The threads are
+ *        started once, before the first batch, and wait between batches. The operands of each command are
+ *        stepped over with ListTestSkip() as it is gathered; that also interns the list name, so the threads
+ *        only look names up. Whether this runs faster than a serial run is untested: the test cases check that
+ *        the output is the same, but they have only been run on one core.
+ * PCODE:
+ * Allocate the workers, each with a memory writer. If memory cannot be allocated, display a message and exit.
+ * Start pThreads - 1 threads  -- Hint: Call pthread_create() with ListTestParallelWorker()
+ * While there is another command in the input Do
+ *     Step over its operands, remembering where they start and the list they name
+ *     If the command is a barrier Then
+ *         Run the batch, then move gScan back to the operands and perform the command with gIo
+ *     Else
+ *         Add it to the batch, in the group of its list, starting a new group if the list has none
+ *         Run the batch if it is full
+ *     End If
+ * End While
+ * Run the batch, tell the threads to return and join them, and deallocate the workers and gListGroup[].
+ *------------------------------------------------------------------------------------------------------------*/
+static void ListTestParallel
+    (
+    int pThreads
+    )
+{
+    Token cmd;
+    ListTestCmd *command;
+    char *operands;
+    int name, *list_group, group, i;
+    if (!(gWorkers = (ListTestWorker *)calloc(pThreads, sizeof(ListTestWorker)))) {
+        fprintf(stderr, "Error, cannot allocate %d threads\n", pThreads);
+        exit(-1);
+    }
+    for (i = 0; i < pThreads; ++i) {
+        gWorkers[i].mIo.mIn = &gWorkers[i].mCursor;
+        gWorkers[i].mId = i;
+        if (!(gWorkers[i].mIo.mOut = OutOpenMem())) {
+            fprintf(stderr, "Error, cannot allocate %d threads\n", pThreads);
+            exit(-1);
+        }
+    }
+    gParallelBatch = 0;
+    gParallelQuit = false;
+    for (gParallelStarted = 0; gParallelStarted < pThreads - 1; ++gParallelStarted) {
+        if (pthread_create(&gParallelThreads[gParallelStarted], NULL, ListTestParallelWorker,
+            &gWorkers[gParallelStarted + 1]) != 0) break;
+    }
+    while (ScanNextToken(gScan, &cmd)) {
+        if (!(command = ListTestLookup(&cmd))) continue;
+        operands = gScan->mPos;
+        name = ListTestSkip(gScan, command->mOperands, NULL);
+        if (command->mFlags & CMD_BARRIER) {
+            ListTestParallelRun(pThreads);
+            gScan->mPos = operands;
+            command->mHandler(&gIo);
+            continue;
+        }
+        list_group = ListTestListGroup(name);
+        if ((group = *list_group) < 0) {
+            group = *list_group = gGroupCount++;
+            gGroups[group].mFirst = gJobCount;
+            gGroups[group].mName = name;
+        } else {
+            gJobs[gGroups[group].mLast].mNext = gJobCount;
+        }
+        gGroups[group].mLast = gJobCount;
+        gJobs[gJobCount].mCmd = command;
+        gJobs[gJobCount].mOperands = operands;
+        gJobs[gJobCount].mNext = -1;
+        if (++gJobCount == BATCH_CMDS) ListTestParallelRun(pThreads);
+    }
+    ListTestParallelRun(pThreads);
+    pthread_mutex_lock(&gParallelLock);
+    gParallelQuit = true;
+    pthread_cond_broadcast(&gParallelWake);
+    pthread_mutex_unlock(&gParallelLock);
+    for (i = 0; i < gParallelStarted; ++i) pthread_join(gParallelThreads[i], NULL);
+    for (i = 0; i < pThreads; ++i) gWorkers[i].mIo.mOut = OutClose(gWorkers[i].mIo.mOut);
+    free(gWorkers);
+    free(gListGroup);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestParallelBatch
+ * DESCR: Runs the share of the current batch of thread pWorker: takes groups from gGroups[] until there are
+ *        none left, and performs the commands of each in order, reading the operands of each through a copy of
+ *        gScan and recording where its output is in the writer of the thread.
+ *------------------------------------------------------------------------------------------------------------*/
+static void ListTestParallelBatch
+    (
+    ListTestWorker *pWorker
+    )
+{
+    Out *out = pWorker->mIo.mOut;
+    ListTestJob *job;
+    int group, next;
+    while ((group = __atomic_fetch_add(&gNextGroup, 1, __ATOMIC_RELAXED)) < gGroupCount) {
+        for (next = gGroups[group].mFirst; next >= 0; next = job->mNext) {
+            job = &gJobs[next];
+            pWorker->mCursor = *gScan;
+            pWorker->mCursor.mPos = job->mOperands;
+            job->mWorker = pWorker->mId;
+            job->mBegin = out->mPos - out->mBuf;
+            job->mCmd->mHandler(&pWorker->mIo);
+            job->mEnd = out->mPos - out->mBuf;
+        }
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestParallelRun
+ * DESCR: Runs the batch of commands in gJobs[] on the threads started by ListTestParallel() and on this one,
+ *        each taking the next group that no thread has taken until there are none left (see
+ *        ListTestParallelBatch()). Once every thread is done, copies the output of each command, in input
+ *        order, from the writer of the thread that ran it to gOut, and empties the batch. If fewer threads
+ *        could be started than pThreads - 1, the others run their share.
+ * PCODE:
+ * If the batch is empty Then return
+ * Hand the batch to the threads  -- set gParallelBusy, add one to gParallelBatch, and signal gParallelWake
+ * Run the share of this thread, then wait on gParallelDone until gParallelBusy is 0
+ * Copy the output of each command to gOut, rewind the writers, and empty the batch
+ *------------------------------------------------------------------------------------------------------------*/
+static void ListTestParallelRun
+    (
+    int pThreads
+    )
+{
+    int i;
+    Out *out;
+    if (!gJobCount) return;
+    gNextGroup = 0;
+    pthread_mutex_lock(&gParallelLock);
+    gParallelBusy = gParallelStarted;
+    ++gParallelBatch;
+    pthread_cond_broadcast(&gParallelWake);
+    pthread_mutex_unlock(&gParallelLock);
+    ListTestParallelBatch(&gWorkers[0]);
+    pthread_mutex_lock(&gParallelLock);
+    while (gParallelBusy) pthread_cond_wait(&gParallelDone, &gParallelLock);
+    pthread_mutex_unlock(&gParallelLock);
+    for (i = 0; i < gJobCount; ++i) {
+        out = gWorkers[gJobs[i].mWorker].mIo.mOut;
+        OutMem(gOut, out->mBuf + gJobs[i].mBegin, gJobs[i].mEnd - gJobs[i].mBegin);
+    }
+    for (i = 0; i < pThreads; ++i) OutRewind(gWorkers[i].mIo.mOut);
+    for (i = 0; i < gGroupCount; ++i) gListGroup[gGroups[i].mName] = -1;
+    gJobCount = gGroupCount = 0;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestParallelWorker
+ * DESCR: The body of each thread of a parallel run but this one, given its ListTestWorker in pWorker. Waits on
+ *        gParallelWake for each batch that ListTestParallelRun() hands out, runs its share of it (see
+ *        ListTestParallelBatch()), and says it is done through gParallelBusy, until gParallelQuit is set.
+ *------------------------------------------------------------------------------------------------------------*/
+static void *ListTestParallelWorker
+    (
+    void *pWorker
+    )
+{
+    int batch = 0;
+    pthread_mutex_lock(&gParallelLock);
+    for (;;) {
+        while (batch == gParallelBatch && !gParallelQuit) pthread_cond_wait(&gParallelWake, &gParallelLock);
+        if (batch == gParallelBatch) break;
+        batch = gParallelBatch;
+        pthread_mutex_unlock(&gParallelLock);
+        ListTestParallelBatch((ListTestWorker *)pWorker);
+        pthread_mutex_lock(&gParallelLock);
+        if (--gParallelBusy == 0) pthread_cond_signal(&gParallelDone);
+    }
+    pthread_mutex_unlock(&gParallelLock);
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestPipeline
+ * DESCR: Performs the commands of the test input file in three stages on three threads, connected by rings
+ *        (see Ring.c). ListTestPipelineReader() reads the input and hands each command, with its operands
+ *        already converted to ints and name ids, to this thread through gPipeIn. This thread performs the
+ *        commands, writing their output to the memory writers of gPipeOut[], and hands each writer to
+ *        ListTestPipelineWriter() through gPipeFull once PIPE_CHUNK characters are in it. That thread writes it
+ *        to the output file and hands it back through gPipeFree. So the input is read and the output written
+ *        while the lists are being changed, and since each stage keeps the order it was given, the output file
+ *        is the same as performing the commands one after another would write. If memory cannot be allocated
+ *        or a thread cannot be started, displays an error message and terminates. Untested for speed-up: it has
+ *        only been checked to write the same output, on a machine with one core, where the three stages take
+ *        turns rather than overlap.
+ * PCODE:
+ * Allocate the rings and the writers, put every writer but the first on gPipeFree, and start the other stages
+ * While the reader hands over another command Do
+ *     Perform it, reading its operands from gPipeIn and writing to the current writer
+ *     If the writer holds PIPE_CHUNK characters Then hand it to the writing stage and take a free one
+ * End While
+ * Hand the last writer and then -1 to the writing stage, wait for both stages to finish, and deallocate
+ *------------------------------------------------------------------------------------------------------------*/
+static void ListTestPipeline
+    (
+    )
+{
+    pthread_t reader, writer;
+    int command, buffer = 0, i;
+    gPipeIn = RingAlloc(PIPE_RING);
+    gPipeFull = RingAlloc(PIPE_BUFFERS + 1);
+    gPipeFree = RingAlloc(PIPE_BUFFERS);
+    for (i = 0; i < PIPE_BUFFERS; ++i) gPipeOut[i] = OutOpenMem();
+    for (i = 0; gPipeIn && gPipeFull && gPipeFree && i < PIPE_BUFFERS && gPipeOut[i]; ++i) continue;
+    if (i < PIPE_BUFFERS) {
+        fprintf(stderr, "Error, cannot allocate the pipeline\n");
+        exit(-1);
+    }
+    for (i = 1; i < PIPE_BUFFERS; ++i) RingPush(gPipeFree, i);
+    gIo.mRing = gPipeIn;
+    gIo.mOut = gPipeOut[buffer];
+    if (pthread_create(&reader, NULL, ListTestPipelineReader, NULL) != 0 ||
+        pthread_create(&writer, NULL, ListTestPipelineWriter, NULL) != 0) {
+        fprintf(stderr, "Error, cannot start the pipeline threads\n");
+        exit(-1);
+    }
+    while ((command = RingPop(gPipeIn)) >= 0) {
+        gCommands[command].mHandler(&gIo);
+        if (gIo.mOut->mPos - gIo.mOut->mBuf >= PIPE_CHUNK) {
+            RingPush(gPipeFull, buffer);
+            buffer = RingPop(gPipeFree);
+            gIo.mOut = gPipeOut[buffer];
+        }
+    }
+    RingPush(gPipeFull, buffer);
+    RingPush(gPipeFull, -1);
+    pthread_join(reader, NULL);
+    pthread_join(writer, NULL);
+    gIo.mRing = NULL;
+    gIo.mOut = gOut;
+    for (i = 0; i < PIPE_BUFFERS; ++i) gPipeOut[i] = OutClose(gPipeOut[i]);
+    gPipeIn = RingFree(gPipeIn);
+    gPipeFull = RingFree(gPipeFull);
+    gPipeFree = RingFree(gPipeFree);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestPipelineReader
+ * DESCR: The body of the reading stage of a pipelined run, see ListTestPipeline(). Reads each command of the
+ *        input and pushes its index in gCommands[] and then its operands onto gPipeIn, with ListTestSkip(). An
+ *        unknown command is reported and dropped. Pushes -1 at the end of the input.
+ *------------------------------------------------------------------------------------------------------------*/
+static void *ListTestPipelineReader
+    (
+    void *pUnused
+    )
+{
+    Token cmd;
+    ListTestCmd *command;
+    while (ScanNextToken(gScan, &cmd)) {
+        if (!(command = ListTestLookup(&cmd))) continue;
+        RingPush(gPipeIn, (int)(command - gCommands));
+        ListTestSkip(gScan, command->mOperands, gPipeIn);
+    }
+    RingPush(gPipeIn, -1);
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestPipelineWriter
+ * DESCR: The body of the writing stage of a pipelined run, see ListTestPipeline(). Pops the index of each full
+ *        writer of gPipeOut[] from gPipeFull, copies what is in it to gOut, empties it, and pushes it back onto
+ *        gPipeFree, until it pops -1. Then flushes gOut.
+ *------------------------------------------------------------------------------------------------------------*/
+static void *ListTestPipelineWriter
+    (
+    void *pUnused
+    )
+{
+    Out *out;
+    int buffer;
+    while ((buffer = RingPop(gPipeFull)) >= 0) {
+        out = gPipeOut[buffer];
+        OutMem(gOut, out->mBuf, out->mPos - out->mBuf);
+        OutRewind(out);
+        RingPush(gPipeFree, buffer);
+    }
+    OutFlush(gOut);
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestReadInt
+ * DESCR: Reads an int operand of a command into *pInt, from pIo->mRing if the command is being performed by a
+ *        pipelined run, or else from pIo->mIn with ScanNextInt(). Returns false, and stores 0, if there is no
+ *        int in the input; in a pipelined run the reading stage has done that already, and true is returned.
+ *------------------------------------------------------------------------------------------------------------*/
+static bool ListTestReadInt
+    (
+    ListTestIo *pIo,
+    int        *pInt
+    )
+{
+    if (!pIo->mRing) return ScanNextInt(pIo->mIn, pInt);
+    *pInt = RingPop(pIo->mRing);
+    return true;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestReadMethod
+ * DESCR: Reads the optional method of the "sort" command, and its thread count if it is parallel, from pIo the
+ *        way ListTestReadInt() reads an int (see ListTestScanMethod()). Returns one of the METHOD_ macros.
  *------------------------------------------------------------------------------------------------------------*/
-static void ListTestPerform
+static int ListTestReadMethod
     (
-    char *pCmd
+    ListTestIo *pIo,
+    int        *pThreads
     )
 {
-    if      (streq(pCmd, "append")) ListTestCmdAppend();
-    else if (streq(pCmd, "create")) ListTestCmdCreate();
-    else if (streq(pCmd, "free"))   ListTestCmdFree();
-    else if (streq(pCmd, "find"))  ListTestCmdFind();
-    else if (streq(pCmd, "insert")) ListTestCmdInsert();
-    else if (streq(pCmd, "print"))  ListTestCmdPrint();
-    else if (streq(pCmd, "remove")) ListTestCmdRemove();
-    else fprintf(stdout, "Unknown command '%s', ignoring.\n", pCmd);
+    int method;
+    if (!pIo->mRing) return ListTestScanMethod(pIo->mIn, pThreads);
+    method = RingPop(pIo->mRing);
+    *pThreads = method == METHOD_PARALLEL ? RingPop(pIo->mRing) : 0;
+    return method;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestReadName
+ * DESCR: Reads a list name operand of a command from pIo the way ListTestReadInt() reads an int, and returns
+ *        its name id (see ListTestScanName()).
+ *------------------------------------------------------------------------------------------------------------*/
+static int ListTestReadName
+    (
+    ListTestIo *pIo
+    )
+{
+    return pIo->mRing ? RingPop(pIo->mRing) : ListTestScanName(pIo->mIn);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestScanMethod
+ * DESCR: Reads the optional method of the "sort" command from pScan: merge, radix, or parallel followed by a
+ *        thread count, which is stored in *pThreads (0 if there is none, and for the other methods). Only a
+ *        word on the same line as the list name is a method; if there is none, the method is merge. Returns
+ *        METHOD_MERGE, METHOD_RADIX, METHOD_PARALLEL, or METHOD_UNKNOWN if the word is not a method.
+ *------------------------------------------------------------------------------------------------------------*/
+static int ListTestScanMethod
+    (
+    Scan *pScan,
+    int  *pThreads
+    )
+{
+    Token method;
+    *pThreads = 0;
+    if (!ScanNextTokenOnLine(pScan, &method) || TokenEq(&method, "merge")) return METHOD_MERGE;
+    if (TokenEq(&method, "radix")) return METHOD_RADIX;
+    if (!TokenEq(&method, "parallel")) return METHOD_UNKNOWN;
+    ScanNextInt(pScan, pThreads);
+    return METHOD_PARALLEL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestScanName
+ * DESCR: Reads a list name from pScan and returns its name id (see Intern.c). A name at the end of the file is
+ *        read as the empty string.
+ *------------------------------------------------------------------------------------------------------------*/
+static int ListTestScanName
+    (
+    Scan *pScan
+    )
+{
+    Token name;
+    if (!ScanNextToken(pScan, &name)) return InternString("", 0);
+    return InternString(name.mStr, name.mLen);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: ListTestSkip
+ * DESCR: Reads the operands of a command from pScan as its handler would, without performing the command. Each
+ *        letter of pOperands is one operand: 'n' a list name, 'i' an int, 'v' a count followed by that many
+ *        ints, and 's' the optional method of "sort" and, after "parallel", its thread count. If pRing is not
+ *        NULL, pushes each operand onto it as it is read: a list name as its name id, and the method of "sort"
+ *        as one of the METHOD_ macros, followed by the thread count if it is METHOD_PARALLEL. Returns the name
+ *        id of the first list name, or 0 if there is none.
+ *------------------------------------------------------------------------------------------------------------*/
+static int ListTestSkip
+    (
+    Scan *pScan,
+    char *pOperands,
+    Ring *pRing
+    )
+{
+    int first = 0, names = 0, name, value, count, method;
+    for (; *pOperands; ++pOperands) {
+        switch (*pOperands) {
+            case 'n':
+                name = ListTestScanName(pScan);
+                if (!names++) first = name;
+                if (pRing) RingPush(pRing, name);
+                break;
+            case 'v':
+                ScanNextInt(pScan, &count);
+                if (pRing) RingPush(pRing, count);
+                while (count-- > 0) {
+                    ScanNextInt(pScan, &value);
+                    if (pRing) RingPush(pRing, value);
+                }
+                break;
+            case 's':
+                method = ListTestScanMethod(pScan, &value);
+                if (pRing) RingPush(pRing, method);
+                if (pRing && method == METHOD_PARALLEL) RingPush(pRing, value);
+                break;
+            default:
+                ScanNextInt(pScan, &value);
+                if (pRing) RingPush(pRing, value);
+                break;
+        }
+    }
+    return first;
 }
 
 /*--------------------------------------------------------------------------------------------------------------
  * FUNCT: ListTest
  * DESCR: Tests the linked list implementation by reading and performing various commands from a testing input
- *        file.
+ *        file. If pPipeline is true, they are performed by the stages of ListTestPipeline(); otherwise, if
+ *        pThreads is more than one, on that many threads by ListTestParallel(), or else one after another.
  *------------------------------------------------------------------------------------------------------------*/
 static void ListTest
     (
+    int  pThreads,
+    bool pPipeline
     )
 {
-    char cmd[9];
+    Token cmd;
+    ListTestCmd *command;
     ListManInit();
-    while (fscanf(gFin, "%s", cmd) != EOF) ListTestPerform(cmd);
+    ListTestInit();
+    gIo.mIn = gScan;
+    gIo.mOut = gOut;
+    if (pPipeline) {
+        ListTestPipeline();
+        return;
+    }
+    if (pThreads > 1) {
+        ListTestParallel(pThreads);
+        return;
+    }
+    while (ScanNextToken(gScan, &cmd)) {
+        if ((command = ListTestLookup(&cmd))) command->mHandler(&gIo);
+    }
 }
@@ -0,0 +1,410 @@
+/***************************************************************************************************************
+ * FILE: Out.c
+ *
+ * DESCRIPTION
+ * The buffered output writer. Everything written to the test output file goes into one large buffer which is
+ * handed to the kernel with write() when it fills up and when the file is closed. Compared with fprintf() this
+ * skips the format string interpretation for list contents entirely: a list is printed by reserving room in
+ * the buffer with OutReserve() and converting each element straight into it with OutItoa(), which produces two
+ * digits per step from a lookup table. A block of memory that is larger than the buffer is written together
+ * with whatever is already buffered in a single writev() call rather than being copied.
+ *
+ * A memory writer, made by OutOpenMem(), has no file. Where a file writer would flush, a memory writer doubles
+ * its buffer, so it holds everything written to it until OutRewind() empties it. The test driver gives one to
+ * each thread of a parallel run and copies the output of each command from it to the output file in order.
+ *
+ * AUTHOR INFORMATION
+ * agent [AGT]
+ *
+ * Email: agent@local
+ *
+ * MODIFICATION HISTORY:
+ * -------------------------------------------------------------------------------------------------------------
+ * 17 Oct 2026 [AGT] Initial revision.
+ * 17 Oct 2026 [AGT] Added memory writers, OutOpenMem() and OutRewind().
+ **************************************************************************************************************/
+#define _POSIX_C_SOURCE 200112L  /* For write(), writev(), etc. when compiling with -ansi */
+
+#include <assert.h>     /* For assert() */
+#include <errno.h>      /* For errno, EINTR */
+#include <fcntl.h>      /* For open(), O_CREAT, O_TRUNC, O_WRONLY */
+#include <stdarg.h>     /* For va_arg(), va_end(), va_list, va_start() */
+#include <stdio.h>      /* For fprintf() */
+#include <stdlib.h>     /* For exit(), free(), malloc(), realloc() */
+#include <string.h>     /* For memcpy(), strlen() */
+#include <sys/uio.h>    /* For struct iovec, writev() */
+#include <unistd.h>     /* For close(), write() */
+#include "Out.h"
+
+/*==============================================================================================================
+ * Preprocessor macro definitions.
+ *============================================================================================================*/
+#define OUT_BUF_SIZE (1 << 20)  /* Size of the output buffer in bytes.                */
+#define OUT_MEM_SIZE (1 << 12)  /* Size a memory writer's buffer starts at, in bytes. */
+
+/*==============================================================================================================
+ * Static function declarations.
+ *============================================================================================================*/
+static void OutMakeRoom
+    (
+    Out    *pOut,
+    size_t  pLen
+    );
+
+static void OutWritev
+    (
+    Out          *pOut,
+    struct iovec *pIov,
+    int           pCount
+    );
+
+/*==============================================================================================================
+ * Static global variable definitions.
+ *============================================================================================================*/
+/*--------------------------------------------------------------------------------------------------------------
+ * The decimal representation of 00, 01, ..., 99, two characters each, so OutItoa() can convert two digits at
+ * a time.
+ *------------------------------------------------------------------------------------------------------------*/
+static const char gDigitPairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/*==============================================================================================================
+ * Function definitions.
+ *============================================================================================================*/
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: OutChar
+ * DESCR: Writes the character pChar.
+ *------------------------------------------------------------------------------------------------------------*/
+void OutChar
+    (
+    Out  *pOut,
+    char  pChar
+    )
+{
+    if (pOut->mPos == pOut->mEnd) OutMakeRoom(pOut, 1);
+    *pOut->mPos++ = pChar;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: OutClose
+ * DESCR: Flushes the buffer, closes the file, and deallocates pOut. Returns NULL. Does nothing if pOut is NULL.
+ *        The contents of a memory writer are discarded.
+ *------------------------------------------------------------------------------------------------------------*/
+Out *OutClose
+    (
+    Out *pOut
+    )
+{
+    if (!pOut) return NULL;
+    if (pOut->mFd >= 0) {
+        OutFlush(pOut);
+        close(pOut->mFd);
+    }
+    free(pOut->mBuf);
+    free(pOut);
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: OutCommit
+ * DESCR: Ends a write that was started with OutReserve(). pPos is one past the last character that was stored
+ *        in the reserved space.
+ *------------------------------------------------------------------------------------------------------------*/
+void OutCommit
+    (
+    Out  *pOut,
+    char *pPos
+    )
+{
+    assert(pPos >= pOut->mPos && pPos <= pOut->mEnd);
+    pOut->mPos = pPos;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: OutFlush
+ * DESCR: Writes the contents of the buffer to the file and empties the buffer. Does nothing to a memory writer.
+ *------------------------------------------------------------------------------------------------------------*/
+void OutFlush
+    (
+    Out *pOut
+    )
+{
+    struct iovec iov;
+    if (pOut->mFd < 0) return;
+    iov.iov_base = pOut->mBuf;
+    iov.iov_len = pOut->mPos - pOut->mBuf;
+    OutWritev(pOut, &iov, 1);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: OutFormat
+ * DESCR: A small printf(). Writes pFmt with each %d replaced by the next int argument and each %s by the next
+ *        string argument. %% writes a single %. No other conversions, flags, or widths are supported.
+ *------------------------------------------------------------------------------------------------------------*/
+void OutFormat
+    (
+    Out  *pOut,
+    char *pFmt,
+    ...
+    )
+{
+    va_list args;
+    char *run = pFmt;
+    va_start(args, pFmt);
+    for (;;) {
+        while (*pFmt && *pFmt != '%') ++pFmt;
+        OutMem(pOut, run, pFmt - run);
+        if (!*pFmt) break;
+        switch (pFmt[1]) {
+            case 'd': OutInt(pOut, va_arg(args, int)); break;
+            case 's': OutStr(pOut, va_arg(args, char *)); break;
+            default:  assert(pFmt[1] == '%'); OutChar(pOut, '%'); break;
+        }
+        run = pFmt += 2;
+    }
+    va_end(args);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: OutInt
+ * DESCR: Writes pInt in decimal.
+ *------------------------------------------------------------------------------------------------------------*/
+void OutInt
+    (
+    Out *pOut,
+    int  pInt
+    )
+{
+    OutCommit(pOut, OutItoa(OutReserve(pOut, OUT_INT_CHARS), pInt));
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: OutItoa
+ * DESCR: Stores pInt in decimal at pDst, which must have room for OUT_INT_CHARS characters. No null character
+ *        is stored. Returns a pointer to one past the last character stored.
+ * PCODE:
+ * Store the sign and work with the magnitude as an unsigned int, so INT_MIN needs no special case.
+ * Count the digits so the number can be written from its last digit back to its first in place.
+ * Store two digits at a time from gDigitPairs[] while at least two remain, then the last one if there is one.
+ *------------------------------------------------------------------------------------------------------------*/
+char *OutItoa
+    (
+    char *pDst,
+    int   pInt
+    )
+{
+    unsigned value = pInt < 0 ? 0u - (unsigned)pInt : (unsigned)pInt;
+    unsigned pair;
+    char *end;
+    if (pInt < 0) *pDst++ = '-';
+    end = pDst + (value < 10 ? 1 : value < 100 ? 2 : value < 1000 ? 3 : value < 10000 ? 4 : value < 100000 ? 5 :
+        value < 1000000 ? 6 : value < 10000000 ? 7 : value < 100000000 ? 8 : value < 1000000000 ? 9 : 10);
+    pDst = end;
+    while (value >= 100) {
+        pair = (value % 100) * 2;
+        value /= 100;
+        *--pDst = gDigitPairs[pair + 1];
+        *--pDst = gDigitPairs[pair];
+    }
+    if (value >= 10) {
+        *--pDst = gDigitPairs[value * 2 + 1];
+        *--pDst = gDigitPairs[value * 2];
+    } else {
+        *--pDst = (char)('0' + value);
+    }
+    return end;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: OutMakeRoom
+ * DESCR: Makes room in the buffer for pLen more characters. A file writer is flushed, which empties the whole
+ *        buffer; pLen must not be larger than the buffer. A memory writer's buffer is doubled until they fit.
+ *        If memory cannot be allocated, displays an error message and terminates.
+ *------------------------------------------------------------------------------------------------------------*/
+static void OutMakeRoom
+    (
+    Out    *pOut,
+    size_t  pLen
+    )
+{
+    size_t used = pOut->mPos - pOut->mBuf, size = pOut->mEnd - pOut->mBuf;
+    char *buf;
+    if (pOut->mFd >= 0) {
+        OutFlush(pOut);
+        return;
+    }
+    if (size - used >= pLen) return;
+    while (size - used < pLen) size *= 2;
+    if (!(buf = (char *)realloc(pOut->mBuf, size))) {
+        fprintf(stderr, "Error, cannot grow an output buffer to %lu bytes\n", (unsigned long)size);
+        exit(-1);
+    }
+    pOut->mBuf = buf;
+    pOut->mPos = buf + used;
+    pOut->mEnd = buf + size;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: OutMem
+ * DESCR: Writes the pLen characters starting at pMem. If they do not fit in the buffer they are written along
+ *        with the buffer contents by one writev() rather than being copied, or, for a memory writer, the buffer
+ *        is grown to fit them.
+ *------------------------------------------------------------------------------------------------------------*/
+void OutMem
+    (
+    Out    *pOut,
+    char   *pMem,
+    size_t  pLen
+    )
+{
+    struct iovec iov[2];
+    if (pOut->mFd < 0) OutMakeRoom(pOut, pLen);
+    if (pLen <= (size_t)(pOut->mEnd - pOut->mPos)) {
+        memcpy(pOut->mPos, pMem, pLen);
+        pOut->mPos += pLen;
+        return;
+    }
+    iov[0].iov_base = pOut->mBuf;
+    iov[0].iov_len = pOut->mPos - pOut->mBuf;
+    iov[1].iov_base = pMem;
+    iov[1].iov_len = pLen;
+    OutWritev(pOut, iov, 2);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: OutOpen
+ * DESCR: Creates (or truncates) the file pFileName for writing and allocates its buffer. Returns NULL if the
+ *        file cannot be opened or memory cannot be allocated.
+ *------------------------------------------------------------------------------------------------------------*/
+Out *OutOpen
+    (
+    char *pFileName
+    )
+{
+    Out *out = (Out *)malloc(sizeof(Out));
+    if (!out) return NULL;
+    if (!(out->mBuf = (char *)malloc(OUT_BUF_SIZE))) {
+        free(out);
+        return NULL;
+    }
+    if ((out->mFd = open(pFileName, O_WRONLY | O_CREAT | O_TRUNC, 0666)) < 0) {
+        free(out->mBuf);
+        free(out);
+        return NULL;
+    }
+    out->mPos = out->mBuf;
+    out->mEnd = out->mBuf + OUT_BUF_SIZE;
+    return out;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: OutOpenMem
+ * DESCR: Allocates a memory writer, which keeps what is written to it in its buffer rather than writing it to a
+ *        file. Returns NULL if memory cannot be allocated.
+ *------------------------------------------------------------------------------------------------------------*/
+Out *OutOpenMem
+    (
+    )
+{
+    Out *out = (Out *)malloc(sizeof(Out));
+    if (!out) return NULL;
+    if (!(out->mBuf = (char *)malloc(OUT_MEM_SIZE))) {
+        free(out);
+        return NULL;
+    }
+    out->mFd = -1;
+    out->mPos = out->mBuf;
+    out->mEnd = out->mBuf + OUT_MEM_SIZE;
+    return out;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: OutReserve
+ * DESCR: Starts a write of at most pLen characters, flushing the buffer first if they would not fit. Returns
+ *        where to store the characters; finish by passing one past the last one stored to OutCommit(). pLen
+ *        must not be larger than the buffer of a file writer.
+ *------------------------------------------------------------------------------------------------------------*/
+char *OutReserve
+    (
+    Out    *pOut,
+    size_t  pLen
+    )
+{
+    assert(pLen <= OUT_BUF_SIZE || pOut->mFd < 0);
+    if ((size_t)(pOut->mEnd - pOut->mPos) < pLen) OutMakeRoom(pOut, pLen);
+    return pOut->mPos;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: OutRewind
+ * DESCR: Empties the buffer without writing it anywhere. Used on a memory writer once what it holds has been
+ *        copied elsewhere.
+ *------------------------------------------------------------------------------------------------------------*/
+void OutRewind
+    (
+    Out *pOut
+    )
+{
+    pOut->mPos = pOut->mBuf;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: OutStr
+ * DESCR: Writes the null-terminated string pStr.
+ *------------------------------------------------------------------------------------------------------------*/
+void OutStr
+    (
+    Out  *pOut,
+    char *pStr
+    )
+{
+    OutMem(pOut, pStr, strlen(pStr));
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: OutWritev
+ * DESCR: Writes the pCount blocks described by pIov to the file, calling writev() again after a partial write,
+ *        and then empties the buffer. If the write fails, displays an error message and terminates.
+ *------------------------------------------------------------------------------------------------------------*/
+static void OutWritev
+    (
+    Out          *pOut,
+    struct iovec *pIov,
+    int           pCount
+    )
+{
+    ssize_t written;
+    while (pCount > 0) {
+        if (pIov->iov_len == 0) {
+            ++pIov;
+            --pCount;
+            continue;
+        }
+        written = writev(pOut->mFd, pIov, pCount);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            fprintf(stderr, "Error, cannot write the output file\n");
+            exit(-1);
+        }
+        while (pCount > 0 && (size_t)written >= pIov->iov_len) {
+            written -= pIov->iov_len;
+            ++pIov;
+            --pCount;
+        }
+        if (pCount > 0) {
+            pIov->iov_base = (char *)pIov->iov_base + written;
+            pIov->iov_len -= written;
+        }
+    }
+    pOut->mPos = pOut->mBuf;
+}
@@ -0,0 +1,156 @@
+/***************************************************************************************************************
+ * FILE: Pool.c
+ *
+ * DESCRIPTION
+ * Implementation of a fixed-size block pool. Rather than calling malloc() once per list node, the node code
+ * asks the pool for a block. The pool carves blocks out of large slabs, so consecutive requests get blocks
+ * that sit next to each other in memory, and a block that is handed back with PoolPutBlock() goes on an
+ * intrusive free list to be reused by the next PoolGetBlock(). PoolFree() releases every slab at once.
+ *
+ * Slabs start small and double in size up to POOL_SLAB_MAX_BLOCKS, so a pool holding a handful of nodes does
+ * not pay for thousands of them.
+ *
+ * AUTHOR INFORMATION
+ * agent [AGT]
+ *
+ * Email: agent@local
+ *
+ * MODIFICATION HISTORY:
+ * -------------------------------------------------------------------------------------------------------------
+ * 17 Oct 2026 [AGT] Initial revision.
+ **************************************************************************************************************/
+#include <assert.h>  /* For assert() */
+#include <stdlib.h>  /* For free(), malloc(), NULL */
+#include "Pool.h"
+#include "Types.h"   /* For bool, false, true */
+
+/*==============================================================================================================
+ * Preprocessor macro definitions.
+ *============================================================================================================*/
+#define POOL_ALIGN           16    /* The slab header is padded to a multiple of this many bytes.         */
+#define POOL_SLAB_MIN_BLOCKS 16    /* Number of blocks in the first slab of a pool.                       */
+#define POOL_SLAB_MAX_BLOCKS 4096  /* Slabs stop doubling in size once they reach this many blocks.       */
+
+#define PoolRoundUp(n) ((((n) + POOL_ALIGN - 1) / POOL_ALIGN) * POOL_ALIGN)
+
+/*==============================================================================================================
+ * Static function declarations.
+ *============================================================================================================*/
+static bool PoolGrow
+    (
+    Pool *pPool
+    );
+
+/*==============================================================================================================
+ * Function definitions.
+ *============================================================================================================*/
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PoolAlloc
+ * DESCR: Allocates a new, empty pool that hands out blocks of pBlockSize bytes. No slab is allocated until the
+ *        first call to PoolGetBlock(). Returns NULL if malloc() fails.
+ *------------------------------------------------------------------------------------------------------------*/
+Pool *PoolAlloc
+    (
+    size_t pBlockSize
+    )
+{
+    Pool *new_pool = (Pool *)malloc(sizeof(Pool));
+    if (new_pool) {
+        if (pBlockSize < sizeof(PoolBlock)) pBlockSize = sizeof(PoolBlock);
+        new_pool->mBlockSize = (pBlockSize + sizeof(void *) - 1) / sizeof(void *) * sizeof(void *);
+        new_pool->mSlabBlocks = POOL_SLAB_MIN_BLOCKS;
+        new_pool->mSlabs = NULL;
+        new_pool->mFree = NULL;
+        new_pool->mBump = NULL;
+        new_pool->mBumpEnd = NULL;
+    }
+    return new_pool;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PoolFree
+ * DESCR: Releases every slab owned by pPool and then pPool itself. Every block handed out by the pool becomes
+ *        invalid, whether or not it was given back with PoolPutBlock(). The cost is proportional to the number
+ *        of slabs, not the number of blocks. Returns NULL. Does nothing if pPool is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+Pool *PoolFree
+    (
+    Pool *pPool
+    )
+{
+    PoolSlab *slab;
+    if (!pPool) return NULL;
+    slab = pPool->mSlabs;
+    while (slab) {
+        PoolSlab *next_slab = slab->mNext;
+        free(slab);
+        slab = next_slab;
+    }
+    free(pPool);
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PoolGetBlock
+ * DESCR: Returns a block of pPool->mBlockSize bytes. Blocks on the free list are reused first; otherwise the
+ *        next unused block of the newest slab is handed out, and a new slab is allocated when that one is used
+ *        up. Returns NULL if malloc() fails. Assertion error if pPool is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+void *PoolGetBlock
+    (
+    Pool *pPool
+    )
+{
+    void *block;
+    assert(pPool);
+    if (pPool->mFree) {
+        block = pPool->mFree;
+        pPool->mFree = pPool->mFree->mNext;
+        return block;
+    }
+    if (pPool->mBump == pPool->mBumpEnd && !PoolGrow(pPool)) return NULL;
+    block = pPool->mBump;
+    pPool->mBump += pPool->mBlockSize;
+    return block;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PoolGrow
+ * DESCR: Allocates a new slab, makes it the newest slab of pPool, and doubles the size of the next slab until
+ *        it reaches POOL_SLAB_MAX_BLOCKS. Returns false if malloc() fails.
+ *------------------------------------------------------------------------------------------------------------*/
+static bool PoolGrow
+    (
+    Pool *pPool
+    )
+{
+    size_t header = PoolRoundUp(sizeof(PoolSlab));
+    PoolSlab *slab = (PoolSlab *)malloc(header + pPool->mSlabBlocks * pPool->mBlockSize);
+    if (!slab) return false;
+    slab->mNext = pPool->mSlabs;
+    pPool->mSlabs = slab;
+    pPool->mBump = (char *)slab + header;
+    pPool->mBumpEnd = pPool->mBump + pPool->mSlabBlocks * pPool->mBlockSize;
+    if (pPool->mSlabBlocks < POOL_SLAB_MAX_BLOCKS) pPool->mSlabBlocks *= 2;
+    return true;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: PoolPutBlock
+ * DESCR: Gives pBlock back to pPool so the next call to PoolGetBlock() can reuse it. pBlock must have been
+ *        returned by PoolGetBlock() on the same pool. Does nothing if pBlock is NULL. Assertion error if pPool
+ *        is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+void PoolPutBlock
+    (
+    Pool *pPool,
+    void *pBlock
+    )
+{
+    PoolBlock *block = (PoolBlock *)pBlock;
+    assert(pPool);
+    if (!block) return;
+    block->mNext = pPool->mFree;
+    pPool->mFree = block;
+}
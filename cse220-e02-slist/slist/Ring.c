@@ -0,0 +1,114 @@
+/***************************************************************************************************************
+ * FILE: Ring.c
+ *
+ * DESCRIPTION
+ * A bounded ring of ints through which one thread, the producer, hands values to one other thread, the
+ * consumer, in order. Neither takes a lock: the producer stores a value in the next free slot and then
+ * publishes it by advancing mTail with a release store, and the consumer reads mTail with an acquire load
+ * before taking values out, and hands their slots back the same way through mHead. A producer that finds the
+ * ring full, or a consumer that finds it empty, yields the processor until the other thread catches up, so a
+ * fast stage cannot run further ahead of a slow one than the size of the ring.
+ *
+ * AUTHOR INFORMATION
+ * agent [AGT]
+ *
+ * Email: agent@local
+ *
+ * MODIFICATION HISTORY:
+ * -------------------------------------------------------------------------------------------------------------
+ * 17 Oct 2026 [AGT] Initial revision.
+ **************************************************************************************************************/
+#define _POSIX_C_SOURCE 200112L  /* For sched_yield() when compiling with -ansi */
+
+#include <assert.h>  /* For assert() */
+#include <sched.h>   /* For sched_yield() */
+#include <stdlib.h>  /* For free(), malloc(), NULL */
+#include "Ring.h"
+
+/*==============================================================================================================
+ * Function definitions.
+ *============================================================================================================*/
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: RingAlloc
+ * DESCR: Allocates a new, empty ring that holds at least pSize values; the size is rounded up to a power of 2.
+ *        Returns NULL if malloc() fails.
+ *------------------------------------------------------------------------------------------------------------*/
+Ring *RingAlloc
+    (
+    unsigned pSize
+    )
+{
+    Ring *new_ring = (Ring *)malloc(sizeof(Ring));
+    unsigned size = 2;
+    if (!new_ring) return NULL;
+    while (size < pSize) size *= 2;
+    if (!(new_ring->mSlots = (int *)malloc(size * sizeof(int)))) {
+        free(new_ring);
+        return NULL;
+    }
+    new_ring->mMask = size - 1;
+    new_ring->mHead = new_ring->mTailSeen = 0;
+    new_ring->mTail = new_ring->mHeadSeen = 0;
+    return new_ring;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: RingFree
+ * DESCR: Deallocates pRing and any values still in it. Neither thread may be using it. Returns NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+Ring *RingFree
+    (
+    Ring *pRing
+    )
+{
+    if (!pRing) return NULL;
+    free(pRing->mSlots);
+    free(pRing);
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: RingPop
+ * DESCR: Removes the oldest value from pRing and returns it, waiting for the producer to push one if the ring
+ *        is empty. Only the consumer may call it.
+ *------------------------------------------------------------------------------------------------------------*/
+int RingPop
+    (
+    Ring *pRing
+    )
+{
+    unsigned head;
+    int value;
+    assert(pRing);
+    head = pRing->mHead;
+    while (head == pRing->mTailSeen) {
+        pRing->mTailSeen = __atomic_load_n(&pRing->mTail, __ATOMIC_ACQUIRE);
+        if (head == pRing->mTailSeen) sched_yield();
+    }
+    value = pRing->mSlots[head & pRing->mMask];
+    __atomic_store_n(&pRing->mHead, head + 1, __ATOMIC_RELEASE);
+    return value;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: RingPush
+ * DESCR: Adds pValue to pRing after the values already in it, waiting for the consumer to pop one if the ring
+ *        is full. Only the producer may call it.
+ *------------------------------------------------------------------------------------------------------------*/
+void RingPush
+    (
+    Ring *pRing,
+    int   pValue
+    )
+{
+    unsigned tail;
+    assert(pRing);
+    tail = pRing->mTail;
+    while (tail - pRing->mHeadSeen > pRing->mMask) {
+        pRing->mHeadSeen = __atomic_load_n(&pRing->mHead, __ATOMIC_ACQUIRE);
+        if (tail - pRing->mHeadSeen > pRing->mMask) sched_yield();
+    }
+    pRing->mSlots[tail & pRing->mMask] = pValue;
+    __atomic_store_n(&pRing->mTail, tail + 1, __ATOMIC_RELEASE);
+}
@@ -0,0 +1,70 @@
+/***************************************************************************************************************
+ * FILE: Ring.h
+ *
+ * DESCRIPTION
+ * Declaration of the bounded single-producer single-consumer ring of ints that connects the stages of a
+ * pipelined test run. See the comments in Ring.c for more information.
+ *
+ * AUTHOR INFORMATION
+ * agent [AGT]
+ *
+ * Email: agent@local
+ *
+ * MODIFICATION HISTORY:
+ * -------------------------------------------------------------------------------------------------------------
+ * 17 Oct 2026 [AGT] Initial revision.
+ **************************************************************************************************************/
+#ifndef __RING_H__
+#define __RING_H__
+
+/*==============================================================================================================
+ * Preprocessor macro definitions.
+ *============================================================================================================*/
+#define RING_LINE 64  /* Size of a cache line. The producer's and consumer's fields are this far apart. */
+
+/*==============================================================================================================
+ * Typedefs.
+ *============================================================================================================*/
+/*--------------------------------------------------------------------------------------------------------------
+ * mHead and mTail count the values popped and pushed since the ring was allocated, so mTail - mHead values are
+ * waiting in it and value i is in mSlots[i & mMask]. Only the consumer writes mHead and only the producer
+ * writes mTail; each reads the other's atomically, and keeps what it last read in mTailSeen or mHeadSeen so
+ * that it need not read it again until the ring looks empty or full. The two halves are kept on separate cache
+ * lines so the threads do not take the line back and forth with every value.
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct {
+    int      *mSlots;            /* The mMask + 1 slots.                    */
+    unsigned  mMask;             /* Number of slots (a power of 2) minus 1. */
+    char      mPad1[RING_LINE];
+    unsigned  mHead;             /* Values popped. Written by the consumer. */
+    unsigned  mTailSeen;         /* mTail as the consumer last read it.     */
+    char      mPad2[RING_LINE];
+    unsigned  mTail;             /* Values pushed. Written by the producer. */
+    unsigned  mHeadSeen;         /* mHead as the producer last read it.     */
+} Ring;
+
+/*==============================================================================================================
+ * Global function declarations. See function comments in Ring.c
+ *============================================================================================================*/
+extern Ring *RingAlloc
+    (
+    unsigned pSize
+    );
+
+extern Ring *RingFree
+    (
+    Ring *pRing
+    );
+
+extern int RingPop
+    (
+    Ring *pRing
+    );
+
+extern void RingPush
+    (
+    Ring *pRing,
+    int   pValue
+    );
+
+#endif
@@ -19,12 +19,21 @@
  * MODIFICATION HISTORY:
  * -------------------------------------------------------------------------------------------------------------
  * 29 Feb 2012 [KRB] Initial revision.
+ * 17 Oct 2026 [AGT] SListDebugPrint() converts the elements straight into the output buffer.
+ * 17 Oct 2026 [AGT] Added SListAppendN().
+ * 17 Oct 2026 [AGT] Added SListSort() and SListSortRadix().
+ * 17 Oct 2026 [AGT] Added SListSortParallel().
+ * 17 Oct 2026 [AGT] Each list carves its nodes out of its own arena, which SListFree() releases all at once.
+ * 17 Oct 2026 [AGT] SListRemove() moves the tail back when it removes the last node.
  **************************************************************************************************************/
 #include <assert.h>     /* For assert() */
-#include <stdio.h>      /* For FILE, fprintf(), NULL */
+#include <stdio.h>      /* For NULL */
 #include <stdlib.h>     /* For free(), malloc() */
+#include "Out.h"        /* For Out, OutCommit(), OutItoa(), OutReserve(), OutStr() */
+#include "Pool.h"       /* For PoolAlloc(), PoolFree() */
 #include "SList.h"
 #include "SListNode.h"
+#include "Sort.h"       /* For SortParallelInt() */
 
 /*==============================================================================================================
  * Function definitions.
@@ -43,6 +52,10 @@ SList *SListAlloc
         SListSetHead(new_list, NULL);
         SListSetTail(new_list, NULL);
         SListSetSize(new_list, 0);
+        if (!(new_list->mArena = PoolAlloc(sizeof(SListNode)))) {
+            free(new_list);
+            return NULL;
+        }
     }
     return new_list;
 }
@@ -60,7 +73,7 @@ SList *SListAppend
 {
     SListNode *new_node;
     if (!pList) return NULL;
-    new_node = SListNodeAlloc(pData, NULL);
+    new_node = SListNodeAllocFrom(pList->mArena, pData, NULL);
     if (SListIsEmpty(pList)) {
         SListSetHead(pList, new_node);
     } else {
@@ -71,30 +84,63 @@ SList *SListAppend
     return pList;
 }
 
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListAppendN
+ * DESCR: Appends the pCount elements of pData to the list pList. The nodes are linked one after another and
+ *        the tail and size of pList are updated once at the end. Returns a pointer to pList or NULL on failure,
+ *        i.e., if pList is NULL or a node cannot be allocated, in which case the elements appended before the
+ *        failure stay in the list.
+ *------------------------------------------------------------------------------------------------------------*/
+SList *SListAppendN
+    (
+    SList     *pList,
+    const int *pData,
+    size_t     pCount
+    )
+{
+    SListNode *tail, *new_node;
+    size_t i;
+    if (!pList) return NULL;
+    tail = SListGetTail(pList);
+    for (i = 0; i < pCount; ++i) {
+        if (!(new_node = SListNodeAllocFrom(pList->mArena, pData[i], NULL))) break;
+        if (tail) {
+            SListNodeSetNext(tail, new_node);
+        } else {
+            SListSetHead(pList, new_node);
+        }
+        tail = new_node;
+    }
+    SListSetTail(pList, tail);
+    SListSetSize(pList, SListGetSize(pList) + (int)i);
+    return i == pCount ? pList : NULL;
+}
+
 /*--------------------------------------------------------------------------------------------------------------
  * FUNCT: SListDebugPrint
- * DESCR: Prints the contents of the list pList to the stream pStream. Prints "List is NULL" if L is NULL. This
- *        is primarily a debugging function.
+ * DESCR: Prints the contents of the list pList to pOut. Prints "List is NULL" if L is NULL. This is primarily a
+ *        debugging function. Each element is converted directly into the output buffer rather than formatted
+ *        with fprintf(), so printing a long list costs little more than copying it.
  *------------------------------------------------------------------------------------------------------------*/
 void SListDebugPrint
     (
-    FILE  *pStream,
+    Out   *pOut,
     SList *pList
 )
 {
     SListNode *traverse;
+    char *pos;
     if (!pList) {
-        fprintf(pStream, "List is NULL.\n");
+        OutStr(pOut, "List is NULL.\n");
         return;
     }
-    fprintf(pStream, "[ ");
-    traverse = SListGetHead(pList);
-    while (traverse) {
-        SListNodeDebugPrint(pStream, traverse);
-        fprintf(pStream, " ");
-        traverse = SListNodeGetNext(traverse);
+    OutStr(pOut, "[ ");
+    for (traverse = SListGetHead(pList); traverse; traverse = SListNodeGetNext(traverse)) {
+        pos = OutItoa(OutReserve(pOut, OUT_INT_CHARS + 1), SListNodeGetData(traverse));
+        *pos++ = ' ';
+        OutCommit(pOut, pos);
     }
-    fprintf(pStream, "]");
+    OutStr(pOut, "]");
 }
 
 /*--------------------------------------------------------------------------------------------------------------
@@ -119,7 +165,8 @@ SListNode *SListFind
 /*--------------------------------------------------------------------------------------------------------------
  * FUNCT: SListFree
  * DESCR: Deallocates the linked list pList. This function should be called as soon as the list is no longer
- *        needed. Returns NULL.
+ *        needed. Returns NULL. The nodes are not given back one at a time; the arena of pList is freed with all
+ *        of them in it.
  *------------------------------------------------------------------------------------------------------------*/
 SList *SListFree
     (
@@ -127,12 +174,7 @@ SList *SListFree
     )
 {
     if (!pList) return NULL;
-    SListNode *traverse = SListGetHead(pList);
-    while (traverse) {
-        SListNode *next_node = SListNodeGetNext(traverse);
-        free(traverse);
-        traverse = next_node;
-    }
+    pList->mArena = PoolFree(pList->mArena);
     free(pList);
     return NULL;
 }
@@ -233,7 +275,7 @@ SList *SListInsert
 {
     SListNode *new_node, *prev_node;
     if (!pList || SListIsEmpty(pList) || pIndex < 0 || pIndex >= pList->mSize) return NULL;
-    new_node = SListNodeAlloc(pData, NULL);
+    new_node = SListNodeAllocFrom(pList->mArena, pData, NULL);
     prev_node = SListGetNodeAtIndex(pList, pIndex-1);
     if (prev_node) {
         SListNode *next_node = SListNodeGetNext(prev_node);
@@ -282,7 +324,8 @@ SList *SListRemove
     } else {
         SListSetHead(pList, SListNodeGetNext(data_node));
     }
-    SListNodeFree(data_node);
+    if (data_node == SListGetTail(pList)) SListSetTail(pList, prev_node);
+    SListNodeFreeTo(pList->mArena, data_node);
     SListSetSize(pList, SListGetSize(pList)-1);
     return pList;
 }
@@ -331,3 +374,104 @@ SList *SListSetTail
     pList->mTail = pTail;
     return pList;
 }
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListSort
+ * DESCR: Sorts the elements of pList into ascending order with a bottom-up merge sort of the nodes. Each pass
+ *        walks the list merging every run of 1, 2, 4, ... nodes with the run after it, relinking the nodes in
+ *        order, until a pass merges no more than one pair of runs. The nodes stay where they are in the node
+ *        pool, so nothing is allocated. Equal elements keep their order. O(n log n). Returns pList, or NULL
+ *        if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+SList *SListSort
+    (
+    SList *pList
+    )
+{
+    SListNode *list, *p, *q, *node, *tail;
+    int run, merges, p_size, q_size;
+    if (!pList) return NULL;
+    if (SListGetSize(pList) < 2) return pList;
+    list = SListGetHead(pList);
+    for (run = 1; ; run *= 2) {
+        p = list;
+        list = tail = NULL;
+        for (merges = 0; p; ++merges) {
+            q = p;
+            for (p_size = 0; p_size < run && q; ++p_size) q = SListNodeGetNext(q);
+            q_size = run;
+            while (p_size > 0 || (q_size > 0 && q)) {
+                if (p_size > 0 && (q_size == 0 || !q || SListNodeGetData(p) <= SListNodeGetData(q))) {
+                    node = p;
+                    p = SListNodeGetNext(p);
+                    --p_size;
+                } else {
+                    node = q;
+                    q = SListNodeGetNext(q);
+                    --q_size;
+                }
+                if (tail) {
+                    SListNodeSetNext(tail, node);
+                } else {
+                    list = node;
+                }
+                tail = node;
+            }
+            p = q;
+        }
+        SListNodeSetNext(tail, NULL);
+        if (merges <= 1) break;
+    }
+    SListSetHead(pList, list);
+    SListSetTail(pList, tail);
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListSortParallel
+ * DESCR: Sorts the elements of pList into ascending order: the elements are copied into an array, where
+ *        SortParallelInt() radix sorts one run of them on each of up to pThreads threads (one per processor if
+ *        pThreads is less than 1) and then merges the runs, and they are stored back into the nodes in order. The
+ *        nodes stay where they are. The result is the same for any number of threads. Takes two temporary arrays of
+ *        n ints. Returns pList, or NULL if pList is NULL or memory cannot be allocated, in which case pList is
+ *        unchanged.
+ *------------------------------------------------------------------------------------------------------------*/
+SList *SListSortParallel
+    (
+    SList *pList,
+    int    pThreads
+    )
+{
+    SListNode *traverse;
+    int *values, i;
+    if (!pList) return NULL;
+    if (SListGetSize(pList) < 2) return pList;
+    if (!(values = (int *)malloc(SListGetSize(pList) * sizeof(int)))) return NULL;
+    for (i = 0, traverse = SListGetHead(pList); traverse; traverse = SListNodeGetNext(traverse)) {
+        values[i++] = SListNodeGetData(traverse);
+    }
+    if (!SortParallelInt(values, (size_t)SListGetSize(pList), pThreads)) {
+        free(values);
+        return NULL;
+    }
+    for (i = 0, traverse = SListGetHead(pList); traverse; traverse = SListNodeGetNext(traverse)) {
+        SListNodeSetData(traverse, values[i++]);
+    }
+    free(values);
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListSortRadix
+ * DESCR: Sorts the elements of pList into ascending order with SListSortParallel() on one thread, so the whole list
+ *        is a single run, radix sorted by SortRadixInt() in O(n) time, and there is nothing to merge. Faster than
+ *        SListSort() for large lists. Returns pList, or NULL if pList is NULL or memory cannot be allocated, in
+ *        which case pList is unchanged.
+ *------------------------------------------------------------------------------------------------------------*/
+SList *SListSortRadix
+    (
+    SList *pList
+    )
+{
+    return SListSortParallel(pList, 1);
+}
@@ -19,21 +19,39 @@
  * MODIFICATION HISTORY:
  * -------------------------------------------------------------------------------------------------------------
  * 29 Feb 2012 [KRB] Initial revision.
+ * 17 Oct 2026 [AGT] SListDebugPrint() writes to an Out rather than a FILE.
+ * 17 Oct 2026 [AGT] Added the node array used when building with LAYOUT=compact (see SListCompact.c).
+ * 17 Oct 2026 [AGT] Added SListAppendN().
+ * 17 Oct 2026 [AGT] Added SListSort() and SListSortRadix().
+ * 17 Oct 2026 [AGT] Added SListSortParallel().
+ * 17 Oct 2026 [AGT] Each list carves its nodes out of its own arena.
  **************************************************************************************************************/
 #ifndef __SLIST_H__
 #define __SLIST_H__
 
-#include <stdio.h>      /* For FILE */
+#include "Out.h"        /* For Out */
+#include "Pool.h"       /* For Pool */
 #include "SListNode.h"
 #include "Types.h"
 
 /*==============================================================================================================
- * Defines a type for the SList data structure.
+ * Defines a type for the SList data structure. The nodes of a list are carved out of an arena of its own, so
+ * lists share no memory and may be changed on different threads. When building with LAYOUT=compact the nodes
+ * live in one array per list instead, and link to each other by 32-bit offsets.
  *============================================================================================================*/
 typedef struct {
-    SListNode *mHead;  /* Pointer to first node in the list. */
-    SListNode *mTail;  /* Pointer to last node in the list.  */
-    int        mSize;  /* Number of nodes in list.           */
+    SListNode *mHead;      /* Pointer to first node in the list. */
+    SListNode *mTail;      /* Pointer to last node in the list.  */
+    int        mSize;      /* Number of nodes in list.           */
+#ifndef SLIST_COMPACT
+    Pool      *mArena;     /* Pool that the nodes are carved from. */
+#endif
+#ifdef SLIST_COMPACT
+    SListNode *mNodes;     /* Array the nodes live in. Moves when it grows.               */
+    int        mCapacity;  /* Number of nodes mNodes has room for.                       */
+    int        mUsed;      /* mNodes[0..mUsed-1] have been handed out at some time.      */
+    SListNode *mFree;      /* Removed nodes, linked through mNext, waiting to be reused. */
+#endif
 } SList;
 
 /*==============================================================================================================
@@ -49,9 +67,16 @@ extern SList *SListAppend
     int    pData
     );
 
+extern SList *SListAppendN
+    (
+    SList     *pList,
+    const int *pData,
+    size_t     pCount
+    );
+
 extern void SListDebugPrint
     (
-    FILE *stream,
+    Out   *pOut,
     SList *pList
     );
 
@@ -117,4 +142,20 @@ extern SList *SListSetTail
     SListNode *pTail
     );
 
+extern SList *SListSort
+    (
+    SList *pList
+    );
+
+extern SList *SListSortParallel
+    (
+    SList *pList,
+    int    pThreads
+    );
+
+extern SList *SListSortRadix
+    (
+    SList *pList
+    );
+
 #endif
@@ -0,0 +1,558 @@
+/***************************************************************************************************************
+ * FILE: SListCompact.c
+ *
+ * DESCRIPTION
+ * An implementation of the SList.h functions for lists of many small nodes. It is built in place of SList.c by
+ * running "make LAYOUT=compact", which also defines SLIST_COMPACT so SListNode.h declares the compact node.
+ *
+ * Rather than taking its nodes from the node pool, each list keeps them in one array, mNodes, and each node
+ * links to the next by their distance in the array, which fits in an int. A node is then 8 bytes on a 64-bit
+ * machine rather than 16. When the array is full it is moved to one half again as large, and since the links
+ * are relative only the head, the tail, and the free list need adjusting. Removed nodes are kept on a free
+ * list and reused before the array grows, and freeing a list frees the array.
+ *
+ * Because the array moves as the list grows, a SListNode * returned by SListFind(), SListGetHead(), or
+ * SListGetTail() is only good until the list is next changed.
+ *
+ * AUTHOR INFORMATION
+ * agent [AGT]
+ *
+ * Email: agent@local
+ *
+ * MODIFICATION HISTORY:
+ * -------------------------------------------------------------------------------------------------------------
+ * 17 Oct 2026 [AGT] Initial revision.
+ * 17 Oct 2026 [AGT] Added SListAppendN().
+ * 17 Oct 2026 [AGT] Added SListSort() and SListSortRadix().
+ * 17 Oct 2026 [AGT] Added SListSortParallel().
+ **************************************************************************************************************/
+#include <assert.h>     /* For assert() */
+#include <limits.h>     /* For INT_MAX */
+#include <stdio.h>      /* For NULL */
+#include <stdlib.h>     /* For free(), malloc() */
+#include <string.h>     /* For memcpy() */
+#include "Out.h"        /* For Out, OutCommit(), OutItoa(), OutReserve(), OutStr() */
+#include "SList.h"
+#include "SListNode.h"
+#include "Sort.h"       /* For SortParallelInt() */
+
+#ifndef SLIST_COMPACT
+#error SListCompact.c must be compiled with -DSLIST_COMPACT (make LAYOUT=compact)
+#endif
+
+/*==============================================================================================================
+ * Preprocessor macro definitions.
+ *============================================================================================================*/
+#define SLIST_MIN_CAPACITY 16  /* Number of nodes the node array has room for when it is first allocated. */
+
+/*==============================================================================================================
+ * Static function declarations.
+ *============================================================================================================*/
+static bool SListGrow
+    (
+    SList *pList
+    );
+
+static SListNode *SListNewNode
+    (
+    SList *pList,
+    int    pData
+    );
+
+/*==============================================================================================================
+ * Function definitions.
+ *============================================================================================================*/
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListAlloc
+ * DESCR: Allocate a new linked list. Returns a pointer to the allocated list or NULL on failure. The node array
+ *        is not allocated until the first node is added.
+ *------------------------------------------------------------------------------------------------------------*/
+SList *SListAlloc
+    (
+    )
+{
+    SList *new_list = (SList *)malloc(sizeof(SList));
+    if (new_list) {
+        SListSetHead(new_list, NULL);
+        SListSetTail(new_list, NULL);
+        SListSetSize(new_list, 0);
+        new_list->mNodes = NULL;
+        new_list->mCapacity = 0;
+        new_list->mUsed = 0;
+        new_list->mFree = NULL;
+    }
+    return new_list;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListAppend
+ * DESCR: Appends a new node containing data member set to pData to the list pList. Returns a pointer to pList
+ *        or NULL on failure, i.e., if pList is NULL or a node cannot be allocated.
+ *------------------------------------------------------------------------------------------------------------*/
+SList *SListAppend
+    (
+    SList *pList,
+    int    pData
+    )
+{
+    SListNode *new_node;
+    if (!pList) return NULL;
+    if (!(new_node = SListNewNode(pList, pData))) return NULL;
+    if (SListIsEmpty(pList)) {
+        SListSetHead(pList, new_node);
+    } else {
+        SListNodeSetNext(SListGetTail(pList), new_node);
+    }
+    SListSetTail(pList, new_node);
+    SListSetSize(pList, SListGetSize(pList) + 1);
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListAppendN
+ * DESCR: Appends the pCount elements of pData to the list pList. If there are no freed nodes to reuse, the node
+ *        array is grown once up front to hold all of them, so the new nodes are consecutive in the array.
+ *        Returns a pointer to pList or NULL on failure, i.e., if pList is NULL or a node cannot be allocated, in
+ *        which case the elements appended before the failure stay in the list.
+ *------------------------------------------------------------------------------------------------------------*/
+SList *SListAppendN
+    (
+    SList     *pList,
+    const int *pData,
+    size_t     pCount
+    )
+{
+    SListNode *new_node;
+    size_t i;
+    if (!pList) return NULL;
+    while (!pList->mFree && (size_t)(pList->mCapacity - pList->mUsed) < pCount && SListGrow(pList)) continue;
+    for (i = 0; i < pCount; ++i) {
+        if (!(new_node = SListNewNode(pList, pData[i]))) break;
+        if (SListIsEmpty(pList)) {
+            SListSetHead(pList, new_node);
+        } else {
+            SListNodeSetNext(SListGetTail(pList), new_node);
+        }
+        SListSetTail(pList, new_node);
+        SListSetSize(pList, SListGetSize(pList) + 1);
+    }
+    return i == pCount ? pList : NULL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListDebugPrint
+ * DESCR: Prints the contents of the list pList to pOut. Prints "List is NULL" if L is NULL. This is primarily a
+ *        debugging function.
+ *------------------------------------------------------------------------------------------------------------*/
+void SListDebugPrint
+    (
+    Out   *pOut,
+    SList *pList
+    )
+{
+    SListNode *traverse;
+    char *pos;
+    if (!pList) {
+        OutStr(pOut, "List is NULL.\n");
+        return;
+    }
+    OutStr(pOut, "[ ");
+    for (traverse = SListGetHead(pList); traverse; traverse = SListNodeGetNext(traverse)) {
+        pos = OutItoa(OutReserve(pOut, OUT_INT_CHARS + 1), SListNodeGetData(traverse));
+        *pos++ = ' ';
+        OutCommit(pOut, pos);
+    }
+    OutStr(pOut, "]");
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListFind
+ * DESCR: Returns a pointer to the first node containing a data member matching pData. Returns NULL if pData is
+ *        not in pList or if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+SListNode *SListFind
+    (
+    SList *pList,
+    int    pData
+    )
+{
+    SListNode *traverse;
+    if (!pList) return NULL;
+    traverse = SListGetHead(pList);
+    while (traverse && SListNodeGetData(traverse) != pData) {
+        traverse = SListNodeGetNext(traverse);
+    }
+    return traverse;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListFree
+ * DESCR: Deallocates the linked list pList and its node array. Returns NULL. Does nothing and returns NULL if
+ *        pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+SList *SListFree
+    (
+    SList *pList
+    )
+{
+    if (!pList) return NULL;
+    free(pList->mNodes);
+    free(pList);
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListGetHead
+ * DESCR: Accessor function for the pList->mHead data member. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+SListNode *SListGetHead
+    (
+    SList *pList
+    )
+{
+    assert(pList);
+    return pList->mHead;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListGetNodeAtIndex
+ * DESCR: Returns a pointer to the node at index pIndex of list pList. Returns NULL if pList is empty or pIndex
+ *        is out of bounds.
+ *------------------------------------------------------------------------------------------------------------*/
+SListNode *SListGetNodeAtIndex
+    (
+    SList *pList,
+    int    pIndex
+    )
+{
+    SListNode *traverse;
+    if (pIndex < 0) return NULL;
+    traverse = SListGetHead(pList);
+    while (traverse && --pIndex >= 0) {
+        traverse = SListNodeGetNext(traverse);
+    }
+    return traverse;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListGetPrev
+ * DESCR: Returns a pointer to the node in pList that is the previous node of pNode. Assertion error if pList
+ *        or pNode is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+SListNode *SListGetPrev
+    (
+    SList     *pList,
+    SListNode *pNode
+    )
+{
+    SListNode *traverse;
+    assert(pList && pNode);
+    if (pNode == SListGetHead(pList)) return NULL;
+    traverse = SListGetHead(pList);
+    while (traverse && SListNodeGetNext(traverse) != pNode) {
+        traverse = SListNodeGetNext(traverse);
+    }
+    return traverse;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListGetSize
+ * DESCR: Accessor function for the pList->mSize data member. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+int SListGetSize
+    (
+    SList *pList
+    )
+{
+    assert(pList);
+    return pList->mSize;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListGetTail
+ * DESCR: Accessor function for the pList->tail data member. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+SListNode *SListGetTail
+    (
+    SList *pList
+    )
+{
+    assert(pList);
+    return pList->mTail;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListGrow
+ * DESCR: Moves the node array of pList to a new array one half again as large (or allocates the first one) and
+ *        points the head, the tail, and the free list at the new array. Returns false, leaving pList unchanged,
+ *        if the new array cannot be allocated or would have more than INT_MAX nodes.
+ *------------------------------------------------------------------------------------------------------------*/
+static bool SListGrow
+    (
+    SList *pList
+    )
+{
+    SListNode *old_nodes = pList->mNodes, *new_nodes;
+    int capacity = pList->mCapacity;
+    if (capacity > INT_MAX / 3 * 2) {
+        if (capacity == INT_MAX) return false;
+        capacity = INT_MAX;
+    } else {
+        capacity = capacity < SLIST_MIN_CAPACITY ? SLIST_MIN_CAPACITY : capacity + capacity / 2;
+    }
+    if ((size_t)capacity > (size_t)-1 / sizeof(SListNode)) return false;
+    if (!(new_nodes = (SListNode *)malloc(capacity * sizeof(SListNode)))) return false;
+    if (old_nodes) {
+        memcpy(new_nodes, old_nodes, pList->mUsed * sizeof(SListNode));
+        if (pList->mHead) SListSetHead(pList, new_nodes + (pList->mHead - old_nodes));
+        if (pList->mTail) SListSetTail(pList, new_nodes + (pList->mTail - old_nodes));
+        if (pList->mFree) pList->mFree = new_nodes + (pList->mFree - old_nodes);
+        free(old_nodes);
+    }
+    pList->mNodes = new_nodes;
+    pList->mCapacity = capacity;
+    return true;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListInsert
+ * DESCR: Inserts a new node containing pData into the list pList at index pIndex. The nodes in the list are
+ *        numbered starting at 0. Fails and returns NULL if: (1) pList is NULL; or (2) pList->mSize <= 0; or
+ *        (3) pIndex < 0; or (4) pIndex >= pList->mSize; or (5) a node cannot be allocated. The new node is
+ *        allocated before the node at pIndex - 1 is found, since allocating may move the node array.
+ *------------------------------------------------------------------------------------------------------------*/
+SList *SListInsert
+    (
+    SList *pList,
+    int    pIndex,
+    int    pData
+    )
+{
+    SListNode *new_node, *prev_node;
+    if (!pList || SListIsEmpty(pList) || pIndex < 0 || pIndex >= pList->mSize) return NULL;
+    if (!(new_node = SListNewNode(pList, pData))) return NULL;
+    prev_node = SListGetNodeAtIndex(pList, pIndex - 1);
+    if (prev_node) {
+        SListNodeSetNext(new_node, SListNodeGetNext(prev_node));
+        SListNodeSetNext(prev_node, new_node);
+    } else {
+        SListNodeSetNext(new_node, SListGetHead(pList));
+        SListSetHead(pList, new_node);
+    }
+    SListSetSize(pList, SListGetSize(pList) + 1);
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListIsEmpty
+ * DESCR: Returns true if the pList is empty. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+bool SListIsEmpty
+    (
+    SList *pList
+    )
+{
+    assert(pList);
+    return pList->mSize == 0;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListNewNode
+ * DESCR: Gets an unlinked node containing pData from the node array of pList: a node from the free list if
+ *        there is one, otherwise the first never-used node, growing the array if it is full. Returns NULL if
+ *        the array cannot grow. Note that growing moves every node of pList.
+ *------------------------------------------------------------------------------------------------------------*/
+static SListNode *SListNewNode
+    (
+    SList *pList,
+    int    pData
+    )
+{
+    SListNode *new_node = pList->mFree;
+    if (new_node) {
+        pList->mFree = SListNodeGetNext(new_node);
+    } else {
+        if (pList->mUsed == pList->mCapacity && !SListGrow(pList)) return NULL;
+        new_node = pList->mNodes + pList->mUsed++;
+    }
+    SListNodeSetData(new_node, pData);
+    SListNodeSetNext(new_node, NULL);
+    return new_node;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListRemove
+ * DESCR: Removes the first occurrence of a node with data member set to pData and puts it on the free list. If
+ *        pList is NULL or pData is not in pList then returns NULL. On success, returns a pointer to pList.
+ *------------------------------------------------------------------------------------------------------------*/
+SList *SListRemove
+    (
+    SList *pList,
+    int    pData
+    )
+{
+    SListNode *data_node, *prev_node = NULL;
+    if (!pList) return NULL;
+    for (data_node = SListGetHead(pList); data_node; data_node = SListNodeGetNext(data_node)) {
+        if (SListNodeGetData(data_node) == pData) break;
+        prev_node = data_node;
+    }
+    if (!data_node) return NULL;
+    if (prev_node) {
+        SListNodeSetNext(prev_node, SListNodeGetNext(data_node));
+    } else {
+        SListSetHead(pList, SListNodeGetNext(data_node));
+    }
+    if (data_node == SListGetTail(pList)) SListSetTail(pList, prev_node);
+    SListNodeSetNext(data_node, pList->mFree);
+    pList->mFree = data_node;
+    SListSetSize(pList, SListGetSize(pList) - 1);
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListSetHead
+ * DESCR: Mutator function for the pList->mHead data member. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+SList *SListSetHead
+    (
+    SList     *pList,
+    SListNode *pHead
+    )
+{
+    assert(pList);
+    pList->mHead = pHead;
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListSetSize
+ * DESCR: Mutator function for the pList->mSize data member. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+SList *SListSetSize
+    (
+    SList *pList,
+    int    pSize
+    )
+{
+    assert(pList);
+    pList->mSize = pSize;
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListSetTail
+ * DESCR: Mutator function for the pList->mTail data member. Assertion error if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+SList *SListSetTail
+    (
+    SList     *pList,
+    SListNode *pTail
+    )
+{
+    assert(pList);
+    pList->mTail = pTail;
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListSort
+ * DESCR: Sorts the elements of pList into ascending order with a bottom-up merge sort of the nodes. Each pass
+ *        walks the list merging every run of 1, 2, 4, ... nodes with the run after it, relinking the nodes in
+ *        order, until a pass merges no more than one pair of runs. The nodes stay where they are in the node
+ *        array, so nothing is allocated. Equal elements keep their order. O(n log n). Returns pList, or NULL
+ *        if pList is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+SList *SListSort
+    (
+    SList *pList
+    )
+{
+    SListNode *list, *p, *q, *node, *tail;
+    int run, merges, p_size, q_size;
+    if (!pList) return NULL;
+    if (SListGetSize(pList) < 2) return pList;
+    list = SListGetHead(pList);
+    for (run = 1; ; run *= 2) {
+        p = list;
+        list = tail = NULL;
+        for (merges = 0; p; ++merges) {
+            q = p;
+            for (p_size = 0; p_size < run && q; ++p_size) q = SListNodeGetNext(q);
+            q_size = run;
+            while (p_size > 0 || (q_size > 0 && q)) {
+                if (p_size > 0 && (q_size == 0 || !q || SListNodeGetData(p) <= SListNodeGetData(q))) {
+                    node = p;
+                    p = SListNodeGetNext(p);
+                    --p_size;
+                } else {
+                    node = q;
+                    q = SListNodeGetNext(q);
+                    --q_size;
+                }
+                if (tail) {
+                    SListNodeSetNext(tail, node);
+                } else {
+                    list = node;
+                }
+                tail = node;
+            }
+            p = q;
+        }
+        SListNodeSetNext(tail, NULL);
+        if (merges <= 1) break;
+    }
+    SListSetHead(pList, list);
+    SListSetTail(pList, tail);
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListSortParallel
+ * DESCR: Sorts the elements of pList into ascending order: the elements are copied into an array, where
+ *        SortParallelInt() radix sorts one run of them on each of up to pThreads threads (one per processor if
+ *        pThreads is less than 1) and then merges the runs, and they are stored back into the nodes in order. The
+ *        nodes stay where they are. The result is the same for any number of threads. Takes two temporary arrays of
+ *        n ints. Returns pList, or NULL if pList is NULL or memory cannot be allocated, in which case pList is
+ *        unchanged.
+ *------------------------------------------------------------------------------------------------------------*/
+SList *SListSortParallel
+    (
+    SList *pList,
+    int    pThreads
+    )
+{
+    SListNode *traverse;
+    int *values, i;
+    if (!pList) return NULL;
+    if (SListGetSize(pList) < 2) return pList;
+    if (!(values = (int *)malloc(SListGetSize(pList) * sizeof(int)))) return NULL;
+    for (i = 0, traverse = SListGetHead(pList); traverse; traverse = SListNodeGetNext(traverse)) {
+        values[i++] = SListNodeGetData(traverse);
+    }
+    if (!SortParallelInt(values, (size_t)SListGetSize(pList), pThreads)) {
+        free(values);
+        return NULL;
+    }
+    for (i = 0, traverse = SListGetHead(pList); traverse; traverse = SListNodeGetNext(traverse)) {
+        SListNodeSetData(traverse, values[i++]);
+    }
+    free(values);
+    return pList;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListSortRadix
+ * DESCR: Sorts the elements of pList into ascending order with SListSortParallel() on one thread, so the whole list
+ *        is a single run, radix sorted by SortRadixInt() in O(n) time, and there is nothing to merge. Faster than
+ *        SListSort() for large lists. Returns pList, or NULL if pList is NULL or memory cannot be allocated, in
+ *        which case pList is unchanged.
+ *------------------------------------------------------------------------------------------------------------*/
+SList *SListSortRadix
+    (
+    SList *pList
+    )
+{
+    return SListSortParallel(pList, 1);
+}
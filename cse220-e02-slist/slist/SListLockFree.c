@@ -0,0 +1,333 @@
+/***************************************************************************************************************
+ * FILE: SListLockFree.c
+ *
+ * DESCRIPTION
+ * Implementation of the lock-free stack and queue. Neither takes a lock: every change to a shared link is one
+ * atomic instruction. That makes a push onto the stack, and a pop from it by at most SLISTLF_HAZARDS threads at
+ * once, lock-free: a thread that is stopped part way through does not keep the others from finishing. It is not
+ * true beyond that bound, nor of the queue, see below.
+ *
+ * The stack is a Treiber stack. A push links the new node to the top it read and swings mHead to the new node
+ * with a compare-and-swap, trying again if another thread changed mHead first. A pop does the same with the
+ * node after the top. The danger in a pop is that between reading the top and swapping it out, another thread
+ * may pop the node and free it, so the pop would read freed memory, or free it and allocate it again at the
+ * same address, so the swap would succeed on a stale link (the ABA problem). Hazard pointers keep that from
+ * happening: a popping thread publishes the node it is reading in a hazard pointer and checks that the node is
+ * still the top, and a popped node is not freed while any hazard pointer holds it. Popped nodes are retired to
+ * a list, and once SLISTLF_SCAN_AT of them pile up the retiring thread frees those no hazard pointer holds.
+ *
+ * There are SLISTLF_HAZARDS hazard pointers per stack, and a popping thread owns one from start to end of its
+ * pop. So at most SLISTLF_HAZARDS threads may pop one stack at the same time. Another popping thread spins until
+ * one of them gives its hazard pointer back, and if that thread is stopped in the middle of its pop, the
+ * spinning thread waits for it as if on a lock. Keep the number of threads that pop a stack at or below
+ * SLISTLF_HAZARDS; pushing threads do not count.
+ *
+ * The queue lets any number of threads push but only one pop. A push swaps mTail to the new node with one
+ * atomic exchange and then links the old tail to it, so producers never retry. The consumer reads past the
+ * stub at mHead, and frees the stub once the node after it is linked, which is the last thing a producer does
+ * with the old tail, so no reclamation scheme is needed. A push whose exchange has happened but whose link has
+ * not yet been written is not visible to the consumer yet, so the queue can look empty for that moment, and
+ * for as long as that producer is stopped between its exchange and its link.
+ *
+ * The atomic operations are the GCC __atomic builtins, which have the semantics of the C11 <stdatomic.h>
+ * functions of the same names but, unlike <stdatomic.h>, can be used when compiling with -ansi.
+ *
+ * AUTHOR INFORMATION
+ * agent [AGT]
+ *
+ * Email: agent@local
+ *
+ * MODIFICATION HISTORY:
+ * -------------------------------------------------------------------------------------------------------------
+ * 17 Oct 2026 [AGT] Initial revision.
+ * 17 Oct 2026 [AGT] Documented that a pop is only lock-free with at most SLISTLF_HAZARDS popping threads.
+ **************************************************************************************************************/
+#include <assert.h>         /* For assert() */
+#include <stdlib.h>         /* For free(), malloc() */
+#include "SListLockFree.h"
+#include "Types.h"          /* For bool, false, true */
+
+/*==============================================================================================================
+ * Preprocessor macro definitions.
+ *============================================================================================================*/
+#define SLISTLF_SCAN_AT (2 * SLISTLF_HAZARDS)  /* Retired nodes that make a thread look for nodes to free. */
+
+/* Atomic operations. Acquire and release order the reads and writes around a link; seq_cst is used where a
+ * hazard pointer is published or checked, which must be ordered with a later read of another location. */
+#define LFLoad(p)         __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define LFLoadSeq(p)      __atomic_load_n((p), __ATOMIC_SEQ_CST)
+#define LFStore(p, v)     __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define LFStoreSeq(p, v)  __atomic_store_n((p), (v), __ATOMIC_SEQ_CST)
+#define LFExchange(p, v)  __atomic_exchange_n((p), (v), __ATOMIC_ACQ_REL)
+#define LFCas(p, e, v)    __atomic_compare_exchange_n((p), (e), (v), 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)
+#define LFAdd(p, n)       __atomic_add_fetch((p), (n), __ATOMIC_ACQ_REL)
+
+/*==============================================================================================================
+ * Static function declarations.
+ *============================================================================================================*/
+static void SListStackRetire
+    (
+    SListStack  *pStack,
+    SListLFNode *pNode
+    );
+
+static void SListStackScan
+    (
+    SListStack *pStack
+    );
+
+/*==============================================================================================================
+ * Function definitions.
+ *============================================================================================================*/
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListQueueAlloc
+ * DESCR: Allocates a new, empty queue, which is a stub node at both ends. Returns NULL if memory cannot be
+ *        allocated.
+ *------------------------------------------------------------------------------------------------------------*/
+SListQueue *SListQueueAlloc
+    (
+    )
+{
+    SListQueue *new_queue = (SListQueue *)malloc(sizeof(SListQueue));
+    SListLFNode *stub = (SListLFNode *)malloc(sizeof(SListLFNode));
+    if (!new_queue || !stub) {
+        free(new_queue);
+        free(stub);
+        return NULL;
+    }
+    stub->mData = 0;
+    stub->mNext = NULL;
+    new_queue->mHead = new_queue->mTail = stub;
+    return new_queue;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListQueueFree
+ * DESCR: Frees every node of pQueue and pQueue itself. No other thread may be using pQueue. Returns NULL. Does
+ *        nothing if pQueue is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+SListQueue *SListQueueFree
+    (
+    SListQueue *pQueue
+    )
+{
+    SListLFNode *node, *next;
+    if (!pQueue) return NULL;
+    for (node = pQueue->mHead; node; node = next) {
+        next = node->mNext;
+        free(node);
+    }
+    free(pQueue);
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListQueuePop
+ * DESCR: Removes the element at the front of pQueue and stores it in *pData. Only one thread, the consumer, may
+ *        pop a queue. The node after the stub becomes the new stub and the old stub is freed. Returns false if
+ *        no element is visible yet. Assertion error if pQueue or pData is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+bool SListQueuePop
+    (
+    SListQueue *pQueue,
+    int        *pData
+    )
+{
+    SListLFNode *stub, *next;
+    assert(pQueue && pData);
+    stub = pQueue->mHead;
+    if (!(next = LFLoad(&stub->mNext))) return false;
+    *pData = next->mData;
+    pQueue->mHead = next;
+    free(stub);
+    return true;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListQueuePush
+ * DESCR: Appends pData to the end of pQueue. Any number of threads may push at the same time. Returns pQueue, or
+ *        NULL if the node cannot be allocated. Assertion error if pQueue is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+SListQueue *SListQueuePush
+    (
+    SListQueue *pQueue,
+    int         pData
+    )
+{
+    SListLFNode *new_node, *prev;
+    assert(pQueue);
+    if (!(new_node = (SListLFNode *)malloc(sizeof(SListLFNode)))) return NULL;
+    new_node->mData = pData;
+    new_node->mNext = NULL;
+    prev = LFExchange(&pQueue->mTail, new_node);
+    LFStore(&prev->mNext, new_node);
+    return pQueue;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListStackAlloc
+ * DESCR: Allocates a new, empty stack with every hazard pointer free. Returns NULL if memory cannot be
+ *        allocated.
+ *------------------------------------------------------------------------------------------------------------*/
+SListStack *SListStackAlloc
+    (
+    )
+{
+    SListStack *new_stack = (SListStack *)malloc(sizeof(SListStack));
+    int i;
+    if (new_stack) {
+        new_stack->mHead = NULL;
+        for (i = 0; i < SLISTLF_HAZARDS; ++i) {
+            new_stack->mHazards[i].mNode = NULL;
+            new_stack->mHazards[i].mOwned = 0;
+        }
+        new_stack->mRetired = NULL;
+        new_stack->mRetiredCount = 0;
+    }
+    return new_stack;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListStackFree
+ * DESCR: Frees every node of pStack, the retired ones too, and pStack itself. No other thread may be using
+ *        pStack. Returns NULL. Does nothing if pStack is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+SListStack *SListStackFree
+    (
+    SListStack *pStack
+    )
+{
+    SListLFNode *node, *next;
+    if (!pStack) return NULL;
+    for (node = pStack->mHead; node; node = next) {
+        next = node->mNext;
+        free(node);
+    }
+    for (node = pStack->mRetired; node; node = next) {
+        next = node->mNext;
+        free(node);
+    }
+    free(pStack);
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListStackPop
+ * DESCR: Removes the element on top of pStack and stores it in *pData. Any number of threads may push at the same
+ *        time, but at most SLISTLF_HAZARDS may pop: each popping thread owns a hazard pointer for the length of
+ *        its pop, and a popping thread past that bound spins until one is given back, so it waits on the thread
+ *        that owns it. Returns false if the stack is empty. Assertion error if pStack or pData is NULL.
+ * PCODE:
+ * Take a free hazard pointer  -- a compare-and-swap of its mOwned from 0 to 1, spinning while all are owned
+ * Repeat
+ *     Read the top. If the stack is empty Then stop
+ *     Publish the top in the hazard pointer, and read the top again. If it changed Then start over
+ *     Swap mHead from the top to the node after it
+ * Until the swap succeeds
+ * Clear the hazard pointer and give it back
+ * If a node was popped Then store its element in *pData and retire the node  -- Hint: Call SListStackRetire()
+ *------------------------------------------------------------------------------------------------------------*/
+bool SListStackPop
+    (
+    SListStack *pStack,
+    int        *pData
+    )
+{
+    SListHazard *hazard;
+    SListLFNode *top;
+    int i, free_hazard;
+    assert(pStack && pData);
+    for (i = 0; ; i = (i + 1) % SLISTLF_HAZARDS) {
+        free_hazard = 0;
+        if (LFCas(&pStack->mHazards[i].mOwned, &free_hazard, 1)) break;
+    }
+    hazard = &pStack->mHazards[i];
+    for (;;) {
+        if (!(top = LFLoadSeq(&pStack->mHead))) break;
+        LFStoreSeq(&hazard->mNode, top);
+        if (LFLoadSeq(&pStack->mHead) != top) continue;
+        if (LFCas(&pStack->mHead, &top, LFLoad(&top->mNext))) break;
+    }
+    LFStore(&hazard->mNode, NULL);
+    LFStore(&hazard->mOwned, 0);
+    if (!top) return false;
+    *pData = top->mData;
+    SListStackRetire(pStack, top);
+    return true;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListStackPush
+ * DESCR: Pushes pData onto the top of pStack. Any number of threads may push at the same time as each other and
+ *        as the threads popping (see SListStackPop() for their bound). Returns pStack, or NULL if the node cannot
+ *        be allocated. Assertion error if pStack is NULL.
+ *------------------------------------------------------------------------------------------------------------*/
+SListStack *SListStackPush
+    (
+    SListStack *pStack,
+    int         pData
+    )
+{
+    SListLFNode *new_node, *top;
+    assert(pStack);
+    if (!(new_node = (SListLFNode *)malloc(sizeof(SListLFNode)))) return NULL;
+    new_node->mData = pData;
+    top = LFLoad(&pStack->mHead);
+    do {
+        LFStore(&new_node->mNext, top);
+    } while (!LFCas(&pStack->mHead, &top, new_node));
+    return pStack;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListStackRetire
+ * DESCR: Puts pNode, which has just been popped, on the retired list of pStack, and looks for retired nodes to
+ *        free if there are SLISTLF_SCAN_AT of them. The retired list is only ever pushed onto or taken whole by
+ *        an exchange, so it has no ABA problem of its own.
+ *------------------------------------------------------------------------------------------------------------*/
+static void SListStackRetire
+    (
+    SListStack  *pStack,
+    SListLFNode *pNode
+    )
+{
+    SListLFNode *retired = LFLoad(&pStack->mRetired);
+    do {
+        LFStore(&pNode->mNext, retired);
+    } while (!LFCas(&pStack->mRetired, &retired, pNode));
+    if (LFAdd(&pStack->mRetiredCount, 1) >= SLISTLF_SCAN_AT) SListStackScan(pStack);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: SListStackScan
+ * DESCR: Takes the whole retired list of pStack and frees each node that no hazard pointer holds. The nodes
+ *        that are still held go back on the retired list, and stay counted in mRetiredCount. A node is retired
+ *        only after it has been swapped out of mHead, so a thread that publishes it in a hazard pointer
+ *        afterwards finds it is no longer the top and does not read it.
+ *------------------------------------------------------------------------------------------------------------*/
+static void SListStackScan
+    (
+    SListStack *pStack
+    )
+{
+    SListLFNode *node, *next, *retired;
+    int i, freed = 0;
+    bool held;
+    for (node = LFExchange(&pStack->mRetired, NULL); node; node = next) {
+        next = LFLoad(&node->mNext);
+        for (held = false, i = 0; !held && i < SLISTLF_HAZARDS; ++i) {
+            held = LFLoadSeq(&pStack->mHazards[i].mNode) == node;
+        }
+        if (held) {
+            retired = LFLoad(&pStack->mRetired);
+            do {
+                LFStore(&node->mNext, retired);
+            } while (!LFCas(&pStack->mRetired, &retired, node));
+        } else {
+            free(node);
+            ++freed;
+        }
+    }
+    LFAdd(&pStack->mRetiredCount, -freed);
+}
@@ -0,0 +1,116 @@
+/***************************************************************************************************************
+ * FILE: SListLockFree.h
+ *
+ * DESCRIPTION
+ * Declaration of the lock-free singly-linked stack and queue, which several threads may use at the same time
+ * without taking a lock. See the comments in SListLockFree.c for more information.
+ *
+ * AUTHOR INFORMATION
+ * agent [AGT]
+ *
+ * Email: agent@local
+ *
+ * MODIFICATION HISTORY:
+ * -------------------------------------------------------------------------------------------------------------
+ * 17 Oct 2026 [AGT] Initial revision.
+ * 17 Oct 2026 [AGT] Stated the bound on threads popping one stack at once.
+ **************************************************************************************************************/
+#ifndef __SLISTLOCKFREE_H__
+#define __SLISTLOCKFREE_H__
+
+#include "Types.h"  /* For bool */
+
+/*==============================================================================================================
+ * Preprocessor macro definitions.
+ *============================================================================================================*/
+#define SLISTLF_HAZARDS 64  /* Most threads that may pop one stack at once. More wait on the ones popping. */
+
+/*==============================================================================================================
+ * Typedefs.
+ *============================================================================================================*/
+/*--------------------------------------------------------------------------------------------------------------
+ * A node of a lock-free stack or queue. The nodes are malloc()'d one at a time rather than taken from the node
+ * pool, because the pool is not thread-safe. mNext is only read and written atomically.
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct SListLFNode_ {
+    int                  mData;  /* Each node stores a simple int.      */
+    struct SListLFNode_ *mNext;  /* Next node, NULL if this is the last. */
+} SListLFNode;
+
+/*--------------------------------------------------------------------------------------------------------------
+ * A hazard pointer. A thread popping a stack owns one of them for the length of the pop and stores in it the
+ * node it is about to read, which no thread will free while it is there. A stack has SLISTLF_HAZARDS of them,
+ * so that many threads may pop it at once; another popping thread spins until one is given back.
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct {
+    SListLFNode *mNode;   /* Node the owner is reading, or NULL.  */
+    int          mOwned;  /* 1 while a thread owns the pointer.   */
+} SListHazard;
+
+/*--------------------------------------------------------------------------------------------------------------
+ * A Treiber stack. mHead is the top of the stack and only changes by compare-and-swap. Popped nodes wait on
+ * mRetired until no hazard pointer holds them (see SListStackScan() in SListLockFree.c).
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct {
+    SListLFNode *mHead;                      /* Top of the stack, NULL if it is empty.       */
+    SListHazard  mHazards[SLISTLF_HAZARDS];  /* Hazard pointers of the threads popping.       */
+    SListLFNode *mRetired;                   /* Popped nodes not yet freed.                   */
+    int          mRetiredCount;              /* Number of nodes on mRetired, roughly.         */
+} SListStack;
+
+/*--------------------------------------------------------------------------------------------------------------
+ * A multi-producer single-consumer queue. Producers append at mTail; only the consumer reads mHead, which is a
+ * node whose element has already been popped (a stub), so the queue is never without a node and producers and
+ * the consumer never change the same link.
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct {
+    SListLFNode *mHead;  /* Stub before the first element. Read and written by the consumer only. */
+    SListLFNode *mTail;  /* Last node. Swapped atomically by the producers.                        */
+} SListQueue;
+
+/*==============================================================================================================
+ * Global function declarations. See function comments in SListLockFree.c
+ *============================================================================================================*/
+extern SListQueue *SListQueueAlloc
+    (
+    );
+
+extern SListQueue *SListQueueFree
+    (
+    SListQueue *pQueue
+    );
+
+extern bool SListQueuePop
+    (
+    SListQueue *pQueue,
+    int        *pData
+    );
+
+extern SListQueue *SListQueuePush
+    (
+    SListQueue *pQueue,
+    int         pData
+    );
+
+extern SListStack *SListStackAlloc
+    (
+    );
+
+extern SListStack *SListStackFree
+    (
+    SListStack *pStack
+    );
+
+extern bool SListStackPop
+    (
+    SListStack *pStack,
+    int        *pData
+    );
+
+extern SListStack *SListStackPush
+    (
+    SListStack *pStack,
+    int         pData
+    );
+
+#endif
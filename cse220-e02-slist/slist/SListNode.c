@@ -19,11 +19,17 @@
  * MODIFICATION HISTORY:
  * -------------------------------------------------------------------------------------------------------------
  * 29 Feb 2012 [KRB] Initial revision.
+ * 17 Oct 2026 [AGT] Nodes are allocated from a slab pool rather than one malloc() per node.
+ * 17 Oct 2026 [AGT] Support the relative link of the compact node of LAYOUT=compact.
+ * 17 Oct 2026 [AGT] Added SListNodeAllocFrom() and SListNodeFreeTo(), so each list can use an arena of its own.
+ * 17 Oct 2026 [AGT] Removed the process-wide node pool along with SListNodeAlloc() and SListNodeFree(). Every
+ *                   node comes from the arena of its list.
  **************************************************************************************************************/
 /*#define NDEBUG*/      /* Comment out to enable assertions. */
 #include <assert.h>     /* For assert() */
 #include <stdio.h>      /* For FILE, fprintf() */
-#include <stdlib.h>     /* For free(), malloc(), NULL */
+#include <stdlib.h>     /* For NULL */
+#include "Pool.h"       /* For Pool, PoolGetBlock(), PoolPutBlock() */
 #include "SListNode.h"
 
 /*==============================================================================================================
@@ -31,16 +37,20 @@
  *============================================================================================================*/
 
 /*--------------------------------------------------------------------------------------------------------------
- * Allocates a new node with mData member set to pData and mNext pointer set to pNext. Returns a pointer to the
- * new node, or NULL if malloc() fails.
+ * Allocates a new node out of pArena, the arena of the list it will belong to, with mData member set to pData
+ * and mNext pointer set to pNext. Returns a pointer to the new node, or NULL if the arena cannot be grown. The
+ * node must be freed with SListNodeFreeTo() passing the same arena. Assertion error if pArena is NULL.
  *------------------------------------------------------------------------------------------------------------*/
-SListNode *SListNodeAlloc
+SListNode *SListNodeAllocFrom
     (
+    Pool      *pArena,
     int        pData,
     SListNode *pNext
     )
 {
-    SListNode *new_node = (SListNode*)malloc(sizeof(SListNode));
+    SListNode *new_node;
+    assert(pArena);
+    new_node = (SListNode *)PoolGetBlock(pArena);
     if (new_node) {
         SListNodeSetData(new_node, pData);
         SListNodeSetNext(new_node, pNext);
@@ -64,36 +74,41 @@ void SListNodeDebugPrint
 }
 
 /*--------------------------------------------------------------------------------------------------------------
- * Deallocates a node that was allocated by calling SListNodeAlloc(). Note: after a node is deallocated, you
- * should not dereference it. For example,
+ * Deallocates a node that was allocated by calling SListNodeAllocFrom() on pArena. Note: after a node is
+ * deallocated, you should not dereference it. For example,
  *
- * SListNode *node = SListNodeAlloc(10, NULL);
+ * SListNode *node = SListNodeAllocFrom(arena, 10, NULL);
  * ...
- * SListNodeFree(node);
- * int x = SListNodeGetData(node);  BUG!
- * int y = node->mData;             BUG!
+ * SListNodeFreeTo(arena, node);
+ * int x = SListNodeGetData(node);      BUG!
+ * int y = node->mData;                 BUG!
  *
  * These sorts of bugs can be very hard to find because they generally do not cause a segmentation fault and
  * your program generally does not crash right away. Why not? Because even though 'node' now points to a block
  * of memory which has been deallocated, the data is still there, and you can still read from those memory
  * locations. For this reason, we will make this function return a NULL pointer, and then call it this way,
  *
- * SListNode *node = SListNodeAlloc(10, NULL);
+ * SListNode *node = SListNodeAllocFrom(arena, 10, NULL);
  * ...
- * node = SListNodeFree(node);      On return, node points to NULL.
- * int x = SListNodeGetData(node);  Segmentation fault
- * int y = node->mData;             Segmentation fault
+ * node = SListNodeFreeTo(arena, node);  On return, node points to NULL.
+ * int x = SListNodeGetData(node);      Segmentation fault
+ * int y = node->mData;                 Segmentation fault
  *
  * As we discussed in the lecture, seg faults are pretty easy to find. Just load the program into gdb, run it
  * and wait for it to blow up. gdb will tell you where the code failed. Fix your bug, rebuild, and you're on
  * your way. Slick.
+ *
+ * The node is handed back to pArena, which will reuse it for the next node that is allocated. Assertion error
+ * if pArena is NULL.
  *------------------------------------------------------------------------------------------------------------*/
-SListNode *SListNodeFree
+SListNode *SListNodeFreeTo
     (
+    Pool      *pArena,
     SListNode *pNode
     )
 {
-    free(pNode);
+    assert(pArena);
+    if (pNode) PoolPutBlock(pArena, pNode);
     return NULL;
 }
 
@@ -118,7 +133,11 @@ SListNode *SListNodeGetNext
     )
 {
     assert(pNode);
+#ifdef SLIST_COMPACT
+    return pNode->mNext ? pNode + pNode->mNext : NULL;
+#else
     return pNode->mNext;
+#endif
 }
 
 /*--------------------------------------------------------------------------------------------------------------
@@ -144,5 +163,9 @@ void SListNodeSetNext
     )
 {
     assert(pNode);
+#ifdef SLIST_COMPACT
+    pNode->mNext = pNext ? (int)(pNext - pNode) : 0;
+#else
     pNode->mNext = pNext;
+#endif
 }
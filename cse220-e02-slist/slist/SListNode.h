@@ -19,11 +19,15 @@
  * MODIFICATION HISTORY:
  * -------------------------------------------------------------------------------------------------------------
  * 29 Feb 2012 [KRB] Initial revision.
+ * 17 Oct 2026 [AGT] Added the compact node used when building with LAYOUT=compact.
+ * 17 Oct 2026 [AGT] Added SListNodeAllocFrom() and SListNodeFreeTo().
+ * 17 Oct 2026 [AGT] Removed SListNodeAlloc() and SListNodeFree(). Use SListNodeAllocFrom() and SListNodeFreeTo().
  **************************************************************************************************************/
 #ifndef __SLISTNODE_H__
 #define __SLISTNODE_H__
 
 #include <stdio.h>  /* For FILE */
+#include "Pool.h"   /* For Pool */
 
 /*==============================================================================================================
  * Typedefs.
@@ -132,16 +136,30 @@
  * 2. http://ee.hawaii.edu/~tep/EE160/Book/chap12/chapter2.1.html
  * 3. http://yarchive.net/comp/linux/typedefs.html
  *============================================================================================================*/
+#ifndef SLIST_COMPACT
 typedef struct SListNode_ {
     int                mData;  /* Each node stores a simple int. */
     struct SListNode_ *mNext;  /* Pointer to the next node in the list. NULL if this is the last node. */
 } SListNode;
+#else
+/*--------------------------------------------------------------------------------------------------------------
+ * A compact node lives in its list's node array (see SListCompact.c) and links to the next node by its distance
+ * in the array rather than by a pointer, so it is 8 bytes instead of 16 on a 64-bit machine. The link stays
+ * valid when the array is moved. A compact node is not self-referential and can only link to a node in the
+ * same array.
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct {
+    int mData;  /* Each node stores a simple int.                                              */
+    int mNext;  /* Index of the next node minus the index of this node. 0 if this is the last. */
+} SListNode;
+#endif
 
 /*==============================================================================================================
  * Global function declarations. See function comments in SListNode.c
  *============================================================================================================*/
-extern SListNode *SListNodeAlloc
+extern SListNode *SListNodeAllocFrom
     (
+    Pool      *pArena,
     int        pData,
     SListNode *pNext
     );
@@ -152,8 +170,9 @@ extern void SListNodeDebugPrint
     SListNode *pNode
     );
 
-extern SListNode *SListNodeFree
+extern SListNode *SListNodeFreeTo
     (
+    Pool      *pArena,
     SListNode *pNode
     );
 
@@ -0,0 +1,81 @@
+/***************************************************************************************************************
+ * FILE: Scan.h
+ *
+ * DESCRIPTION
+ * Declaration of the input scanner, which splits a test input file into words and integers. See the comments
+ * in Scan.c for more information.
+ *
+ * AUTHOR INFORMATION
+ * agent [AGT]
+ *
+ * Email: agent@local
+ *
+ * MODIFICATION HISTORY:
+ * -------------------------------------------------------------------------------------------------------------
+ * 17 Oct 2026 [AGT] Initial revision.
+ * 17 Oct 2026 [AGT] Added ScanNextTokenOnLine().
+ **************************************************************************************************************/
+#ifndef __SCAN_H__
+#define __SCAN_H__
+
+#include <stddef.h>  /* For size_t */
+#include "Types.h"   /* For bool */
+
+/*==============================================================================================================
+ * Typedefs.
+ *============================================================================================================*/
+/*--------------------------------------------------------------------------------------------------------------
+ * A token is a word of the input file. mStr points into the scanner's copy of the file, so a token is NOT
+ * null-terminated; use mLen. A token stays valid until the scanner is closed.
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct {
+    char *mStr;  /* First character of the word. */
+    int   mLen;  /* Number of characters.        */
+} Token;
+
+typedef struct {
+    char  *mBuf;     /* Contents of the input file.                               */
+    char  *mEnd;     /* One past the last character of the file.                  */
+    char  *mPos;     /* Where the next token starts (or the white space before it). */
+    size_t mSize;    /* Size of mBuf in bytes.                                    */
+    bool   mMapped;  /* True if mBuf was mapped with mmap(), false if malloc()'d.  */
+} Scan;
+
+/*==============================================================================================================
+ * Global function declarations. See function comments in Scan.c
+ *============================================================================================================*/
+extern Scan *ScanClose
+    (
+    Scan *pScan
+    );
+
+extern bool ScanNextInt
+    (
+    Scan *pScan,
+    int  *pInt
+    );
+
+extern bool ScanNextToken
+    (
+    Scan  *pScan,
+    Token *pToken
+    );
+
+extern bool ScanNextTokenOnLine
+    (
+    Scan  *pScan,
+    Token *pToken
+    );
+
+extern Scan *ScanOpen
+    (
+    char *pFileName
+    );
+
+extern bool TokenEq
+    (
+    Token *pToken,
+    char  *pStr
+    );
+
+#endif
@@ -0,0 +1,412 @@
+/***************************************************************************************************************
+ * FILE: StressTest.c
+ *
+ * DESCRIPTION
+ * Stress test driver for the code that is shared by several threads: the lock-free stack and queue of
+ * SListLockFree.c and the list database of ListMan.c. It reads commands from a test input file and writes a
+ * passed or failed line for each to the output file, the way ListTest.c does for the list commands. Kept apart
+ * from ListTest.c so the command table of the test driver only holds list commands.
+ *
+ * AUTHOR INFORMATION
+ * agent [AGT]
+ *
+ * Email: agent@local
+ *
+ * MODIFICATION HISTORY:
+ * -------------------------------------------------------------------------------------------------------------
+ * 17 Oct 2026 [AGT] Initial revision, the "queuestress", "stackstress", and "regstress" commands moved here from
+ *                   ListTest.c.
+ **************************************************************************************************************/
+#define _POSIX_C_SOURCE 200112L  /* For pthread_create(), sched_yield(), etc. when compiling with -ansi */
+
+#include <pthread.h>        /* For pthread_create(), pthread_join(), pthread_t */
+#include <sched.h>          /* For sched_yield() */
+#include <stdio.h>          /* For fprintf(), sprintf(), NULL */
+#include <stdlib.h>         /* For calloc(), exit(), free(), malloc() */
+#include <string.h>         /* For strlen() */
+#include "Intern.h"         /* For InternString() */
+#include "ListMan.h"        /* For ListManCreateList(), ListManFreeList(), ListManGetList(), ListManInit() */
+#include "Out.h"            /* For Out, OutClose(), OutFormat(), OutOpen() */
+#include "SList.h"          /* For SList, SListAlloc(), SListFree() */
+#include "SListLockFree.h"  /* For SListQueue, SListStack, SListQueuePush(), SListStackPop(), etc. */
+#include "Scan.h"           /* For Scan, Token, ScanNextInt(), ScanNextToken(), TokenEq(), etc. */
+
+/*==============================================================================================================
+ * Preprocessor macro definitions.
+ *============================================================================================================*/
+#define STRESS_MAX     64       /* Most threads of each kind the commands will start.                             */
+#define STRESS_ITEMS   4194304  /* Most values "queuestress" and "stackstress" will push in all.                  */
+#define REGISTRY_LISTS 256      /* Number of lists "regstress" looks up.                                          */
+#define REGISTRY_CHURN 512      /* Number of names the writing thread of "regstress" creates and frees lists for. */
+
+/*==============================================================================================================
+ * Typedefs.
+ *============================================================================================================*/
+/*--------------------------------------------------------------------------------------------------------------
+ * What each thread of the "queuestress" and "stackstress" commands is given. A pushing thread pushes the mItems
+ * values mId * mItems through mId * mItems + mItems - 1 in order. A popping thread (mPopped is not NULL) pops
+ * mItems values into mPopped. A thread only writes its own StressTestLockFree, which is read after it is joined.
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct {
+    void *mTarget;  /* The SListQueue or SListStack every thread works on. */
+    int   mId;      /* Number of the thread among the pushing threads.     */
+    int   mItems;   /* Number of values the thread pushes or pops.         */
+    int  *mPopped;  /* Where a popping thread stores what it pops.         */
+    bool  mFailed;  /* Set by the thread if a push failed.                 */
+} StressTestLockFree;
+
+/*--------------------------------------------------------------------------------------------------------------
+ * What each thread of the "regstress" command is given. The reading threads look up the lists named in mNames,
+ * which stay in the database, and the one writing thread (mWriter is true) creates and frees lists named in
+ * mChurn, which share the shards of the database with them. A thread only writes mFailed of its own
+ * StressTestRegistry, which is read after it has been joined.
+ *------------------------------------------------------------------------------------------------------------*/
+typedef struct {
+    int      *mNames;   /* Name ids of the REGISTRY_LISTS lists that stay in the database.    */
+    SList   **mLists;   /* mLists[i] is the list named mNames[i].                             */
+    int      *mChurn;   /* Name ids of the REGISTRY_CHURN lists the writer creates and frees. */
+    unsigned  mSeed;    /* Seed of the thread's random choices.                               */
+    int       mRounds;  /* Number of lookups, or of creates and frees, the thread does.       */
+    bool      mWriter;  /* True for the writing thread.                                       */
+    bool      mFailed;  /* Set by a reading thread if a lookup returned the wrong list.       */
+} StressTestRegistry;
+
+/*==============================================================================================================
+ * Static function declarations.
+ *============================================================================================================*/
+static void StressTest
+    (
+    );
+
+static void StressTestCmdQueueStress
+    (
+    );
+
+static void StressTestCmdRegStress
+    (
+    );
+
+static void StressTestCmdStackStress
+    (
+    );
+
+static void *StressTestQueueWorker
+    (
+    void *pStress
+    );
+
+static void *StressTestRegistryWorker
+    (
+    void *pStress
+    );
+
+static void *StressTestStackWorker
+    (
+    void *pStress
+    );
+
+/*==============================================================================================================
+ * Global variable definitions.
+ *============================================================================================================*/
+static Scan *gScan;
+static Out  *gOut;
+
+/*==============================================================================================================
+ * Function definitions.
+ *============================================================================================================*/
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: main
+ * DESCR: Starting point of execution. Opens the input and output files and calls StressTest() to perform the
+ *        testing. On return, closes the input and output files and terminates.
+ *------------------------------------------------------------------------------------------------------------*/
+int main
+    (
+    int   pArgc,
+    char *pArgv[]
+    )
+{
+    if (pArgc < 3) {
+        fprintf(stderr, "Usage: StressTest inputfile outputfile\n");
+        exit(-1);
+    }
+    if (!(gScan = ScanOpen(pArgv[1]))) {
+        fprintf(stdout, "Cannot open '%s' for reading. Terminating.\n", pArgv[1]);
+        exit(-1);
+    }
+    if (!(gOut = OutOpen(pArgv[2]))) {
+        fprintf(stdout, "Cannot open '%s' for writing. Terminating.\n", pArgv[2]);
+        exit(-1);
+    }
+    StressTest();
+    gScan = ScanClose(gScan);
+    gOut = OutClose(gOut);
+    return 0;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: StressTest
+ * DESCR: Reads and performs the commands of the test input file one after another. Each command starts its own
+ *        threads and joins them before the next one is read.
+ *------------------------------------------------------------------------------------------------------------*/
+static void StressTest
+    (
+    )
+{
+    Token cmd;
+    ListManInit();
+    while (ScanNextToken(gScan, &cmd)) {
+        if (TokenEq(&cmd, "queuestress")) {
+            StressTestCmdQueueStress();
+        } else if (TokenEq(&cmd, "regstress")) {
+            StressTestCmdRegStress();
+        } else if (TokenEq(&cmd, "stackstress")) {
+            StressTestCmdStackStress();
+        } else {
+            fprintf(stdout, "Unknown command '%.*s', ignoring.\n", cmd.mLen, cmd.mStr);
+        }
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: StressTestCmdQueueStress
+ * DESCR: Performs the "queuestress producers items" command, which tests the lock-free queue of SListLockFree.c
+ *        under contention. producers threads each push items values at the same time (see
+ *        StressTestQueueWorker()) while this thread, the one consumer, pops until it has them all, yielding when
+ *        the queue looks empty. Passes if every value is popped, the values of each producer come out in the
+ *        order they were pushed, and the queue is empty at the end. Fails if producers is not from 1 to
+ *        STRESS_MAX, if items < 0, or if there would be more than STRESS_ITEMS values.
+ *------------------------------------------------------------------------------------------------------------*/
+static void StressTestCmdQueueStress
+    (
+    )
+{
+    StressTestLockFree stress[STRESS_MAX];
+    pthread_t threads[STRESS_MAX];
+    int next[STRESS_MAX];
+    SListQueue *queue;
+    int producers = 0, items = 0, started, popped, data, i;
+    bool passed = false;
+    ScanNextInt(gScan, &producers);
+    ScanNextInt(gScan, &items);
+    if (producers >= 1 && producers <= STRESS_MAX && items >= 0 && items <= STRESS_ITEMS / producers &&
+        (queue = SListQueueAlloc())) {
+        for (started = 0; started < producers; ++started) {
+            stress[started].mTarget = queue;
+            stress[started].mId = started;
+            stress[started].mItems = items;
+            stress[started].mPopped = NULL;
+            stress[started].mFailed = false;
+            next[started] = started * items;
+            if (pthread_create(&threads[started], NULL, StressTestQueueWorker, &stress[started]) != 0) break;
+        }
+        passed = started == producers;
+        for (popped = 0; passed && popped < producers * items; ++popped) {
+            while (!SListQueuePop(queue, &data)) sched_yield();
+            passed = data / items < producers && data == next[data / items]++;
+        }
+        for (i = 0; i < started; ++i) {
+            pthread_join(threads[i], NULL);
+            passed = passed && !stress[i].mFailed;
+        }
+        passed = passed && !SListQueuePop(queue, &data);
+        SListQueueFree(queue);
+    }
+    OutFormat(gOut, "queuestress with %d producers and %d items %s\n", producers, items,
+        passed ? "passed" : "failed");
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: StressTestCmdRegStress
+ * DESCR: Performs the "regstress readers rounds" command, which tests the list database of ListMan.c under
+ *        contention. REGISTRY_LISTS lists are put in the database, and then readers threads each look up rounds
+ *        of them at random while one more thread does rounds creates and frees of REGISTRY_CHURN other lists,
+ *        which grow the shards and move entries around in them (see StressTestRegistryWorker()). Passes if
+ *        every lookup returns the list that was put in the database, and the lists are gone once they are
+ *        freed. The choices come from a fixed seed per thread, so the output does not depend on how the threads
+ *        are scheduled. Fails if readers is not from 1 to STRESS_MAX or rounds < 0.
+ *------------------------------------------------------------------------------------------------------------*/
+static void StressTestCmdRegStress
+    (
+    )
+{
+    StressTestRegistry stress[STRESS_MAX + 1];
+    pthread_t threads[STRESS_MAX + 1];
+    int names[REGISTRY_LISTS], churn[REGISTRY_CHURN];
+    SList *lists[REGISTRY_LISTS], *list;
+    char name[32];
+    int reader_count = 0, rounds = 0, started, i;
+    bool passed = false;
+    ScanNextInt(gScan, &reader_count);
+    ScanNextInt(gScan, &rounds);
+    if (reader_count >= 1 && reader_count <= STRESS_MAX && rounds >= 0) {
+        for (passed = true, i = 0; i < REGISTRY_LISTS; ++i) {
+            sprintf(name, "#registry%d", i);
+            names[i] = InternString(name, (int)strlen(name));
+            ListManCreateList(names[i], lists[i] = SListAlloc());
+            passed = passed && lists[i];
+        }
+        for (i = 0; i < REGISTRY_CHURN; ++i) {
+            sprintf(name, "#churn%d", i);
+            churn[i] = InternString(name, (int)strlen(name));
+        }
+        for (started = 0; passed && started <= reader_count; ++started) {
+            stress[started].mNames = names;
+            stress[started].mLists = lists;
+            stress[started].mChurn = churn;
+            stress[started].mSeed = (unsigned)started + 1;
+            stress[started].mRounds = rounds;
+            stress[started].mWriter = started == reader_count;
+            stress[started].mFailed = false;
+            if (pthread_create(&threads[started], NULL, StressTestRegistryWorker, &stress[started]) != 0) break;
+        }
+        for (i = 0; i < started; ++i) {
+            pthread_join(threads[i], NULL);
+            passed = passed && !stress[i].mFailed;
+        }
+        passed = passed && started > reader_count;
+        for (i = 0; i < REGISTRY_LISTS; ++i) {
+            passed = passed && ListManGetList(names[i]) == lists[i];
+            SListFree(lists[i]);
+            ListManFreeList(names[i]);
+            passed = passed && !ListManGetList(names[i]);
+        }
+        for (i = 0; i < REGISTRY_CHURN; ++i) {
+            if ((list = ListManGetList(churn[i]))) {
+                SListFree(list);
+                ListManFreeList(churn[i]);
+            }
+        }
+    }
+    OutFormat(gOut, "regstress with %d readers and %d rounds %s\n", reader_count, rounds,
+        passed ? "passed" : "failed");
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: StressTestCmdStackStress
+ * DESCR: Performs the "stackstress threads items" command, which tests the lock-free stack of SListLockFree.c
+ *        under contention. threads threads each push items values while threads other threads each pop items
+ *        values, all at the same time (see StressTestStackWorker()). Passes if every value pushed is popped
+ *        exactly once and the stack is empty at the end. Fails if threads is not from 1 to STRESS_MAX, if
+ *        items < 0, or if there would be more than STRESS_ITEMS values.
+ *------------------------------------------------------------------------------------------------------------*/
+static void StressTestCmdStackStress
+    (
+    )
+{
+    StressTestLockFree stress[2 * STRESS_MAX];
+    pthread_t threads[2 * STRESS_MAX];
+    SListStack *stack;
+    int *popped = NULL;
+    char *seen = NULL;
+    int thread_count = 0, items = 0, started, data, i;
+    bool passed = false;
+    ScanNextInt(gScan, &thread_count);
+    ScanNextInt(gScan, &items);
+    if (thread_count >= 1 && thread_count <= STRESS_MAX && items >= 0 && items <= STRESS_ITEMS / thread_count &&
+        (popped = (int *)malloc((thread_count * items + 1) * sizeof(int))) &&
+        (seen = (char *)calloc(thread_count * items + 1, 1)) && (stack = SListStackAlloc())) {
+        for (started = 0; started < 2 * thread_count; ++started) {
+            stress[started].mTarget = stack;
+            stress[started].mId = started % thread_count;
+            stress[started].mItems = items;
+            stress[started].mPopped = started < thread_count ? NULL : &popped[(started - thread_count) * items];
+            stress[started].mFailed = false;
+            if (pthread_create(&threads[started], NULL, StressTestStackWorker, &stress[started]) != 0) break;
+        }
+        passed = started == 2 * thread_count;
+        if (!passed) {
+            for (i = 0; i < thread_count * items; ++i) SListStackPush(stack, 0);
+        }
+        for (i = 0; i < started; ++i) {
+            pthread_join(threads[i], NULL);
+            passed = passed && !stress[i].mFailed;
+        }
+        for (i = 0; passed && i < thread_count * items; ++i) {
+            passed = popped[i] >= 0 && popped[i] < thread_count * items && !seen[popped[i]]++;
+        }
+        passed = passed && !SListStackPop(stack, &data);
+        SListStackFree(stack);
+    }
+    free(popped);
+    free(seen);
+    OutFormat(gOut, "stackstress with %d threads and %d items %s\n", thread_count, items,
+        passed ? "passed" : "failed");
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: StressTestQueueWorker
+ * DESCR: The body of each producer of the "queuestress" command, given its StressTestLockFree in pStress.
+ *        Pushes its values onto the queue in order, setting mFailed if a push fails.
+ *------------------------------------------------------------------------------------------------------------*/
+static void *StressTestQueueWorker
+    (
+    void *pStress
+    )
+{
+    StressTestLockFree *stress = (StressTestLockFree *)pStress;
+    int i;
+    for (i = 0; i < stress->mItems; ++i) {
+        if (!SListQueuePush((SListQueue *)stress->mTarget, stress->mId * stress->mItems + i)) stress->mFailed = true;
+    }
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: StressTestRegistryWorker
+ * DESCR: The body of each thread of the "regstress" command, given its StressTestRegistry in pStress. A reading
+ *        thread does mRounds lookups of lists chosen at random from mNames, setting mFailed if one returns
+ *        anything but the list in mLists. The writing thread does mRounds times: choose a name from mChurn at
+ *        random, and free its list if it has one, or else create one. The random choices come from a linear
+ *        congruential generator seeded with mSeed.
+ *------------------------------------------------------------------------------------------------------------*/
+static void *StressTestRegistryWorker
+    (
+    void *pStress
+    )
+{
+    StressTestRegistry *stress = (StressTestRegistry *)pStress;
+    unsigned seed = stress->mSeed;
+    SList *list;
+    int round, choice;
+    for (round = 0; round < stress->mRounds; ++round) {
+        seed = seed * 1103515245u + 12345u;
+        if (stress->mWriter) {
+            choice = stress->mChurn[(seed >> 16) % REGISTRY_CHURN];
+            if ((list = ListManGetList(choice))) {
+                ListManFreeList(choice);
+                SListFree(list);
+            } else {
+                ListManCreateList(choice, SListAlloc());
+            }
+        } else {
+            choice = (int)((seed >> 16) % REGISTRY_LISTS);
+            if (ListManGetList(stress->mNames[choice]) != stress->mLists[choice]) stress->mFailed = true;
+        }
+    }
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * FUNCT: StressTestStackWorker
+ * DESCR: The body of each thread of the "stackstress" command, given its StressTestLockFree in pStress. A
+ *        pushing thread pushes its values, setting mFailed if a push fails. A popping thread pops mItems values
+ *        into mPopped, yielding when the stack is empty.
+ *------------------------------------------------------------------------------------------------------------*/
+static void *StressTestStackWorker
+    (
+    void *pStress
+    )
+{
+    StressTestLockFree *stress = (StressTestLockFree *)pStress;
+    SListStack *stack = (SListStack *)stress->mTarget;
+    int i;
+    for (i = 0; i < stress->mItems; ++i) {
+        if (!stress->mPopped) {
+            if (!SListStackPush(stack, stress->mId * stress->mItems + i)) stress->mFailed = true;
+        } else {
+            while (!SListStackPop(stack, &stress->mPopped[i])) sched_yield();
+        }
+    }
+    return NULL;
+}
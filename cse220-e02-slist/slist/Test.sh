@@ -20,6 +20,18 @@
 # MODIFICATION HISTORY:
 # -------------------------------------------------------------------------------------------------------------
 # 29 Feb 2012 [KRB] Initial revision.
+# 17 Oct 2026 [AGT] Added test case 14, the appendn and appendrange commands.
+# 17 Oct 2026 [AGT] Added test case 15, sorting lists by merge sort and by radix sort.
+# 17 Oct 2026 [AGT] Added test case 16, sorting lists on several threads.
+# 17 Oct 2026 [AGT] Added test case 17, the lock-free stack and queue under contention.
+# 17 Oct 2026 [AGT] Added test case 18, the list database looked up while lists are created and freed.
+# 17 Oct 2026 [AGT] Each test case is also performed on four threads, and added test case 19, commands on many
+#                   lists performed on several threads.
+# 17 Oct 2026 [AGT] Each test case is also performed pipelined.
+# 17 Oct 2026 [AGT] Added test case 20, integers that do not fit in an int.
+# 17 Oct 2026 [AGT] Test cases 17 and 18 are now stress test cases 1 and 2, performed by StressTest. Test cases
+#                   19 and 20 are renumbered 17 and 18.
+# 17 Oct 2026 [AGT] Added test case 19, lists created over lists that exist.
 #***************************************************************************************************************
 
 #----- Dos2Unix ------------------------------------------------------------------------------------------------
@@ -47,11 +59,14 @@ Test() {
 	# Set _correct to the name of the file containing the correct output from the test case. Set _diff to the
 	# text filename that will be generated by the diff command. Set _in to the name of text file containing the
 	# input data for the test case. Set _out to the name of the output file that will be generated by perform-
-	# ing the test case.
+	# ing the test case. Set _pout to the name of the output file that will be generated by performing the test
+	# case again on four threads, and _lout to the one generated by performing it again pipelined.
 	_correct=test$_tc.correct
 	_diff=test$_tc.diff
 	_in=test$_tc.in
 	_out=test$_tc.out
+	_pout=test$_tc.pout
+	_lout=test$_tc.lout
 
 	# Convert the test case input file to Unix format.
 	_file=$_in
@@ -74,6 +89,51 @@ Test() {
 	# the test case failed. If the .diff file does not exist, then the test case passed.
 	diff $_out $_correct > $_diff
 
+	# Perform the test again on four threads (see ListTestParallel() in ListTest.c). The output must be the same.
+	$_binary $_in $_pout 4
+	_file=$_pout
+	Dos2Unix
+	diff $_pout $_correct >> $_diff
+
+	# And once more pipelined (see ListTestPipeline() in ListTest.c).
+	$_binary $_in $_lout pipeline
+	_file=$_lout
+	Dos2Unix
+	diff $_lout $_correct >> $_diff
+
+	if test -s $_diff; then
+		echo "FAILED. See" $_out"," $_pout "and" $_lout "for output."
+	else
+		rm -f $_diff
+		rm -f $_out
+		rm -f $_pout
+		rm -f $_lout
+		echo "PASSED"
+	fi
+}
+
+#----- StressTest ----------------------------------------------------------------------------------------------
+# Perform the stress test case corresponding to the value of variable _tc. Stress test cases are named
+# stress1.in, stress2.in, ..., and are performed once, by the stress test driver (see StressTest.c).
+#---------------------------------------------------------------------------------------------------------------
+StressTest() {
+	echo -n Performing Stress Test Case $_tc...
+
+	_correct=stress$_tc.correct
+	_diff=stress$_tc.diff
+	_in=stress$_tc.in
+	_out=stress$_tc.out
+
+	_file=$_in
+	Dos2Unix
+	_file=$_correct
+	Dos2Unix
+
+	$_stressbinary $_in $_out
+	_file=$_out
+	Dos2Unix
+	diff $_out $_correct > $_diff
+
 	if test -s $_diff; then
 		echo "FAILED. See" $_out "for output."
 	else
@@ -85,6 +145,7 @@ Test() {
 
 # _binary is the name of the executable program (i.e., in Unix lingo this is called a binary).
 _binary=./ListTest
+_stressbinary=./StressTest
 
 # Store the current working directory in _currdir. We are going to cd to the testing directory and
 # when we are done testing, we will cd back to the current directory.
@@ -95,16 +156,22 @@ _testdir=testcases
 
 # Copy the binary to the test cases directory.
 cp $_binary $_testdir
+cp $_stressbinary $_testdir
 
 # cd to the test cases directory.
 cd $_testdir
 
 # Let _tc take on the values 1, 2, 3, ..., 13. The test case files are named test1.in, test2.in,
 # ..., test13.in. For each value of _tc, call the Test function.
-for _tc in `seq 1 13`; do
+for _tc in `seq 1 19`; do
 	Test
 done
 
+# And each stress test case.
+for _tc in `seq 1 2`; do
+	StressTest
+done
+
 # cd back to the original working directory.
 cd $_curdir
 
@@ -114,6 +181,9 @@ _curdir=
 _correct=
 _file=
 _in=
+_lout=
 _out=
+_pout=
+_stressbinary=
 _tc=
 _testdir=